@@ -52,9 +52,11 @@
 #include "view/windowstracker/allscreenstracker.h"
 #include "view/windowstracker/currentscreentracker.h"
 #include "wm/abstractwindowinterface.h"
+#include "wm/eventsrecorder.h"
 #include "wm/schemecolors.h"
 #include "wm/waylandinterface.h"
 #include "wm/xwindowinterface.h"
+#include "wm/tracker/coronaviewshost.h"
 #include "wm/tracker/lastactivewindow.h"
 #include "wm/tracker/schemes.h"
 #include "wm/tracker/windowstracker.h"
@@ -121,6 +123,8 @@ Corona::Corona(bool defaultLayoutOnStartup, QString layoutNameOnStartUp, int use
         m_wm = new WindowSystem::XWindowInterface(this);
     }
 
+    m_wm->windowsTracker()->setViewsHost(new WindowSystem::Tracker::CoronaViewsHost(this));
+
     setupWaylandIntegration();
 
     KPackage::Package package(new Latte::Package(this));
@@ -1205,6 +1209,46 @@ void Corona::setContextMenuView(int id)
     m_contextMenuViewId = id;
 }
 
+QString Corona::trackerPerformanceReport()
+{
+    return m_wm->perfCounters()->report();
+}
+
+void Corona::resetTrackerPerformanceCounters()
+{
+    m_wm->perfCounters()->reset();
+}
+
+int Corona::windowsChangedLatency() const
+{
+    return m_wm->windowsChangedLatency();
+}
+
+void Corona::setWindowsChangedLatency(int latency)
+{
+    m_wm->setWindowsChangedLatency(latency);
+}
+
+QString Corona::layoutsPreloadingReport()
+{
+    return m_layoutsManager->synchronizer()->preloadingReport();
+}
+
+void Corona::setPreloadedLayouts(int count)
+{
+    m_universalSettings->setPreloadedLayouts(qMax(0, count));
+}
+
+void Corona::setWindowEventsRecording(bool enabled)
+{
+    m_wm->eventsRecorder()->setRecording(enabled);
+}
+
+bool Corona::saveWindowEventsRecording(QString file)
+{
+    return m_wm->eventsRecorder()->save(file);
+}
+
 QStringList Corona::contextMenuData()
 {
     QStringList data;
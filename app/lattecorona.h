@@ -162,6 +162,24 @@ public:
     void setContextMenuView(int id);
     QStringList contextMenuData();
 
+    //! windows tracking performance counters, used from --perf-report
+    QString trackerPerformanceReport();
+    void resetTrackerPerformanceCounters();
+
+    //! maximum time in ms that changed windows are collected before the windows tracker
+    //! is updated, in order to measure the tracking cost under different latencies
+    int windowsChangedLatency() const;
+    void setWindowsChangedLatency(int latency);
+
+    //! layouts preloading hits and misses, used from --perf-report
+    QString layoutsPreloadingReport();
+    //! maximum preloaded layouts, 0 disables preloading and unloads the preloaded ones
+    void setPreloadedLayouts(int count);
+
+    //! windows events recording in order to reproduce real workloads offline
+    void setWindowEventsRecording(bool enabled);
+    bool saveWindowEventsRecording(QString file);
+
 public slots:
     void aboutApplication();
     void addViewForLayout(QString layoutName);
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "idallocator.h"
+
+#define MAXID 32000
+
+namespace Latte {
+namespace Layouts {
+
+IdAllocator::IdAllocator(const QStringList &occupiedIds)
+    : m_occupied(MAXID)
+{
+    for (const auto &idStr : occupiedIds) {
+        bool ok;
+        int id = idStr.toInt(&ok);
+
+        if (ok && id >= 0 && id < MAXID) {
+            m_occupied.setBit(id);
+        }
+    }
+}
+
+QString IdAllocator::takeAvailableId(const int base)
+{
+    int id = qMax(0, m_cursors.value(base, base));
+
+    while (id < MAXID && m_occupied.testBit(id)) {
+        ++id;
+    }
+
+    m_cursors[base] = id;
+
+    if (id >= MAXID) {
+        return QString("");
+    }
+
+    m_occupied.setBit(id);
+
+    return QString::number(id);
+}
+
+}
+}
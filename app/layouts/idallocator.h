@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LAYOUTSIDALLOCATOR_H
+#define LAYOUTSIDALLOCATOR_H
+
+// Qt
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+namespace Latte {
+namespace Layouts {
+
+//! Provides unique containment and applet ids during a layout import. Occupied
+//! ids are kept in a bitmap and each base remembers where its last search ended,
+//! ids are never released so the next available id can only move forward.
+class IdAllocator
+{
+public:
+    IdAllocator(const QStringList &occupiedIds);
+
+    //! the first available id that is not smaller than base, it is empty
+    //! when all ids are occupied
+    QString takeAvailableId(const int base);
+
+private:
+    QBitArray m_occupied;
+
+    //! base, last id provided for that base
+    QHash<int, int> m_cursors;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "idsremapper.h"
+
+// local
+#include "idallocator.h"
+
+// Qt
+#include <QDebug>
+#include <QHash>
+
+//! same values as Storage::IDNULL and Storage::IDBASE, the remapper is
+//! built without the storage in order to be used from benchmarks
+#define INVALIDID -1
+#define FIRSTVALIDID 0
+#define CONTAINMENTSBASEID 12
+#define APPLETSBASEID 40
+
+namespace Latte {
+namespace Layouts {
+
+IdsRemapper::IdsRemapper()
+{
+    //! Systray
+    m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="SystrayContainmentId"};
+    //! Group applet
+    m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="ContainmentId"};
+}
+
+int IdsRemapper::subContainmentId(const KConfigGroup &appletGroup) const
+{
+    //! cycle through subcontainments identities
+    for (auto subidentity : m_subIdentities) {
+        KConfigGroup appletConfigGroup = appletGroup;
+
+        if (!subidentity.cfgGroup.isEmpty()) {
+            //! if identity provides specific configuration group
+            if (appletConfigGroup.hasGroup(subidentity.cfgGroup)) {
+                appletConfigGroup = appletGroup.group(subidentity.cfgGroup);
+            }
+        }
+
+        if (!subidentity.cfgProperty.isEmpty()) {
+            //! if identity provides specific property for configuration group
+            if (appletConfigGroup.hasKey(subidentity.cfgProperty)) {
+                return appletConfigGroup.readEntry(subidentity.cfgProperty, INVALIDID);
+            }
+        }
+    }
+
+    return INVALIDID;
+}
+
+int IdsRemapper::subIdentityIndex(const KConfigGroup &appletGroup) const
+{
+    if (subContainmentId(appletGroup) < FIRSTVALIDID) {
+        return INVALIDID;
+    }
+
+    //! cycle through subcontainments identities
+    for (int i=0; i<m_subIdentities.count(); ++i) {
+        KConfigGroup appletConfigGroup = appletGroup;
+
+        if (!m_subIdentities[i].cfgGroup.isEmpty()) {
+            //! if identity provides specific configuration group
+            if (appletConfigGroup.hasGroup(m_subIdentities[i].cfgGroup)) {
+                appletConfigGroup = appletGroup.group(m_subIdentities[i].cfgGroup);
+            }
+        }
+
+        if (!m_subIdentities[i].cfgProperty.isEmpty()) {
+            //! if identity provides specific property for configuration group
+            if (appletConfigGroup.hasKey(m_subIdentities[i].cfgProperty)) {
+                int subId = appletConfigGroup.readEntry(m_subIdentities[i].cfgProperty, INVALIDID);
+                return subId >= FIRSTVALIDID ? i : INVALIDID;
+            }
+        }
+    }
+
+    return INVALIDID;
+}
+
+void IdsRemapper::remap(const QStringList &occupiedIds, const QString &layoutId, const KConfigGroup &containments, KConfigGroup &fixedContainments) const
+{
+    QStringList toInvestigateContainmentIds;
+    QStringList toInvestigateAppletIds;
+    QStringList toInvestigateSubContIds;
+
+    //! first is the subcontainment id
+    QHash<QString, QString> subParentContainmentIds;
+    QHash<QString, QString> subAppletIds;
+
+    QHash<QString, QString> assigned;
+
+    //! Record the containment and applet ids
+    for (const auto &cId : containments.groupList()) {
+        toInvestigateContainmentIds << cId;
+        auto appletsEntries = containments.group(cId).group("Applets");
+        toInvestigateAppletIds << appletsEntries.groupList();
+
+        //! investigate for subcontainments
+        for (const auto &appletId : appletsEntries.groupList()) {
+            int subId = subContainmentId(appletsEntries.group(appletId));
+
+            //! It is a subcontainment !!!
+            if (subId >= FIRSTVALIDID) {
+                QString tSubIdStr = QString::number(subId);
+                toInvestigateSubContIds << tSubIdStr;
+                subParentContainmentIds[tSubIdStr] = cId;
+                subAppletIds[tSubIdStr] = appletId;
+                qDebug() << "subcontainment was found in the containment...";
+            }
+        }
+    }
+
+    //! Reassign containment and applet ids to unique ones
+    IdAllocator idAllocator(occupiedIds);
+
+    for (const auto &contId : toInvestigateContainmentIds) {
+        QString newId = idAllocator.takeAvailableId(CONTAINMENTSBASEID);
+
+        assigned[contId] = newId;
+    }
+
+    for (const auto &appId : toInvestigateAppletIds) {
+        QString newId = idAllocator.takeAvailableId(APPLETSBASEID);
+
+        assigned[appId] = newId;
+    }
+
+    qDebug() << "ALL OCCUPIED IDS ::: " << occupiedIds;
+    qDebug() << "FULL ASSIGNMENTS ::: " << assigned;
+
+    for (const auto &cId : toInvestigateContainmentIds) {
+        QString value = assigned[cId];
+
+        if (assigned.contains(value)) {
+            QString value2 = assigned[value];
+
+            if (cId != assigned[cId] && !value2.isEmpty() && cId == value2) {
+                qDebug() << "PROBLEM APPEARED !!!! FOR :::: " << cId << " .. fixed ..";
+                assigned[cId] = cId;
+                assigned[value] = value;
+            }
+        }
+    }
+
+    for (const auto &aId : toInvestigateAppletIds) {
+        QString value = assigned[aId];
+
+        if (assigned.contains(value)) {
+            QString value2 = assigned[value];
+
+            if (aId != assigned[aId] && !value2.isEmpty() && aId == value2) {
+                qDebug() << "PROBLEM APPEARED !!!! FOR :::: " << aId << " .. fixed ..";
+                assigned[aId] = aId;
+                assigned[value] = value;
+            }
+        }
+    }
+
+    qDebug() << "FIXED FULL ASSIGNMENTS ::: " << assigned;
+
+    //! Copy the containments with their updated ids
+    for (const auto &contId : containments.groupList()) {
+        QString pluginId = containments.group(contId).readEntry("plugin", "");
+
+        if (pluginId == "org.kde.desktopcontainment") { //!don't add ghost containments
+            continue;
+        }
+
+        KConfigGroup newContainmentGroup = fixedContainments.group(assigned[contId]);
+        containments.group(contId).copyTo(&newContainmentGroup);
+
+        newContainmentGroup.group("Applets").deleteGroup();
+
+        for (const auto &appId : containments.group(contId).group("Applets").groupList()) {
+            KConfigGroup appletGroup = containments.group(contId).group("Applets").group(appId);
+            KConfigGroup newAppletGroup = newContainmentGroup.group("Applets").group(assigned[appId]);
+            appletGroup.copyTo(&newAppletGroup);
+        }
+
+        //! Update options that contain applet ids
+        //! (appletOrder) and (lockedZoomApplets) and (userBlocksColorizingApplets)
+        QStringList options;
+        options << "appletOrder" << "lockedZoomApplets" << "userBlocksColorizingApplets";
+
+        for (const auto &settingStr : options) {
+            QString order1 = newContainmentGroup.group("General").readEntry(settingStr, QString());
+
+            if (!order1.isEmpty()) {
+                QStringList order1Ids = order1.split(";");
+                QStringList fixedOrder1Ids;
+
+                for (int i = 0; i < order1Ids.count(); ++i) {
+                    fixedOrder1Ids.append(assigned[order1Ids[i]]);
+                }
+
+                QString fixedOrder1 = fixedOrder1Ids.join(";");
+                newContainmentGroup.group("General").writeEntry(settingStr, fixedOrder1);
+            }
+        }
+
+        //! in MultipleLayouts update also the layoutId
+        if (!layoutId.isEmpty()) {
+            newContainmentGroup.writeEntry("layoutId", layoutId);
+        }
+    }
+
+    //! must update also the sub id in its applet
+    for (const auto &subId : toInvestigateSubContIds) {
+        if (!fixedContainments.hasGroup(assigned[subParentContainmentIds[subId]])) {
+            continue;
+        }
+
+        KConfigGroup subParentContainment = fixedContainments.group(assigned[subParentContainmentIds[subId]]);
+        KConfigGroup subAppletConfig = subParentContainment.group("Applets").group(assigned[subAppletIds[subId]]);
+
+        int entityIndex = subIdentityIndex(subAppletConfig);
+
+        if (entityIndex >= 0) {
+            if (!m_subIdentities[entityIndex].cfgGroup.isEmpty()) {
+                subAppletConfig = subAppletConfig.group(m_subIdentities[entityIndex].cfgGroup);
+            }
+
+            if (!m_subIdentities[entityIndex].cfgProperty.isEmpty()) {
+                subAppletConfig.writeEntry(m_subIdentities[entityIndex].cfgProperty, assigned[subId]);
+            }
+        }
+    }
+}
+
+}
+}
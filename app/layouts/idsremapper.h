@@ -0,0 +1,64 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef LAYOUTSIDSREMAPPER_H
+#define LAYOUTSIDSREMAPPER_H
+
+// Qt
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// KDE
+#include <KConfigGroup>
+
+namespace Latte {
+namespace Layouts {
+
+struct SubContaimentIdentityData
+{
+    QString cfgGroup;
+    QString cfgProperty;
+};
+
+//! Copies layout containments and their applets with new unique ids. It does not
+//! depend on the corona, the ids that are already in use are provided by the caller
+//! and the source and target groups can be either in memory or file based.
+class IdsRemapper
+{
+public:
+    IdsRemapper();
+
+    int subContainmentId(const KConfigGroup &appletGroup) const;
+
+    //! copies the provided containments to fixedContainments with ids that do not
+    //! collide with occupiedIds, layoutId is written only when it is not empty
+    void remap(const QStringList &occupiedIds, const QString &layoutId, const KConfigGroup &containments, KConfigGroup &fixedContainments) const;
+
+private:
+    int subIdentityIndex(const KConfigGroup &appletGroup) const;
+
+private:
+    QList<SubContaimentIdentityData> m_subIdentities;
+};
+
+}
+}
+
+#endif
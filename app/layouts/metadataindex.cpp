@@ -0,0 +1,230 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "metadataindex.h"
+
+// local
+#include "storage.h"
+#include "../layout/abstractlayout.h"
+
+// Qt
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+// KDE
+#include <KConfig>
+#include <KConfigGroup>
+
+#define INDEXFILE "layoutsmetadata"
+#define INDEXFILEVERSION 1
+
+namespace Latte {
+namespace Layouts {
+
+MetadataIndex::MetadataIndex(const QString &directory)
+    : m_indexFile(directory + QLatin1Char('/') + INDEXFILE)
+{
+    load();
+}
+
+QString MetadataIndex::indexFilePath() const
+{
+    return m_indexFile;
+}
+
+bool MetadataIndex::contains(const QString &file) const
+{
+    return m_metadata.contains(file);
+}
+
+bool MetadataIndex::isUpToDate(const QString &file) const
+{
+    if (!m_metadata.contains(file)) {
+        return false;
+    }
+
+    const QFileInfo info(file);
+    const LayoutMetadata &metadata = m_metadata[file];
+
+    return info.exists()
+            && metadata.modified == info.lastModified().toMSecsSinceEpoch()
+            && metadata.size == info.size();
+}
+
+LayoutMetadata MetadataIndex::metadata(const QString &file) const
+{
+    return m_metadata.value(file);
+}
+
+void MetadataIndex::insert(const QString &file, const LayoutMetadata &metadata)
+{
+    m_metadata[file] = metadata;
+    m_changed = true;
+}
+
+void MetadataIndex::retain(const QStringList &files)
+{
+    for (auto it = m_metadata.begin(); it != m_metadata.end();) {
+        if (!files.contains(it.key())) {
+            it = m_metadata.erase(it);
+            m_changed = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+LayoutMetadata MetadataIndex::readLayoutFile(const QString &file)
+{
+    LayoutMetadata metadata;
+
+    //! stamp is taken first, changes during reading are found during next check
+    const QFileInfo info(file);
+    metadata.modified = info.lastModified().toMSecsSinceEpoch();
+    metadata.size = info.size();
+
+    metadata.layout.id = file;
+    metadata.layout.name = Layout::AbstractLayout::layoutName(file);
+
+    KConfig layoutFile(file, KConfig::SimpleConfig);
+    KConfigGroup layoutGroup(&layoutFile, "LayoutSettings");
+
+    //! same defaults as Layout::AbstractLayout and CentralLayout
+    metadata.layout.icon = layoutGroup.readEntry("icon", QString());
+    metadata.layout.color = layoutGroup.readEntry("color", QString("blue"));
+    metadata.layout.backgroundStyle = static_cast<Layout::BackgroundStyle>(layoutGroup.readEntry("backgroundStyle", (int)Layout::ColorBackgroundStyle));
+
+    const QString deprecatedBackground = layoutGroup.readEntry("background", QString());
+
+    if (deprecatedBackground.startsWith("/")) {
+        metadata.layout.background = deprecatedBackground;
+        metadata.layout.textColor = layoutGroup.readEntry("textColor", QString());
+        metadata.layout.backgroundStyle = Layout::PatternBackgroundStyle;
+    } else {
+        metadata.layout.background = layoutGroup.readEntry("customBackground", QString());
+        metadata.layout.textColor = layoutGroup.readEntry("customTextColor", QString());
+    }
+
+    metadata.layout.isShownInMenu = layoutGroup.readEntry("showInMenu", false);
+    metadata.layout.hasDisabledBorders = layoutGroup.readEntry("disableBordersForMaximizedWindows", false);
+    metadata.layout.activities = layoutGroup.readEntry("activities", QStringList());
+    metadata.sharedLayoutName = layoutGroup.readEntry("sharedLayout", QString());
+
+    //! same ids check as Storage::isBroken() without healing the file
+    QStringList ids;
+    KConfigGroup containmentsEntries = KConfigGroup(&layoutFile, "Containments");
+    ids << containmentsEntries.groupList();
+
+    for (const auto &cId : containmentsEntries.groupList()) {
+        auto appletsEntries = containmentsEntries.group(cId).group("Applets");
+
+        for (const auto &appletId : appletsEntries.groupList()) {
+            if (Storage::appletGroupIsValid(appletsEntries.group(appletId))) {
+                ids << appletId;
+            }
+        }
+    }
+
+    metadata.isBroken = Storage::hasDuplicatedIds(ids);
+
+    return metadata;
+}
+
+void MetadataIndex::load()
+{
+    m_metadata.clear();
+    m_changed = false;
+
+    QFile file(indexFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 version;
+    quint32 count;
+    stream >> version >> count;
+
+    if (version != INDEXFILEVERSION) {
+        return;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString layoutFile;
+        LayoutMetadata metadata;
+        int backgroundStyle;
+
+        stream >> layoutFile >> metadata.modified >> metadata.size
+               >> metadata.layout.name >> metadata.layout.icon >> metadata.layout.color
+               >> metadata.layout.background >> metadata.layout.textColor >> backgroundStyle
+               >> metadata.layout.isShownInMenu >> metadata.layout.hasDisabledBorders
+               >> metadata.layout.activities >> metadata.sharedLayoutName >> metadata.isBroken;
+
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        metadata.layout.id = layoutFile;
+        metadata.layout.backgroundStyle = static_cast<Layout::BackgroundStyle>(backgroundStyle);
+        m_metadata[layoutFile] = metadata;
+    }
+}
+
+void MetadataIndex::save()
+{
+    if (!m_changed) {
+        return;
+    }
+
+    QSaveFile file(indexFilePath());
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Layouts metadata index can not be written :: " << indexFilePath();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    stream << (quint32)INDEXFILEVERSION << (quint32)m_metadata.count();
+
+    for (auto it = m_metadata.constBegin(); it != m_metadata.constEnd(); ++it) {
+        const LayoutMetadata &metadata = it.value();
+
+        stream << it.key() << metadata.modified << metadata.size
+               << metadata.layout.name << metadata.layout.icon << metadata.layout.color
+               << metadata.layout.background << metadata.layout.textColor << (int)metadata.layout.backgroundStyle
+               << metadata.layout.isShownInMenu << metadata.layout.hasDisabledBorders
+               << metadata.layout.activities << metadata.sharedLayoutName << metadata.isBroken;
+    }
+
+    if (file.commit()) {
+        m_changed = false;
+    }
+}
+
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LAYOUTSMETADATAINDEX_H
+#define LAYOUTSMETADATAINDEX_H
+
+// local
+#include "../data/layoutdata.h"
+
+// Qt
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+namespace Latte {
+namespace Layouts {
+
+struct LayoutMetadata
+{
+    //! file stamp the metadata were read from
+    qint64 modified{0};
+    qint64 size{-1};
+
+    Data::Layout layout;
+    QString sharedLayoutName;
+    bool isBroken{false};
+};
+
+//! Index of the layouts files metadata that is stored next to the layouts files.
+//! The Layouts settings can this way show all layouts without parsing each
+//! layout file and checking its containments and applets. Each record is
+//! valid as long as its layout file modification time and size are unchanged.
+class MetadataIndex
+{
+public:
+    //! the index file is stored in the provided directory, usually Importer::layoutUserDir()
+    explicit MetadataIndex(const QString &directory);
+
+    bool contains(const QString &file) const;
+    //! true when the indexed metadata match the layout file on disk
+    bool isUpToDate(const QString &file) const;
+
+    LayoutMetadata metadata(const QString &file) const;
+
+    void insert(const QString &file, const LayoutMetadata &metadata);
+    //! forget all records that are not present in the provided files
+    void retain(const QStringList &files);
+
+    void load();
+    void save();
+
+    //! it does not alter the layout file and can be called from worker threads
+    static LayoutMetadata readLayoutFile(const QString &file);
+
+private:
+    QString indexFilePath() const;
+
+private:
+    bool m_changed{false};
+
+    QString m_indexFile;
+
+    QHash<QString, LayoutMetadata> m_metadata;
+};
+
+}
+}
+
+#endif
@@ -30,6 +30,7 @@
 // Qt
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 
@@ -54,13 +55,6 @@ const int Storage::IDBASE = 0;
 Storage::Storage()
 {
     qDebug() << " >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> LAYOUTS::STORAGE, TEMP DIR ::: " << m_storageTmpDir.path();
-
-    SubContaimentIdentityData data;
-
-    //! Systray
-    m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="SystrayContainmentId"};
-    //! Group applet
-    m_subIdentities << SubContaimentIdentityData{.cfgGroup="Configuration", .cfgProperty="ContainmentId"};
 }
 
 Storage::~Storage()
@@ -131,55 +125,7 @@ bool Storage::isValid(const int &id)
 
 int Storage::subContainmentId(const KConfigGroup &appletGroup) const
 {
-    //! cycle through subcontainments identities
-    for (auto subidentity : m_subIdentities) {
-        KConfigGroup appletConfigGroup = appletGroup;
-
-        if (!subidentity.cfgGroup.isEmpty()) {
-            //! if identity provides specific configuration group
-            if (appletConfigGroup.hasGroup(subidentity.cfgGroup)) {
-                appletConfigGroup = appletGroup.group(subidentity.cfgGroup);
-            }
-        }
-
-        if (!subidentity.cfgProperty.isEmpty()) {
-            //! if identity provides specific property for configuration group
-            if (appletConfigGroup.hasKey(subidentity.cfgProperty)) {
-                return appletConfigGroup.readEntry(subidentity.cfgProperty, IDNULL);
-            }
-        }
-    }
-
-    return IDNULL;
-}
-
-int Storage::subIdentityIndex(const KConfigGroup &appletGroup) const
-{
-    if (!isSubContainment(appletGroup)) {
-        return IDNULL;
-    }
-
-    //! cycle through subcontainments identities
-    for (int i=0; i<m_subIdentities.count(); ++i) {
-        KConfigGroup appletConfigGroup = appletGroup;
-
-        if (!m_subIdentities[i].cfgGroup.isEmpty()) {
-            //! if identity provides specific configuration group
-            if (appletConfigGroup.hasGroup(m_subIdentities[i].cfgGroup)) {
-                appletConfigGroup = appletGroup.group(m_subIdentities[i].cfgGroup);
-            }
-        }
-
-        if (!m_subIdentities[i].cfgProperty.isEmpty()) {
-            //! if identity provides specific property for configuration group
-            if (appletConfigGroup.hasKey(m_subIdentities[i].cfgProperty)) {
-                int subId = appletConfigGroup.readEntry(m_subIdentities[i].cfgProperty, IDNULL);
-                return isValid(subId) ? i : IDNULL;
-            }
-        }
-    }
-
-    return IDNULL;
+    return m_idsRemapper.subContainmentId(appletGroup);
 }
 
 Plasma::Containment *Storage::subContainmentOf(const Layout::GenericLayout *layout, const Plasma::Applet *applet)
@@ -225,74 +171,30 @@ void Storage::importToCorona(const Layout::GenericLayout *layout)
         return;
     }
 
+    QElapsedTimer importTimer;
+    importTimer.start();
+
     //! Setting mutable for create a containment
     layout->corona()->setImmutability(Plasma::Types::Mutable);
 
-    QString temp1FilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.views";
-    //! we need to copy first the layout file because the kde cache
+    //! the layout file is read directly from disk because the kde cache
     //! may not have yet been updated (KSharedConfigPtr)
     //! this way we make sure at the latest changes stored in the layout file
     //! will be also available when changing to Multiple Layouts
-    QString tempLayoutFilePath = m_storageTmpDir.path() +  "/" + layout->name() + ".multiple.tmplayout";
-
-    //! WE NEED A WAY TO COPY A CONTAINMENT!!!!
-    QFile tempLayoutFile(tempLayoutFilePath);
-    QFile copyFile(temp1FilePath);
-    QFile layoutOriginalFile(layout->file());
-
-    if (tempLayoutFile.exists()) {
-        tempLayoutFile.remove();
-    }
-
-    if (copyFile.exists())
-        copyFile.remove();
-
-    layoutOriginalFile.copy(tempLayoutFilePath);
+    KConfig layoutFile(layout->file(), KConfig::SimpleConfig);
 
-    KSharedConfigPtr filePtr = KSharedConfig::openConfig(tempLayoutFilePath);
-    KSharedConfigPtr newFile = KSharedConfig::openConfig(temp1FilePath);
-    KConfigGroup copyGroup = KConfigGroup(newFile, "Containments");
-    KConfigGroup current_containments = KConfigGroup(filePtr, "Containments");
+    //! containments with updated ids are prepared only in memory
+    KConfig importedConfig(QString(), KConfig::SimpleConfig);
+    KConfigGroup importedContainments(&importedConfig, "Containments");
 
-    current_containments.copyTo(&copyGroup);
-
-    copyGroup.sync();
-
-    //! update ids to unique ones
-    QString temp2File = newUniqueIdsLayoutFromFile(layout, temp1FilePath);
+    newUniqueIdsContainments(layout, KConfigGroup(&layoutFile, "Containments"), importedContainments);
 
     //! Finally import the configuration
-    importLayoutFile(layout, temp2File);
-}
-
-
-QString Storage::availableId(QStringList all, QStringList assigned, int base)
-{
-    bool found = false;
-
-    int i = base;
+    importLayout(layout, KConfigGroup(&importedConfig, ""));
 
-    while (!found && i < 32000) {
-        QString iStr = QString::number(i);
-
-        if (!all.contains(iStr) && !assigned.contains(iStr)) {
-            return iStr;
-        }
-
-        i++;
-    }
-
-    return QString("");
+    qDebug() << "Layout :: " << layout->name() << " was imported to corona in " << importTimer.elapsed() << "ms";
 }
 
-bool Storage::appletGroupIsValid(const KConfigGroup &appletGroup)
-{
-    return !( appletGroup.keyList().count() == 0
-              && appletGroup.groupList().count() == 1
-              && appletGroup.groupList().at(0) == "Configuration"
-              && appletGroup.group("Configuration").keyList().count() == 1
-              && appletGroup.group("Configuration").hasKey("PreloadWeight") );
-}
 
 QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout, QString file)
 {
@@ -308,172 +210,27 @@ QString Storage::newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout,
         copyFile.remove();
     }
 
-    //! BEGIN updating the ids in the temp file
-    QStringList allIds;
-    allIds << layout->corona()->containmentsIds();
-    allIds << layout->corona()->appletsIds();
-
-    QStringList toInvestigateContainmentIds;
-    QStringList toInvestigateAppletIds;
-    QStringList toInvestigateSubContIds;
-
-    //! first is the subcontainment id
-    QHash<QString, QString> subParentContainmentIds;
-    QHash<QString, QString> subAppletIds;
-
-    //qDebug() << "Ids:" << allIds;
-
-    //qDebug() << "to copy containments: " << toCopyContainmentIds;
-    //qDebug() << "to copy applets: " << toCopyAppletIds;
-
-    QStringList assignedIds;
-    QHash<QString, QString> assigned;
-
     KSharedConfigPtr filePtr = KSharedConfig::openConfig(file);
-    KConfigGroup investigate_conts = KConfigGroup(filePtr, "Containments");
-
-    //! Record the containment and applet ids
-    for (const auto &cId : investigate_conts.groupList()) {
-        toInvestigateContainmentIds << cId;
-        auto appletsEntries = investigate_conts.group(cId).group("Applets");
-        toInvestigateAppletIds << appletsEntries.groupList();
-
-        //! investigate for subcontainments
-        for (const auto &appletId : appletsEntries.groupList()) {
-            int subId = subContainmentId(appletsEntries.group(appletId));
-
-            //! It is a subcontainment !!!
-            if (isValid(subId)) {
-                QString tSubIdStr = QString::number(subId);
-                toInvestigateSubContIds << tSubIdStr;
-                subParentContainmentIds[tSubIdStr] = cId;
-                subAppletIds[tSubIdStr] = appletId;
-                qDebug() << "subcontainment was found in the containment...";
-            }
-        }
-    }
-
-    //! Reassign containment and applet ids to unique ones
-    for (const auto &contId : toInvestigateContainmentIds) {
-        QString newId = availableId(allIds, assignedIds, 12);
-
-        assignedIds << newId;
-        assigned[contId] = newId;
-    }
-
-    for (const auto &appId : toInvestigateAppletIds) {
-        QString newId = availableId(allIds, assignedIds, 40);
-
-        assignedIds << newId;
-        assigned[appId] = newId;
-    }
-
-    qDebug() << "ALL CORONA IDS ::: " << allIds;
-    qDebug() << "FULL ASSIGNMENTS ::: " << assigned;
-
-    for (const auto &cId : toInvestigateContainmentIds) {
-        QString value = assigned[cId];
-
-        if (assigned.contains(value)) {
-            QString value2 = assigned[value];
-
-            if (cId != assigned[cId] && !value2.isEmpty() && cId == value2) {
-                qDebug() << "PROBLEM APPEARED !!!! FOR :::: " << cId << " .. fixed ..";
-                assigned[cId] = cId;
-                assigned[value] = value;
-            }
-        }
-    }
-
-    for (const auto &aId : toInvestigateAppletIds) {
-        QString value = assigned[aId];
-
-        if (assigned.contains(value)) {
-            QString value2 = assigned[value];
-
-            if (aId != assigned[aId] && !value2.isEmpty() && aId == value2) {
-                qDebug() << "PROBLEM APPEARED !!!! FOR :::: " << aId << " .. fixed ..";
-                assigned[aId] = aId;
-                assigned[value] = value;
-            }
-        }
-    }
-
-    qDebug() << "FIXED FULL ASSIGNMENTS ::: " << assigned;
-
-    //! update applet ids in their containment order and in MultipleLayouts update also the layoutId
-    for (const auto &cId : investigate_conts.groupList()) {
-        //! Update options that contain applet ids
-        //! (appletOrder) and (lockedZoomApplets) and (userBlocksColorizingApplets)
-        QStringList options;
-        options << "appletOrder" << "lockedZoomApplets" << "userBlocksColorizingApplets";
-
-        for (const auto &settingStr : options) {
-            QString order1 = investigate_conts.group(cId).group("General").readEntry(settingStr, QString());
-
-            if (!order1.isEmpty()) {
-                QStringList order1Ids = order1.split(";");
-                QStringList fixedOrder1Ids;
-
-                for (int i = 0; i < order1Ids.count(); ++i) {
-                    fixedOrder1Ids.append(assigned[order1Ids[i]]);
-                }
-
-                QString fixedOrder1 = fixedOrder1Ids.join(";");
-                investigate_conts.group(cId).group("General").writeEntry(settingStr, fixedOrder1);
-            }
-        }
-
-        if (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
-            investigate_conts.group(cId).writeEntry("layoutId", layout->name());
-        }
-    }
-
-    //! must update also the sub id in its applet
-    for (const auto &subId : toInvestigateSubContIds) {
-        KConfigGroup subParentContainment = investigate_conts.group(subParentContainmentIds[subId]);
-        KConfigGroup subAppletConfig = subParentContainment.group("Applets").group(subAppletIds[subId]);
-
-        int entityIndex = subIdentityIndex(subAppletConfig);
-
-        if (entityIndex >= 0) {
-            if (!m_subIdentities[entityIndex].cfgGroup.isEmpty()) {
-                subAppletConfig = subAppletConfig.group(m_subIdentities[entityIndex].cfgGroup);
-            }
-
-            if (!m_subIdentities[entityIndex].cfgProperty.isEmpty()) {
-                subAppletConfig.writeEntry(m_subIdentities[entityIndex].cfgProperty, assigned[subId]);
-                subParentContainment.sync();
-            }
-        }
-    }
-
-    investigate_conts.sync();
-
-    //! Copy To Temp 2 File And Update Correctly The Ids
     KSharedConfigPtr file2Ptr = KSharedConfig::openConfig(tempFile);
     KConfigGroup fixedNewContainmets = KConfigGroup(file2Ptr, "Containments");
 
-    for (const auto &contId : investigate_conts.groupList()) {
-        QString pluginId = investigate_conts.group(contId).readEntry("plugin", "");
+    newUniqueIdsContainments(layout, KConfigGroup(filePtr, "Containments"), fixedNewContainmets);
 
-        if (pluginId != "org.kde.desktopcontainment") { //!don't add ghost containments
-            KConfigGroup newContainmentGroup = fixedNewContainmets.group(assigned[contId]);
-            investigate_conts.group(contId).copyTo(&newContainmentGroup);
+    fixedNewContainmets.sync();
 
-            newContainmentGroup.group("Applets").deleteGroup();
+    return tempFile;
+}
 
-            for (const auto &appId : investigate_conts.group(contId).group("Applets").groupList()) {
-                KConfigGroup appletGroup = investigate_conts.group(contId).group("Applets").group(appId);
-                KConfigGroup newAppletGroup = fixedNewContainmets.group(assigned[contId]).group("Applets").group(assigned[appId]);
-                appletGroup.copyTo(&newAppletGroup);
-            }
-        }
-    }
+void Storage::newUniqueIdsContainments(const Layout::GenericLayout *layout, const KConfigGroup &containments, KConfigGroup &fixedContainments)
+{
+    QStringList allIds;
+    allIds << layout->corona()->containmentsIds();
+    allIds << layout->corona()->appletsIds();
 
-    fixedNewContainmets.sync();
+    //! in MultipleLayouts update also the layoutId
+    bool multipleLayouts = (layout->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts);
 
-    return tempFile;
+    m_idsRemapper.remap(allIds, multipleLayouts ? layout->name() : QString(), containments, fixedContainments);
 }
 
 void Storage::syncToLayoutFile(const Layout::GenericLayout *layout, bool removeLayoutId)
@@ -485,31 +242,40 @@ void Storage::syncToLayoutFile(const Layout::GenericLayout *layout, bool removeL
     KSharedConfigPtr filePtr = KSharedConfig::openConfig(layout->file());
 
     KConfigGroup oldContainments = KConfigGroup(filePtr, "Containments");
-    oldContainments.deleteGroup();
 
-    qDebug() << " LAYOUT :: " << layout->name() << " is syncing its original file.";
+    QList<KConfigGroup> containments;
 
     for (const auto containment : *layout->containments()) {
         if (removeLayoutId) {
             containment->config().writeEntry("layoutId", "");
         }
 
-        KConfigGroup newGroup = oldContainments.group(QString::number(containment->id()));
-        containment->config().copyTo(&newGroup);
+        containments << containment->config();
+    }
+
+    QStringList changedIds;
+    QStringList removedIds;
 
-        if (!removeLayoutId) {
-            newGroup.writeEntry("layoutId", "");
-            newGroup.sync();
-        }
+    if (!syncContainments(containments, oldContainments, changedIds, removedIds)) {
+        return;
     }
 
+    qDebug() << " LAYOUT :: " << layout->name() << " is syncing its original file, changed containments :: "
+             << changedIds << " removed containments :: " << removedIds;
+
+    //! all changes are written at once
     oldContainments.sync();
 }
 
 QList<Plasma::Containment *> Storage::importLayoutFile(const Layout::GenericLayout *layout, QString file)
 {
     KSharedConfigPtr filePtr = KSharedConfig::openConfig(file);
-    auto newContainments = layout->corona()->importLayout(KConfigGroup(filePtr, ""));
+    return importLayout(layout, KConfigGroup(filePtr, ""));
+}
+
+QList<Plasma::Containment *> Storage::importLayout(const Layout::GenericLayout *layout, const KConfigGroup &layoutGroup)
+{
+    auto newContainments = layout->corona()->importLayout(layoutGroup);
 
     qDebug() << " imported containments ::: " << newContainments.length();
 
@@ -729,19 +495,7 @@ bool Storage::isBroken(const Layout::GenericLayout *layout, QStringList &errors)
         }
     }
 
-#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
-    QSet<QString> idsSet = QSet<QString>::fromList(ids);
-#else
-    QSet<QString> idsSet(ids.begin(), ids.end());
-#endif
-    /* a different way to count duplicates
-    QMap<QString, int> countOfStrings;
-
-    for (int i = 0; i < ids.count(); i++) {
-        countOfStrings[ids[i]]++;
-    }*/
-
-    if (idsSet.count() != ids.count()) {
+    if (hasDuplicatedIds(ids)) {
         qDebug() << "   ----   ERROR - BROKEN LAYOUT :: " << layout->name() << " ----";
 
         if (!layout->corona()) {
@@ -21,6 +21,7 @@
 #define LAYOUTSSTORAGE_H
 
 // local
+#include "idsremapper.h"
 #include "../data/appletdata.h"
 
 // Qt
@@ -43,12 +44,6 @@ struct ViewData;
 namespace Latte {
 namespace Layouts {
 
-struct SubContaimentIdentityData
-{
-    QString cfgGroup;
-    QString cfgProperty;
-};
-
 struct ViewDelayedCreationData
 {
     Plasma::Containment *containment{nullptr};
@@ -88,6 +83,15 @@ public:
     /// STATIC
     //! Check if an applet config group is valid or belongs to removed applet
     static bool appletGroupIsValid(const KConfigGroup &appletGroup);
+    //! a layout is broken when containments and applets share the same ids
+    static bool hasDuplicatedIds(const QStringList &ids);
+    //! compares entries and subgroups recursively
+    static bool groupsAreEqual(const KConfigGroup &group1, const KConfigGroup &group2);
+    //! updates storedContainments with the provided containments config groups. Only containments
+    //! that changed or were added are rewritten, stored containments that are not provided anymore
+    //! are deleted and layoutId is never stored. Returns true when storedContainments changed
+    static bool syncContainments(const QList<KConfigGroup> &containments, KConfigGroup &storedContainments,
+                                 QStringList &changedIds, QStringList &removedIds);
     static bool isValid(const int &id);
 
 
@@ -108,21 +112,23 @@ private:
     Storage();
 
     bool isSubContainment(const KConfigGroup &appletGroup) const;
-    int subIdentityIndex(const KConfigGroup &appletGroup) const;
 
     //! STORAGE !////
-    QString availableId(QStringList all, QStringList assigned, int base);
     //! provides a new file path based the provided file. The new file
     //! has updated ids for containments and applets based on the corona
     //! loaded ones
     QString newUniqueIdsLayoutFromFile(const Layout::GenericLayout *layout, QString file);
+    //! copies the provided containments to fixedContainments with updated ids
+    //! for containments and applets based on the corona loaded ones
+    void newUniqueIdsContainments(const Layout::GenericLayout *layout, const KConfigGroup &containments, KConfigGroup &fixedContainments);
     //! imports a layout file and returns the containments for the docks
     QList<Plasma::Containment *> importLayoutFile(const Layout::GenericLayout *layout, QString file);
+    QList<Plasma::Containment *> importLayout(const Layout::GenericLayout *layout, const KConfigGroup &layoutGroup);
 
 private:
     QTemporaryDir m_storageTmpDir;
 
-    QList<SubContaimentIdentityData> m_subIdentities;
+    IdsRemapper m_idsRemapper;
 };
 
 }
@@ -0,0 +1,146 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "storage.h"
+
+// Qt
+#include <QSet>
+
+// KDE
+#include <KConfig>
+
+//! Storage functions that work only with config groups, they are kept apart
+//! from the rest of Storage in order to be used without a running corona
+
+namespace Latte {
+namespace Layouts {
+
+namespace {
+
+//! deleted groups can still be listed until their config is synced
+QStringList existingGroups(const KConfigGroup &group)
+{
+    QStringList groups;
+
+    for (const auto &subGroup : group.groupList()) {
+        if (group.hasGroup(subGroup)) {
+            groups << subGroup;
+        }
+    }
+
+    groups.sort();
+
+    return groups;
+}
+
+}
+
+bool Storage::appletGroupIsValid(const KConfigGroup &appletGroup)
+{
+    return !( appletGroup.keyList().count() == 0
+              && appletGroup.groupList().count() == 1
+              && appletGroup.groupList().at(0) == "Configuration"
+              && appletGroup.group("Configuration").keyList().count() == 1
+              && appletGroup.group("Configuration").hasKey("PreloadWeight") );
+}
+
+bool Storage::hasDuplicatedIds(const QStringList &ids)
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+    QSet<QString> idsSet = QSet<QString>::fromList(ids);
+#else
+    QSet<QString> idsSet(ids.begin(), ids.end());
+#endif
+
+    return idsSet.count() != ids.count();
+}
+
+bool Storage::groupsAreEqual(const KConfigGroup &group1, const KConfigGroup &group2)
+{
+    if (group1.entryMap() != group2.entryMap()) {
+        return false;
+    }
+
+    QStringList subGroups1 = existingGroups(group1);
+    QStringList subGroups2 = existingGroups(group2);
+
+    if (subGroups1 != subGroups2) {
+        return false;
+    }
+
+    for (const auto &subGroup : subGroups1) {
+        if (!groupsAreEqual(group1.group(subGroup), group2.group(subGroup))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Storage::syncContainments(const QList<KConfigGroup> &containments, KConfigGroup &storedContainments,
+                               QStringList &changedIds, QStringList &removedIds)
+{
+    //! containments as they should be stored, layoutId is never stored in layout files
+    KConfig syncedConfig(QString(), KConfig::SimpleConfig);
+    KConfigGroup syncedContainments(&syncedConfig, "Containments");
+
+    QStringList containmentIds;
+
+    for (const auto &containment : containments) {
+        QString cId = containment.name();
+        containmentIds << cId;
+
+        KConfigGroup syncedGroup = syncedContainments.group(cId);
+        containment.copyTo(&syncedGroup);
+        syncedGroup.writeEntry("layoutId", "");
+    }
+
+    //! only containments that changed since the last sync are written
+    for (const auto &cId : containmentIds) {
+        if (!storedContainments.hasGroup(cId) || !groupsAreEqual(storedContainments.group(cId), syncedContainments.group(cId))) {
+            changedIds << cId;
+        }
+    }
+
+    for (const auto &cId : existingGroups(storedContainments)) {
+        if (!containmentIds.contains(cId)) {
+            removedIds << cId;
+        }
+    }
+
+    if (changedIds.isEmpty() && removedIds.isEmpty()) {
+        return false;
+    }
+
+    for (const auto &cId : removedIds) {
+        storedContainments.deleteGroup(cId);
+    }
+
+    for (const auto &cId : changedIds) {
+        storedContainments.deleteGroup(cId);
+
+        KConfigGroup newGroup = storedContainments.group(cId);
+        syncedContainments.group(cId).copyTo(&newGroup);
+    }
+
+    return true;
+}
+
+}
+}
@@ -34,6 +34,7 @@
 // Qt
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 // Plasma
 #include <Plasma/Containment>
@@ -43,6 +44,9 @@
 #include <KActivities/Controller>
 #include <KWindowSystem>
 
+//! memory limit for preloaded layouts
+#define MAXPRELOADEDVIEWS 8
+
 namespace Latte {
 namespace Layouts {
 
@@ -58,6 +62,11 @@ Synchronizer::Synchronizer(QObject *parent)
     connect(m_manager->corona()->universalSettings(), &UniversalSettings::showInfoWindowChanged, this, &Synchronizer::updateDynamicSwitchInterval);
     connect(&m_dynamicSwitchTimer, &QTimer::timeout, this, &Synchronizer::confirmDynamicSwitch);
 
+    //! Layouts preloading
+    connect(m_manager->corona()->universalSettings(), &UniversalSettings::preloadedLayoutsChanged, this, [&]() {
+        unloadPreloadedLayouts(preloadingEnabled() ? m_manager->corona()->universalSettings()->preloadedLayouts() : 0);
+    });
+
     //! KActivities tracking
     connect(m_manager->corona()->activitiesConsumer(), &KActivities::Consumer::currentActivityChanged,
             this, &Synchronizer::currentActivityChanged);
@@ -496,6 +505,12 @@ void Synchronizer::syncActiveLayoutsToOriginalFiles()
             layout->syncToLayoutFile();
         }
 
+        //! preloaded layouts are kept, they are reused afterwards only when their files were not altered
+        for (const auto layout : m_preloadedLayouts) {
+            layout->syncToLayoutFile(false);
+            m_preloadedFilesModified[layout] = QFileInfo(layout->file()).lastModified();
+        }
+
         for (const auto layout : m_sharedLayouts) {
             layout->syncToLayoutFile();
         }
@@ -553,6 +568,9 @@ void Synchronizer::unloadSharedLayout(SharedLayout *layout)
 
 void Synchronizer::loadLayouts()
 {
+    //! layouts properties may have changed
+    unloadOutdatedPreloadedLayouts();
+
     m_layouts.clear();
     m_menuLayouts.clear();
     m_assignedLayouts.clear();
@@ -622,6 +640,8 @@ void Synchronizer::onLayoutAdded(const QString &layout)
 
 void Synchronizer::unloadLayouts()
 {
+    unloadPreloadedLayouts(0);
+
     //! Unload all CentralLayouts
     while (!m_centralLayouts.isEmpty()) {
         CentralLayout *layout = m_centralLayouts.at(0);
@@ -890,16 +910,21 @@ void Synchronizer::syncMultipleLayoutsToActivities(QString layoutForFreeActiviti
     //! Add needed Layouts based on Activities
     for (const auto &layoutName : layoutsToLoad) {
         if (!centralLayout(layoutName)) {
-            CentralLayout *newLayout = new CentralLayout(this, QString(layoutPath(layoutName)), layoutName);
+            CentralLayout *newLayout = takePreloadedLayout(layoutName);
 
             if (newLayout) {
+                qDebug() << "ACTIVATING PRELOADED LAYOUT ::::: " << layoutName;
+                m_centralLayouts.append(newLayout);
+                newLayout->syncLatteViewsToScreens();
+            } else {
+                newLayout = new CentralLayout(this, QString(layoutPath(layoutName)), layoutName);
                 qDebug() << "ACTIVATING LAYOUT ::::: " << layoutName;
                 addLayout(newLayout);
                 newLayout->importToCorona();
+            }
 
-                if (m_manager->corona()->universalSettings()->showInfoWindow()) {
-                    m_manager->showInfoWindow(i18n("Activating layout: <b>%0</b> ...").arg(newLayout->name()), 5000, newLayout->appliedActivities());
-                }
+            if (m_manager->corona()->universalSettings()->showInfoWindow()) {
+                m_manager->showInfoWindow(i18n("Activating layout: <b>%0</b> ...").arg(newLayout->name()), 5000, newLayout->appliedActivities());
             }
         }
     }
@@ -925,9 +950,16 @@ void Synchronizer::syncMultipleLayoutsToActivities(QString layoutForFreeActiviti
         int posLayout = centralLayoutPos(layoutName);
 
         if (posLayout >= 0) {
-            qDebug() << "REMOVING LAYOUT ::::: " << layoutName;
             m_centralLayouts.removeAt(posLayout);
 
+            if (canBePreloaded(layout)) {
+                qDebug() << "KEEPING LAYOUT PRELOADED ::::: " << layoutName;
+                preloadLayout(layout);
+                continue;
+            }
+
+            qDebug() << "REMOVING LAYOUT ::::: " << layoutName;
+
             layout->syncToLayoutFile(true);
             layout->unloadContainments();
             layout->unloadLatteViews();
@@ -940,6 +972,117 @@ void Synchronizer::syncMultipleLayoutsToActivities(QString layoutForFreeActiviti
     emit centralLayoutsChanged();
 }
 
+bool Synchronizer::preloadingEnabled() const
+{
+    //! Plasma wayland does not support yet Activities in order to hide the preloaded views
+    return !KWindowSystem::isPlatformWayland()
+            && m_manager->corona()->universalSettings()->preloadedLayouts() > 0;
+}
+
+bool Synchronizer::canBePreloaded(CentralLayout *layout) const
+{
+    //! views of layouts that are not assigned to specific activities would be shown in all activities
+    return layout && !layout->activities().isEmpty() && preloadingEnabled();
+}
+
+void Synchronizer::preloadLayout(CentralLayout *layout)
+{
+    //! layoutId is kept in containments because they are still loaded
+    layout->syncToLayoutFile(false);
+
+    m_preloadedLayouts.removeAll(layout);
+    m_preloadedLayouts.prepend(layout);
+    m_preloadedFilesModified[layout] = QFileInfo(layout->file()).lastModified();
+
+    unloadPreloadedLayouts(m_manager->corona()->universalSettings()->preloadedLayouts());
+}
+
+CentralLayout *Synchronizer::takePreloadedLayout(const QString &layoutName)
+{
+    if (!preloadingEnabled()) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < m_preloadedLayouts.count(); ++i) {
+        if (m_preloadedLayouts[i]->name() == layoutName) {
+            m_preloadHits++;
+            m_preloadedFilesModified.remove(m_preloadedLayouts[i]);
+            return m_preloadedLayouts.takeAt(i);
+        }
+    }
+
+    m_preloadMisses++;
+    return nullptr;
+}
+
+void Synchronizer::unloadPreloadedLayout(CentralLayout *layout, bool syncToFile)
+{
+    qDebug() << "REMOVING PRELOADED LAYOUT ::::: " << layout->name();
+
+    m_preloadedLayouts.removeAll(layout);
+    m_preloadedFilesModified.remove(layout);
+
+    if (syncToFile) {
+        layout->syncToLayoutFile(true);
+    }
+
+    layout->unloadContainments();
+    layout->unloadLatteViews();
+    m_manager->clearUnloadedContainmentsFromLinkedFile(layout->unloadedContainmentsIds());
+    delete layout;
+}
+
+void Synchronizer::unloadPreloadedLayouts(int maxLayouts)
+{
+    int views{0};
+
+    for (const auto layout : m_preloadedLayouts) {
+        views += layout->viewsCount();
+    }
+
+    //! least recently used layouts are unloaded first
+    while (!m_preloadedLayouts.isEmpty() && (m_preloadedLayouts.count() > maxLayouts || views > MAXPRELOADEDVIEWS)) {
+        CentralLayout *layout = m_preloadedLayouts.last();
+        views -= layout->viewsCount();
+        unloadPreloadedLayout(layout, true);
+    }
+}
+
+void Synchronizer::unloadOutdatedPreloadedLayouts()
+{
+    //! files that were altered or removed from settings window or externally are the ones to
+    //! be trusted, so these layouts are not synced before they are unloaded
+    for (const auto layout : QList<CentralLayout *>(m_preloadedLayouts)) {
+        QFileInfo layoutFileInfo(layout->file());
+
+        if (!layoutFileInfo.exists() || layoutFileInfo.lastModified() != m_preloadedFilesModified.value(layout)) {
+            m_preloadOutdated++;
+            unloadPreloadedLayout(layout, false);
+        }
+    }
+}
+
+QString Synchronizer::preloadingReport() const
+{
+    int views{0};
+
+    for (const auto layout : m_preloadedLayouts) {
+        views += layout->viewsCount();
+    }
+
+    const int requests = m_preloadHits + m_preloadMisses;
+
+    return QStringLiteral("layoutsPreloading enabled=%1 preloaded=%2 max_preloaded=%3 views=%4 hits=%5 misses=%6 hit_rate=%7 outdated=%8")
+            .arg(preloadingEnabled() ? 1 : 0)
+            .arg(m_preloadedLayouts.count())
+            .arg(m_manager->corona()->universalSettings()->preloadedLayouts())
+            .arg(views)
+            .arg(m_preloadHits)
+            .arg(m_preloadMisses)
+            .arg(requests > 0 ? (100 * m_preloadHits / requests) : 0)
+            .arg(m_preloadOutdated);
+}
+
 void Synchronizer::syncActiveShares(SharesMap &sharesMap, QStringList &deprecatedShares)
 {
     if (m_manager->memoryUsage() != MemoryUsage::MultipleLayouts) {
@@ -21,6 +21,7 @@
 #define LAYOUTSSYNCHRONIZER_H
 
 // Qt
+#include <QDateTime>
 #include <QObject>
 #include <QHash>
 #include <QTimer>
@@ -96,6 +97,9 @@ public:
 
     QString shouldSwitchToLayout(QString activityId);
 
+    //! layouts preloading hits and misses, one line with space separated key=value pairs
+    QString preloadingReport() const;
+
     QStringList centralLayoutsNames();
     QStringList layouts() const;
     QStringList menuLayouts() const;
@@ -141,6 +145,16 @@ private:
     void unloadCentralLayout(CentralLayout *layout);
     void unloadSharedLayout(SharedLayout *layout);
 
+    //! inactive central layouts that are kept loaded in order to be activated instantly
+    bool preloadingEnabled() const;
+    bool canBePreloaded(CentralLayout *layout) const;
+    void preloadLayout(CentralLayout *layout);
+    void unloadPreloadedLayout(CentralLayout *layout, bool syncToFile);
+    void unloadPreloadedLayouts(int maxLayouts);
+    //! preloaded layouts whose files changed or were removed since they were preloaded
+    void unloadOutdatedPreloadedLayouts();
+    CentralLayout *takePreloadedLayout(const QString &layoutName);
+
     bool layoutIsAssigned(QString layoutName);
 
     QString layoutPath(QString layoutName);
@@ -151,6 +165,10 @@ private:
     bool m_multipleModeInitialized{false};
     bool m_isLoaded{false};
 
+    int m_preloadHits{0};
+    int m_preloadMisses{0};
+    int m_preloadOutdated{0};
+
     QString m_currentLayoutNameInMultiEnvironment;
     QString m_shouldSwitchToLayout;
 
@@ -165,6 +183,11 @@ private:
     QList<CentralLayout *> m_centralLayouts;
     QList<SharedLayout *> m_sharedLayouts;
 
+    //! most recently used first
+    QList<CentralLayout *> m_preloadedLayouts;
+    //! layout file modification time when it was last synced from its preloaded layout
+    QHash<CentralLayout *, QDateTime> m_preloadedFilesModified;
+
     Layouts::Manager *m_manager;
     KActivities::Controller *m_activitiesController;
 };
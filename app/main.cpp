@@ -35,6 +35,8 @@
 #include <QCommandLineParser>
 #include <QCommandLineOption>
 #include <QDir>
+#include <QDBusInterface>
+#include <QDBusReply>
 #include <QLockFile>
 #include <QSharedMemory>
 
@@ -105,6 +107,7 @@ int main(int argc, char **argv)
                           , {{"cc", "clear-cache"}, i18nc("command line", "Clear qml cache. It can be useful after system upgrades.")}
                           , {"default-layout", i18nc("command line", "Import and load default layout on startup.")}
                           , {"available-layouts", i18nc("command line", "Print available layouts")}
+                          , {"perf-report", i18nc("command line", "Print windows tracking and layouts preloading performance counters of the running instance")}
                           , {"layout", i18nc("command line", "Load specific layout on startup."), i18nc("command line: load", "layout_name")}
                           , {"import-layout", i18nc("command line", "Import and load a layout."), i18nc("command line: import", "file_name")}
                           , {"import-full", i18nc("command line", "Import full configuration."), i18nc("command line: import", "file_name")}
@@ -164,6 +167,11 @@ int main(int argc, char **argv)
     filterDebugTextOption.setValueName(i18nc("command line: debug-text", "filter_debug_text"));
     parser.addOption(filterDebugTextOption);
 
+    QCommandLineOption iconCacheOption(QStringList() << QStringLiteral("iconcache"));
+    iconCacheOption.setDescription(QStringLiteral("Show messages for debugging the icons cache hit rates (Only useful to devs)."));
+    iconCacheOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(iconCacheOption);
+
     QCommandLineOption filterDebugInputMask(QStringList() << QStringLiteral("input"));
     filterDebugInputMask.setDescription(QStringLiteral("Show visual window indicators for calculated input mask."));
     filterDebugInputMask.setFlags(QCommandLineOption::HiddenFromHelp);
@@ -190,6 +198,27 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    //! print perf-report
+    if (parser.isSet(QStringLiteral("perf-report"))) {
+        QDBusInterface iface(QStringLiteral("org.kde.lattedock"), QStringLiteral("/Latte"), QStringLiteral("org.kde.LatteDock"), QDBusConnection::sessionBus());
+        QDBusReply<QString> report = iface.call(QStringLiteral("trackerPerformanceReport"));
+
+        if (report.isValid()) {
+            qInfo().noquote() << report.value();
+
+            QDBusReply<QString> preloadingReport = iface.call(QStringLiteral("layoutsPreloadingReport"));
+
+            if (preloadingReport.isValid()) {
+                qInfo().noquote() << preloadingReport.value();
+            }
+        } else {
+            qInfo() << i18n("There is no running instance to report performance counters from.");
+        }
+
+        qGuiApp->exit();
+        return 0;
+    }
+
     bool defaultLayoutOnStartup = false;
     int memoryUsage = -1;
     QString layoutNameOnStartup = "";
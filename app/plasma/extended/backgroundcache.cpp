@@ -20,14 +20,24 @@
 #include "backgroundcache.h"
 
 // local
+#include "../../tools/brightnesskernel.h"
 #include "../../tools/commontools.h"
 
 // Qt
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QImage>
+#include <QImageReader>
 #include <QList>
 #include <QRgb>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent>
 #include <QtMath>
 
 // Plasma
@@ -38,8 +48,24 @@
 #include <KDirWatch>
 
 #define MAXHASHSIZE 300
+#define MAXWORKERS 2
+
+//! 24px. should be enough because the views are always snapped to edges
+#define EDGETHICKNESS 24
+//! bigger images are decoded downscaled at that length
+#define MAXDECODEDLENGTH 1920
+
+//! image files beginning and ending that are used for their content hash
+#define HASHEDBYTES 65536
+
+#define HINTSFILE "lattedock/backgroundhints"
+#define HINTSFILEVERSION 1
+#define SAVEHINTSINTERVAL 5000
 
 #define PLASMACONFIG "plasma-org.kde.plasma.desktop-appletsrc"
+#define CONTAINMENTSGROUP "[Containments]["
+#define WALLPAPERGROUP "[Wallpaper]"
+#define RELOADINTERVAL 300
 #define DEFAULTWALLPAPER "wallpapers/Next/contents/images/1920x1080.png"
 
 namespace Latte{
@@ -50,9 +76,7 @@ BackgroundCache::BackgroundCache(QObject *parent)
       m_initialized(false),
       m_plasmaConfig(KSharedConfig::openConfig(PLASMACONFIG))
 {
-    const auto configFile = QStandardPaths::writableLocation(
-                QStandardPaths::GenericConfigLocation) +
-            QLatin1Char('/') + PLASMACONFIG;
+    const auto configFile = plasmaConfigFilePath();
 
     m_defaultWallpaperPath = Latte::standardPath(DEFAULTWALLPAPER);
 
@@ -67,11 +91,32 @@ BackgroundCache::BackgroundCache(QObject *parent)
         m_pool = new ScreenPool(this);
     }
 
+    //! decoding many big wallpapers at the same time increases memory usage a lot
+    m_workers.setMaxThreadCount(MAXWORKERS);
+
+    m_saveHintsTimer.setInterval(SAVEHINTSINTERVAL);
+    m_saveHintsTimer.setSingleShot(true);
+    connect(&m_saveHintsTimer, &QTimer::timeout, this, &BackgroundCache::saveHints);
+
+    loadHints();
+
+    //! plasma rewrites its config file in bursts, e.g. when widgets are saving their state
+    m_reloadTimer.setInterval(RELOADINTERVAL);
+    m_reloadTimer.setSingleShot(true);
+    connect(&m_reloadTimer, &QTimer::timeout, this, &BackgroundCache::reloadChangedContainments);
+
+    m_containmentsSignatures = containmentsSignatures();
+
     reload();
 }
 
 BackgroundCache::~BackgroundCache()
 {   
+    if (m_saveHintsTimer.isActive()) {
+        m_saveHintsTimer.stop();
+        saveHints();
+    }
+
     if (m_pool) {
         m_pool->deleteLater();
     }
@@ -89,9 +134,106 @@ void BackgroundCache::settingsFileChanged(const QString &file) {
     }
 
     if (m_initialized) {
-        m_plasmaConfig->reparseConfiguration();
-        reload();
+        m_reloadTimer.start();
+    }
+}
+
+QString BackgroundCache::plasmaConfigFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + QLatin1Char('/') + PLASMACONFIG;
+}
+
+//! Only the containments top level groups and their wallpaper groups are relevant
+//! to backgrounds. Their raw lines are hashed per containment directly from the file
+//! contents, this way changes from widgets can be identified without the costly
+//! config parsing
+QHash<QString, QByteArray> BackgroundCache::containmentsSignatures() const
+{
+    QHash<QString, QByteArray> signatures;
+
+    QFile file(plasmaConfigFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return signatures;
+    }
+
+    const QByteArray contents = file.readAll();
+    const QByteArray containmentsGroup(CONTAINMENTSGROUP);
+    const QByteArray wallpaperGroup(WALLPAPERGROUP);
+
+    QHash<QString, QCryptographicHash *> hashes;
+    QCryptographicHash *current{nullptr};
+
+    int lineStart = 0;
+
+    while (lineStart < contents.size()) {
+        int lineEnd = contents.indexOf('\n', lineStart);
+
+        if (lineEnd < 0) {
+            lineEnd = contents.size();
+        }
+
+        const QByteArray line = QByteArray::fromRawData(contents.constData() + lineStart, lineEnd - lineStart);
+
+        if (line.startsWith('[')) {
+            current = nullptr;
+
+            if (line.startsWith(containmentsGroup)) {
+                const int idEnd = line.indexOf(']', containmentsGroup.size());
+
+                if (idEnd > 0) {
+                    const QByteArray subGroup = line.mid(idEnd + 1).trimmed();
+
+                    if (subGroup.isEmpty() || subGroup.startsWith(wallpaperGroup)) {
+                        const QString id = QString::fromUtf8(line.mid(containmentsGroup.size(), idEnd - containmentsGroup.size()));
+
+                        if (!hashes.contains(id)) {
+                            hashes[id] = new QCryptographicHash(QCryptographicHash::Md5);
+                        }
+
+                        current = hashes[id];
+                    }
+                }
+            }
+        }
+
+        if (current) {
+            current->addData(line.constData(), line.size());
+            current->addData("\n", 1);
+        }
+
+        lineStart = lineEnd + 1;
+    }
+
+    for (auto hash = hashes.constBegin(); hash != hashes.constEnd(); ++hash) {
+        signatures[hash.key()] = hash.value()->result();
+        delete hash.value();
     }
+
+    return signatures;
+}
+
+void BackgroundCache::reloadChangedContainments()
+{
+    const QHash<QString, QByteArray> signatures = containmentsSignatures();
+
+    QStringList changed;
+
+    for (auto signature = signatures.constBegin(); signature != signatures.constEnd(); ++signature) {
+        if (m_containmentsSignatures.value(signature.key()) != signature.value()) {
+            changed << signature.key();
+        }
+    }
+
+    m_containmentsSignatures = signatures;
+
+    if (changed.isEmpty()) {
+        //! only widgets or panels changed their settings
+        return;
+    }
+
+    m_plasmaConfig->reparseConfiguration();
+    reload(changed);
 }
 
 QString BackgroundCache::backgroundFromConfig(const KConfigGroup &config, QString wallpaperPlugin) const
@@ -128,14 +270,23 @@ bool BackgroundCache::isDesktopContainment(const KConfigGroup &containment) cons
 
 void BackgroundCache::reload()
 {
-    // Traversing through all containments in search for
+    reload(m_plasmaConfig->group("Containments").groupList());
+}
+
+void BackgroundCache::reload(const QStringList &containmentIds)
+{
+    // Traversing through the containments in search for
     // containments that define activities in plasma
     KConfigGroup plasmaConfigContainments = m_plasmaConfig->group("Containments");
 
     //!activityId and screen names for which their background was updated
     QHash<QString, QList<QString>> updates;
 
-    for (const auto &containmentId : plasmaConfigContainments.groupList()) {
+    for (const auto &containmentId : containmentIds) {
+        if (!plasmaConfigContainments.hasGroup(containmentId)) {
+            continue;
+        }
+
         const auto containment = plasmaConfigContainments.group(containmentId);
         const auto wallpaperPlugin = containment.readEntry("wallpaperplugin", QString());
         const auto lastScreen  = containment.readEntry("lastScreen", 0);
@@ -224,15 +375,18 @@ float BackgroundCache::brightnessFromArea(QImage &image, int firstRow, int first
     float areaBrightness = -1000;
 
     if (image.format() != QImage::Format_Invalid) {
-        for (int row = firstRow; row < endRow; ++row) {
-            QRgb *line = (QRgb *)image.scanLine(row);
-
-            for (int col = firstColumn; col < endColumn ; ++col) {
-                QRgb pixelData = line[col];
-                float pixelBrightness = Latte::colorBrightness(pixelData);
-
-                areaBrightness = (areaBrightness == -1000) ? pixelBrightness : (areaBrightness + pixelBrightness);
+        //! brightness is accumulated as an exact integer weighted sum for each row
+        //! and is converted to brightness only once for the entire area
+        quint64 areaWeightedSum{0};
+        const int columns = endColumn - firstColumn;
+
+        if (columns > 0 && endRow > firstRow) {
+            for (int row = firstRow; row < endRow; ++row) {
+                const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(row));
+                areaWeightedSum += Latte::brightnessSum(line + firstColumn, columns);
             }
+
+            areaBrightness = static_cast<float>(double(areaWeightedSum) / 1000);
         }
 
         float areaSize = (endRow - firstRow) * (endColumn - firstColumn);
@@ -242,7 +396,7 @@ float BackgroundCache::brightnessFromArea(QImage &image, int firstRow, int first
     return areaBrightness;
 }
 
-bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
+bool BackgroundCache::areaIsBusy(float bright1, float bright2)
 {
     bool bright1IsLight = bright1>=123;
     bool bright2IsLight = bright2>=123;
@@ -261,131 +415,243 @@ bool BackgroundCache::areaIsBusy(float bright1, float bright2) const
 //! area brightness. In order to indicate if this area is busy or not we
 //! compare the minimum and the maximum values of brightness from these
 //! tiles. If the difference it too big then the area is busy
-void BackgroundCache::updateImageCalculations(QString imageFile, Plasma::Types::Location location)
+imageHints BackgroundCache::edgeHints(QImage &image, Plasma::Types::Location location, int thickness)
 {
-    if (m_hintsCache.size() > MAXHASHSIZE) {
-        cleanupHashes();
-    }
+    imageHints iHints;
 
-    //! if it is a local image
-    QImage image(imageFile);
+    float brightness{-1000};
+    float maxBrightness{0};
+    float minBrightness{255};
 
-    if (image.format() != QImage::Format_Invalid) {
-        float brightness{-1000};
-        float maxBrightness{0};
-        float minBrightness{255};
-
-        bool vertical = (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) ? true : false;
-        int imageLength = !vertical ? image.width() : image.height();
-        int tiles{qMin(10,imageLength)};
+    bool vertical = (location == Plasma::Types::LeftEdge || location == Plasma::Types::RightEdge) ? true : false;
+    int imageLength = !vertical ? image.width() : image.height();
+    int tiles{qMin(10,imageLength)};
 
-        //! 24px. should be enough because the views are always snapped to edges
-        int tileThickness = !vertical ? qMin(24,image.height()) : qMin(24,image.width());
-        int tileLength = imageLength / tiles ;
+    int tileThickness = !vertical ? qMin(thickness,image.height()) : qMin(thickness,image.width());
+    int tileLength = imageLength / tiles ;
 
-        int tileWidth = !vertical ? tileLength : tileThickness;
-        int tileHeight = !vertical ? tileThickness : tileLength;
+    int tileWidth = !vertical ? tileLength : tileThickness;
+    int tileHeight = !vertical ? tileThickness : tileLength;
 
-        float factor = ((float)100/tiles)/100;
+    float factor = ((float)100/tiles)/100;
 
-        QList<float> subBrightness;
+    QList<float> subBrightness;
 
-        qDebug() << "------------   -- Image Calculations --  --------------" ;
-        qDebug() << "Hints for Background image | " << imageFile;
-        qDebug() << "Hints for Background image | Edge: " << location << ", Image size: " << image.width() << "x" << image.height() << ", Tiles: " << tiles << ", subsize: " << tileWidth << "x" << tileHeight;
+    qDebug() << "Hints for Background image | Edge: " << location << ", Image size: " << image.width() << "x" << image.height() << ", Tiles: " << tiles << ", subsize: " << tileWidth << "x" << tileHeight;
 
-        //! Iterating algorigthm
-        int firstRow = 0; int firstColumn = 0; int endRow = 0; int endColumn = 0;
+    //! Iterating algorigthm
+    int firstRow = 0; int firstColumn = 0; int endRow = 0; int endColumn = 0;
 
-        //! horizontal tiles calculations
-        if (location == Plasma::Types::TopEdge) {
-            firstRow = 0; endRow = tileThickness;
-        } else if (location == Plasma::Types::BottomEdge) {
-            firstRow = image.height() - tileThickness - 1; endRow = image.height() - 1;
-        }
+    //! horizontal tiles calculations
+    if (location == Plasma::Types::TopEdge) {
+        firstRow = 0; endRow = tileThickness;
+    } else if (location == Plasma::Types::BottomEdge) {
+        firstRow = image.height() - tileThickness - 1; endRow = image.height() - 1;
+    }
 
-        if (!vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstColumn = endColumn+1; endColumn = (subFactor*imageLength) - 1;
-                endColumn = qMin(endColumn, imageLength-1);
+    if (!vertical) {
+        for (int i=1; i<=tiles; ++i) {
+            float subFactor = ((float)i) * factor;
+            firstColumn = endColumn+1; endColumn = (subFactor*imageLength) - 1;
+            endColumn = qMin(endColumn, imageLength-1);
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering horizontal << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+            int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
+            qDebug() << " Tile considering horizontal << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
+                     << ", brightness: " << tempBrightness;
 
-                subBrightness.append(tempBrightness);
+            subBrightness.append(tempBrightness);
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
-                }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
-                }
+            if (tempBrightness > maxBrightness) {
+                maxBrightness = tempBrightness;
+            }
+            if (tempBrightness < minBrightness) {
+                minBrightness = tempBrightness;
             }
         }
+    }
 
-        //! vertical tiles calculations
-        if (location == Plasma::Types::LeftEdge) {
-            firstColumn = 0; endColumn = tileThickness;
-        } else if (location == Plasma::Types::RightEdge) {
-            firstColumn = image.width() - 1 - tileThickness; endColumn = image.width() - 1;
-        }
+    //! vertical tiles calculations
+    if (location == Plasma::Types::LeftEdge) {
+        firstColumn = 0; endColumn = tileThickness;
+    } else if (location == Plasma::Types::RightEdge) {
+        firstColumn = image.width() - 1 - tileThickness; endColumn = image.width() - 1;
+    }
 
-        if (vertical) {
-            for (int i=1; i<=tiles; ++i) {
-                float subFactor = ((float)i) * factor;
-                firstRow = endRow+1; endRow = (subFactor*imageLength) - 1;
-                endRow = qMin(endRow, imageLength-1);
+    if (vertical) {
+        for (int i=1; i<=tiles; ++i) {
+            float subFactor = ((float)i) * factor;
+            firstRow = endRow+1; endRow = (subFactor*imageLength) - 1;
+            endRow = qMin(endRow, imageLength-1);
 
-                int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
-                qDebug() << " Tile considering vertical << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
-                         << ", brightness: " << tempBrightness;
+            int tempBrightness = brightnessFromArea(image, firstRow, firstColumn, endRow, endColumn);
+            qDebug() << " Tile considering vertical << (" << firstColumn << "," << firstRow << ") - (" << endColumn << "," << endRow << "), subfactor: " << subFactor
+                     << ", brightness: " << tempBrightness;
 
-                subBrightness.append(tempBrightness);
+            subBrightness.append(tempBrightness);
 
-                if (tempBrightness > maxBrightness) {
-                    maxBrightness = tempBrightness;
-                }
-                if (tempBrightness < minBrightness) {
-                    minBrightness = tempBrightness;
-                }
+            if (tempBrightness > maxBrightness) {
+                maxBrightness = tempBrightness;
+            }
+            if (tempBrightness < minBrightness) {
+                minBrightness = tempBrightness;
             }
         }
-        //! compute total brightness for this area
-        float subBrightnessSum = 0;
+    }
+    //! compute total brightness for this area
+    float subBrightnessSum = 0;
 
-        for (int i=0; i<subBrightness.count(); ++i) {
-            subBrightnessSum = subBrightnessSum + subBrightness[i];
-        }
+    for (int i=0; i<subBrightness.count(); ++i) {
+        subBrightnessSum = subBrightnessSum + subBrightness[i];
+    }
 
-        brightness = subBrightnessSum / subBrightness.count();
+    brightness = subBrightnessSum / subBrightness.count();
 
-        bool areaBusy = areaIsBusy(minBrightness, maxBrightness);
+    bool areaBusy = areaIsBusy(minBrightness, maxBrightness);
 
-        qDebug() << "Hints for Background image | Brightness: " << brightness << ", Busy: " << areaBusy << ", minBright:" << minBrightness << ", maxBright:" << maxBrightness;
+    qDebug() << "Hints for Background image | Brightness: " << brightness << ", Busy: " << areaBusy << ", minBright:" << minBrightness << ", maxBright:" << maxBrightness;
 
-        if (!m_hintsCache.keys().contains(imageFile)) {
-            m_hintsCache[imageFile] = EdgesHash();
-        }
+    iHints.brightness = brightness;
+    iHints.busy = areaBusy;
 
-        if (!m_hintsCache[imageFile].contains(location)) {
-            imageHints iHints;
-            iHints.brightness = brightness; iHints.busy = areaBusy;
-            m_hintsCache[imageFile].insert(location, iHints);
-        } else {
-            m_hintsCache[imageFile][location].brightness = brightness;
-            m_hintsCache[imageFile][location].busy = areaBusy;
-        }
+    return iHints;
+}
+
+//! brightness calculations read pixels as QRgb
+QImage BackgroundCache::toRgbImage(const QImage &image)
+{
+    if (image.format() == QImage::Format_RGB32
+            || image.format() == QImage::Format_ARGB32
+            || image.format() == QImage::Format_ARGB32_Premultiplied
+            || image.format() == QImage::Format_Invalid) {
+        return image;
     }
+
+    return image.convertToFormat(QImage::Format_ARGB32);
 }
 
-float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Location location)
+//! calculates the hints for all edges together from a single decode of the image.
+//! The left/right strips span all image rows and even with clipping the decoders
+//! read nearly the entire file for them, so the image is decoded only once,
+//! downscaled when it is big, and all edge strips are sliced from it
+EdgesHash BackgroundCache::edgesCalculations(const QString &imageFile)
 {
-    if (m_hintsCache.keys().contains(imageFile)) {
-        if (m_hintsCache[imageFile].keys().contains(location)) {
-            return m_hintsCache[imageFile][location].brightness;
+    const QList<Plasma::Types::Location> locations{Plasma::Types::TopEdge, Plasma::Types::BottomEdge, Plasma::Types::LeftEdge, Plasma::Types::RightEdge};
+
+    EdgesHash hints;
+
+    qDebug() << "------------   -- Image Calculations --  --------------" ;
+    qDebug() << "Hints for Background image | " << imageFile;
+
+    QImageReader reader(imageFile);
+    const QSize imageSize = reader.size();
+
+    int thickness{EDGETHICKNESS};
+
+    if (imageSize.isValid() && qMax(imageSize.width(), imageSize.height()) > MAXDECODEDLENGTH) {
+        QSize scaledSize = imageSize.scaled(MAXDECODEDLENGTH, MAXDECODEDLENGTH, Qt::KeepAspectRatio);
+        reader.setScaledSize(scaledSize);
+
+        //! edge strips must cover the same image area as in full size
+        thickness = qMax(1, qRound((float)EDGETHICKNESS * scaledSize.width() / imageSize.width()));
+    }
+
+    QImage image = toRgbImage(reader.read());
+
+    for (const auto location : locations) {
+        //! invalid images are also cached with the default hints in order to not be decoded again
+        hints.insert(location, image.format() != QImage::Format_Invalid ? edgeHints(image, location, thickness) : imageHints());
+    }
+
+    return hints;
+}
+
+QByteArray BackgroundCache::contentHash(const QString &imageFile)
+{
+    QFile file(imageFile);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    //! hashing only the beginning and the ending of the file is enough to identify
+    //! replaced images with the same size and modification time and it is much
+    //! cheaper than reading big wallpapers entirely
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(file.read(HASHEDBYTES));
+
+    if (file.size() > HASHEDBYTES) {
+        file.seek(qMax((qint64)HASHEDBYTES, file.size() - HASHEDBYTES));
+        hash.addData(file.read(HASHEDBYTES));
+    }
+
+    return hash.result();
+}
+
+//! runs in a worker thread, the stored hints are used when the image file did not change
+imageRecord BackgroundCache::imageCalculations(const QString &imageFile, const imageRecord &stored)
+{
+    QFileInfo info(imageFile);
+
+    imageRecord record;
+    record.modified = info.lastModified().toMSecsSinceEpoch();
+    record.size = info.size();
+    record.hash = contentHash(imageFile);
+
+    if (!stored.hints.isEmpty()
+            && stored.modified == record.modified
+            && stored.size == record.size
+            && stored.hash == record.hash) {
+        record.hints = stored.hints;
+    } else {
+        record.hints = edgesCalculations(imageFile);
+    }
+
+    return record;
+}
+
+void BackgroundCache::updateImageCalculations(QString imageFile)
+{
+    if (m_pendingCalculations.contains(imageFile)) {
+        return;
+    }
+
+    auto watcher = new QFutureWatcher<imageRecord>(this);
+    m_pendingCalculations[imageFile] = watcher;
+
+    connect(watcher, &QFutureWatcher<imageRecord>::finished, this, [&, watcher, imageFile]() {
+        m_pendingCalculations.remove(imageFile);
+        m_storedHints.remove(imageFile);
+
+        m_hintsCache[imageFile] = watcher->result();
+        touchHints(imageFile);
+        cleanupHashes();
+
+        watcher->deleteLater();
+
+        if (!m_saveHintsTimer.isActive()) {
+            m_saveHintsTimer.start();
         }
+
+        emit hintsChanged(imageFile);
+    });
+
+    const imageRecord stored = m_storedHints.value(imageFile);
+
+    watcher->setFuture(QtConcurrent::run(&m_workers, [imageFile, stored]() {
+        return BackgroundCache::imageCalculations(imageFile, stored);
+    }));
+}
+
+bool BackgroundCache::hintsArePendingFor(QString activity, QString screen) const
+{
+    return m_pendingCalculations.contains(background(activity, screen));
+}
+
+float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Location location)
+{
+    if (m_hintsCache.contains(imageFile) && m_hintsCache[imageFile].hints.contains(location)) {
+        touchHints(imageFile);
+        return m_hintsCache[imageFile].hints[location].brightness;
     }
 
     //! if it is a color
@@ -393,21 +659,17 @@ float BackgroundCache::brightnessForFile(QString imageFile, Plasma::Types::Locat
         return Latte::colorBrightness(QColor(imageFile));
     }
 
-    updateImageCalculations(imageFile, location);
-
-    if (m_hintsCache.keys().contains(imageFile)) {
-        return m_hintsCache[imageFile][location].brightness;
-    }
+    //! the real value is provided through hintsChanged signal
+    updateImageCalculations(imageFile);
 
     return -1000;
 }
 
 bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location location)
 {
-    if (m_hintsCache.keys().contains(imageFile)) {
-        if (m_hintsCache[imageFile].keys().contains(location)) {
-            return m_hintsCache[imageFile][location].busy;
-        }
+    if (m_hintsCache.contains(imageFile) && m_hintsCache[imageFile].hints.contains(location)) {
+        touchHints(imageFile);
+        return m_hintsCache[imageFile].hints[location].busy;
     }
 
     //! if it is a color
@@ -415,22 +677,118 @@ bool BackgroundCache::busyForFile(QString imageFile, Plasma::Types::Location loc
         return false;
     }
 
-    updateImageCalculations(imageFile, location);
+    //! the real value is provided through hintsChanged signal
+    updateImageCalculations(imageFile);
+
+    return false;
+}
 
-    if (m_hintsCache.keys().contains(imageFile)) {
-        return m_hintsCache[imageFile][location].busy;
+void BackgroundCache::touchHints(const QString &imageFile)
+{
+    if (!m_hintsUsage.isEmpty() && m_hintsUsage.last() == imageFile) {
+        return;
     }
 
-    return false;
+    m_hintsUsage.removeOne(imageFile);
+    m_hintsUsage.append(imageFile);
 }
 
 void BackgroundCache::cleanupHashes()
 {
-    if (m_hintsCache.count() <= MAXHASHSIZE) {
+    //! least recently used images are released first
+    while (m_hintsCache.count() > MAXHASHSIZE && !m_hintsUsage.isEmpty()) {
+        m_hintsCache.remove(m_hintsUsage.takeFirst());
+    }
+}
+
+QString BackgroundCache::hintsFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + HINTSFILE;
+}
+
+void BackgroundCache::loadHints()
+{
+    QFile file(hintsFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
         return;
     }
 
-    m_hintsCache.clear();
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 version;
+    quint32 count;
+    stream >> version >> count;
+
+    if (version != HINTSFILEVERSION) {
+        return;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString imageFile;
+        imageRecord record;
+        quint32 edges;
+
+        stream >> imageFile >> record.modified >> record.size >> record.hash >> edges;
+
+        for (quint32 j = 0; j < edges && stream.status() == QDataStream::Ok; ++j) {
+            qint32 location;
+            imageHints iHints;
+            stream >> location >> iHints.busy >> iHints.brightness;
+            record.hints.insert(static_cast<Plasma::Types::Location>(location), iHints);
+        }
+
+        if (stream.status() == QDataStream::Ok) {
+            m_storedHints[imageFile] = record;
+        }
+    }
+
+    qDebug() << "Background hints loaded for images :: " << m_storedHints.count();
+}
+
+void BackgroundCache::saveHints()
+{
+    //! most recently used images first, afterwards images that were not used during this session
+    QList<QString> imageFiles;
+
+    for (int i = m_hintsUsage.count() - 1; i >= 0; --i) {
+        imageFiles << m_hintsUsage[i];
+    }
+
+    for (const auto &imageFile : m_storedHints.keys()) {
+        if (imageFiles.count() >= MAXHASHSIZE) {
+            break;
+        }
+
+        if (!m_hintsCache.contains(imageFile)) {
+            imageFiles << imageFile;
+        }
+    }
+
+    QDir().mkpath(QFileInfo(hintsFilePath()).absolutePath());
+
+    QSaveFile file(hintsFilePath());
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << quint32(HINTSFILEVERSION) << quint32(imageFiles.count());
+
+    for (const auto &imageFile : imageFiles) {
+        const imageRecord &record = m_hintsCache.contains(imageFile) ? m_hintsCache[imageFile] : m_storedHints[imageFile];
+
+        stream << imageFile << record.modified << record.size << record.hash << quint32(record.hints.count());
+
+        for (auto edge = record.hints.constBegin(); edge != record.hints.constEnd(); ++edge) {
+            stream << qint32(edge.key()) << edge.value().busy << edge.value().brightness;
+        }
+    }
+
+    file.commit();
 }
 
 void BackgroundCache::setBackgroundFromBroadcast(QString activity, QString screen, QString filename)
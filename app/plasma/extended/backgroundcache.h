@@ -24,8 +24,12 @@
 #include "screenpool.h"
 
 // Qt
+#include <QFutureWatcher>
 #include <QHash>
+#include <QImage>
 #include <QObject>
+#include <QThreadPool>
+#include <QTimer>
 
 // Plasma
 #include <Plasma>
@@ -41,6 +45,14 @@ struct imageHints {
 
 typedef QHash<Plasma::Types::Location, imageHints> EdgesHash;
 
+//! image file state for which the edges hints were calculated
+struct imageRecord {
+    qint64 modified{0};
+    qint64 size{0};
+    QByteArray hash;
+    EdgesHash hints;
+};
+
 namespace Latte {
 namespace PlasmaExtended {
 
@@ -57,14 +69,19 @@ public:
 
     QString background(QString activity, QString screen) const;
 
+    //! background calculations are running and the hints provided are not the real ones yet
+    bool hintsArePendingFor(QString activity, QString screen) const;
+
     void setBackgroundFromBroadcast(QString activity, QString screen, QString filename);
     void setBroadcastedBackgroundsEnabled(QString activity, QString screen, bool enabled);
 
 signals:
     void backgroundChanged(const QString &activity, const QString &screenName);
+    void hintsChanged(const QString &imageFile);
 
 private slots:
     void reload();
+    void reloadChangedContainments();
     void settingsFileChanged(const QString &file);
 
 private:
@@ -72,16 +89,34 @@ private:
 
     bool backgroundIsBroadcasted(QString activity, QString screenName) const;
     bool pluginExistsFor(QString activity, QString screenName) const;
-    bool areaIsBusy(float bright1, float bright2) const;
     bool busyForFile(QString imageFile, Plasma::Types::Location location);
     bool isDesktopContainment(const KConfigGroup &containment) const;
 
     float brightnessForFile(QString imageFile, Plasma::Types::Location location);
-    float brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn);
     QString backgroundFromConfig(const KConfigGroup &config, QString wallpaperPlugin) const;
 
+    void reload(const QStringList &containmentIds);
+
+    //! containment id and hash of its relevant settings as found in the plasma config file
+    QHash<QString, QByteArray> containmentsSignatures() const;
+    static QString plasmaConfigFilePath();
+
     void cleanupHashes();
-    void updateImageCalculations(QString imageFile, Plasma::Types::Location location);
+    void touchHints(const QString &imageFile);
+    void updateImageCalculations(QString imageFile);
+
+    void loadHints();
+    void saveHints();
+
+    //! thread safe calculations used from the workers
+    static bool areaIsBusy(float bright1, float bright2);
+    static float brightnessFromArea(QImage &image, int firstRow, int firstColumn, int endRow, int endColumn);
+    static imageHints edgeHints(QImage &image, Plasma::Types::Location location, int thickness);
+    static EdgesHash edgesCalculations(const QString &imageFile);
+    static imageRecord imageCalculations(const QString &imageFile, const imageRecord &stored);
+    static QByteArray contentHash(const QString &imageFile);
+    static QString hintsFilePath();
+    static QImage toRgbImage(const QImage &image);
 
 private:
     bool m_initialized{false};
@@ -100,8 +135,22 @@ private:
     //! and have higher priority: activity id, screen names
     QHash<QString, QList<QString>> m_broadcasted;
 
-    //! image file and brightness per edge
-    QHash<QString, EdgesHash> m_hintsCache;
+    //! image file and brightness per edge, validated during this session
+    QHash<QString, imageRecord> m_hintsCache;
+    //! least recently used image files first
+    QList<QString> m_hintsUsage;
+
+    //! image file and brightness per edge loaded from disk, they are
+    //! validated against the image files before they are used
+    QHash<QString, imageRecord> m_storedHints;
+    QTimer m_saveHintsTimer;
+
+    QHash<QString, QByteArray> m_containmentsSignatures;
+    QTimer m_reloadTimer;
+
+    //! image files whose calculations are running in workers
+    QHash<QString, QFutureWatcher<imageRecord> *> m_pendingCalculations;
+    QThreadPool m_workers;
 
     KSharedConfig::Ptr m_plasmaConfig;
 };
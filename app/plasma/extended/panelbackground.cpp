@@ -22,6 +22,7 @@
 
 // local
 #include "theme.h"
+#include "../../tools/alphakernel.h"
 
 // Qt
 #include <QDebug>
@@ -95,6 +96,40 @@ QColor PanelBackground::shadowColor() const
     return m_shadowColor;
 }
 
+void PanelBackground::saveMetrics(QDataStream &out) const
+{
+    out << qint32(m_paddingTop) << qint32(m_paddingLeft) << qint32(m_paddingBottom) << qint32(m_paddingRight)
+        << qint32(m_shadowSize) << qint32(m_roundness) << m_maxOpacity << m_shadowColor;
+}
+
+void PanelBackground::loadMetrics(QDataStream &in)
+{
+    qint32 paddingTop, paddingLeft, paddingBottom, paddingRight, shadowSize, roundness;
+    float maxOpacity;
+    QColor shadowColor;
+
+    in >> paddingTop >> paddingLeft >> paddingBottom >> paddingRight >> shadowSize >> roundness >> maxOpacity >> shadowColor;
+
+    if (in.status() != QDataStream::Ok) {
+        return;
+    }
+
+    m_paddingTop = paddingTop;
+    m_paddingLeft = paddingLeft;
+    m_paddingBottom = paddingBottom;
+    m_paddingRight = paddingRight;
+    m_shadowSize = shadowSize;
+    m_roundness = roundness;
+    m_maxOpacity = maxOpacity;
+    m_shadowColor = shadowColor;
+
+    emit maxOpacityChanged();
+    emit paddingsChanged();
+    emit roundnessChanged();
+    emit shadowSizeChanged();
+    emit shadowColorChanged();
+}
+
 QString PanelBackground::prefixed(const QString &id)
 {
     if (m_location == Plasma::Types::TopEdge) {
@@ -135,20 +170,16 @@ void PanelBackground::updateMaxOpacity(Plasma::Svg *svg)
 
     QImage center = svg->image(QSize(CENTERWIDTH, CENTERHEIGHT), element(svg, "center"));
 
-    float alphasum{0};
+    quint64 alphasum{0};
 
     //! calculating the mid opacity (this is needed in order to handle Oxygen
     //! that has different opacity levels in the same center element)
     for (int row=0; row<2; ++row) {
-        QRgb *line = (QRgb *)center.scanLine(row);
-
-        for (int col=0; col<CENTERWIDTH; ++col) {
-            QRgb pixelData = line[col];
-            alphasum += ((float)qAlpha(pixelData)/(float)255);
-        }
+        const QRgb *line = (const QRgb *)center.constScanLine(row);
+        alphasum += alphaSum(line, CENTERWIDTH);
     }
 
-    m_maxOpacity = alphasum / (float)(2 * CENTERWIDTH);
+    m_maxOpacity = ((float)alphasum/(float)255) / (float)(2 * CENTERWIDTH);
 
     emit maxOpacityChanged();
 }
@@ -624,15 +655,23 @@ void PanelBackground::updateShadow(Plasma::Svg *svg)
     int maxopacity{0};
 
     for (int r=0; r<border.height(); ++r) {
-        QRgb *line = (QRgb *)border.scanLine(r);
+        const QRgb *line = (const QRgb *)border.constScanLine(r);
+        int rowMaxOpacity = alphaMax(line, border.width());
+
+        if (rowMaxOpacity <= maxopacity) {
+            continue;
+        }
 
+        maxopacity = rowMaxOpacity;
+
+        //! the first pixel of the row with that opacity provides the shadow color
         for(int c = 0; c<border.width(); ++c) {
             QRgb pixel = line[c];
 
-            if (qAlpha(pixel) > maxopacity) {
-                maxopacity = qAlpha(pixel);
+            if (qAlpha(pixel) == maxopacity) {
                 m_shadowColor = QColor(pixel);
                 m_shadowColor.setAlpha(qMin(255, maxopacity));
+                break;
             }
         }
     }
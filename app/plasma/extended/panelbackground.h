@@ -22,6 +22,7 @@
 #define PLASMATHEMEEXTENDEDPANELBACKGROUND_H
 
 // Qt
+#include <QDataStream>
 #include <QObject>
 
 // Plasma
@@ -68,6 +69,11 @@ public:
 
     QColor shadowColor() const;
 
+    //! metrics are cached in order to restore them without rendering
+    //! the plasma theme svg elements
+    void saveMetrics(QDataStream &out) const;
+    void loadMetrics(QDataStream &in);
+
 public slots:
     void update();
 
@@ -31,12 +31,16 @@
 // Qt
 #include <QDebug>
 #include <QDir>
+#include <QGuiApplication>
 #include <QPainter>
 #include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 // KDE
 #include <KDirWatch>
 #include <KConfigGroup>
+#include <KPluginMetaData>
 #include <KSharedConfig>
 
 // X11
@@ -45,6 +49,11 @@
 #define DEFAULTCOLORSCHEME "default.colors"
 #define REVERSEDCOLORSCHEME "reversed.colors"
 
+//! panel backgrounds metrics are shared between all latte instances through that file
+#define BACKGROUNDSFILE "lattedock/panelbackgrounds"
+#define BACKGROUNDSFILEVERSION 1
+#define MAXCACHEDTHEMES 10
+
 namespace Latte {
 namespace PlasmaExtended {
 
@@ -310,12 +319,180 @@ void Theme::updateReversedSchemeValues()
 
 void Theme::updateBackgrounds()
 {
+    const QString key = backgroundsCacheKey();
+
+    if (!key.isEmpty() && loadCachedBackgrounds(key)) {
+        qDebug() << "PLASMA THEME, panel backgrounds restored from cache ::: " << key;
+        return;
+    }
+
     updateHasShadow();
 
     m_backgroundTopEdge->update();
     m_backgroundLeftEdge->update();
     m_backgroundBottomEdge->update();
     m_backgroundRightEdge->update();
+
+    if (!key.isEmpty()) {
+        saveCachedBackgrounds(key);
+    }
+}
+
+QString Theme::themeVersion() const
+{
+    QString metadataFile = m_themePath + "/metadata.json";
+
+    if (QFileInfo(metadataFile).exists()) {
+        return KPluginMetaData(metadataFile).version();
+    }
+
+    metadataFile = m_themePath + "/metadata.desktop";
+
+    if (QFileInfo(metadataFile).exists()) {
+        return KPluginMetaData::fromDesktopFile(metadataFile).version();
+    }
+
+    return QString();
+}
+
+QString Theme::backgroundsCacheKey() const
+{
+    //! the svg file that is actually used, it is different for opaque and translucent themes
+    const QString svgFile = m_theme.imagePath(QStringLiteral("widgets/panel-background"));
+
+    if (svgFile.isEmpty()) {
+        return QString();
+    }
+
+    QStringList keyParts;
+    keyParts << m_theme.themeName()
+             << themeVersion()
+             << svgFile
+             << QString::number(QFileInfo(svgFile).lastModified().toMSecsSinceEpoch())
+             << QString::number(qGuiApp->devicePixelRatio())
+             << (m_compositing ? "compositing" : "nocompositing");
+
+    return keyParts.join('|');
+}
+
+QString Theme::backgroundsCacheFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1Char('/') + BACKGROUNDSFILE;
+}
+
+bool Theme::loadCachedBackgrounds(const QString &key)
+{
+    QFile file(backgroundsCacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 version;
+    quint32 count;
+    stream >> version >> count;
+
+    if (version != BACKGROUNDSFILEVERSION) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString themeKey;
+        QByteArray metrics;
+        stream >> themeKey >> metrics;
+
+        if (themeKey != key || stream.status() != QDataStream::Ok) {
+            continue;
+        }
+
+        QDataStream metricsStream(metrics);
+        metricsStream.setVersion(QDataStream::Qt_5_9);
+
+        bool hasShadow;
+        metricsStream >> hasShadow;
+
+        if (metricsStream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        m_hasShadow = hasShadow;
+        emit hasShadowChanged();
+
+        m_backgroundTopEdge->loadMetrics(metricsStream);
+        m_backgroundLeftEdge->loadMetrics(metricsStream);
+        m_backgroundBottomEdge->loadMetrics(metricsStream);
+        m_backgroundRightEdge->loadMetrics(metricsStream);
+
+        return metricsStream.status() == QDataStream::Ok;
+    }
+
+    return false;
+}
+
+void Theme::saveCachedBackgrounds(const QString &key)
+{
+    QByteArray metrics;
+    QDataStream metricsStream(&metrics, QIODevice::WriteOnly);
+    metricsStream.setVersion(QDataStream::Qt_5_9);
+
+    metricsStream << m_hasShadow;
+    m_backgroundTopEdge->saveMetrics(metricsStream);
+    m_backgroundLeftEdge->saveMetrics(metricsStream);
+    m_backgroundBottomEdge->saveMetrics(metricsStream);
+    m_backgroundRightEdge->saveMetrics(metricsStream);
+
+    //! other latte instances may have stored their themes meanwhile, the current
+    //! theme is placed first and the least recently used themes are dropped
+    QList<QPair<QString, QByteArray>> entries;
+    entries << qMakePair(key, metrics);
+
+    QFile storedFile(backgroundsCacheFilePath());
+
+    if (storedFile.open(QIODevice::ReadOnly)) {
+        QDataStream stored(&storedFile);
+        stored.setVersion(QDataStream::Qt_5_9);
+
+        quint32 version;
+        quint32 count;
+        stored >> version >> count;
+
+        for (quint32 i = 0; version == BACKGROUNDSFILEVERSION && i < count && entries.count() < MAXCACHEDTHEMES; ++i) {
+            QString themeKey;
+            QByteArray themeMetrics;
+            stored >> themeKey >> themeMetrics;
+
+            if (stored.status() != QDataStream::Ok) {
+                break;
+            }
+
+            if (themeKey != key) {
+                entries << qMakePair(themeKey, themeMetrics);
+            }
+        }
+
+        storedFile.close();
+    }
+
+    QDir().mkpath(QFileInfo(backgroundsCacheFilePath()).absolutePath());
+
+    QSaveFile file(backgroundsCacheFilePath());
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << quint32(BACKGROUNDSFILEVERSION) << quint32(entries.count());
+
+    for (const auto &entry : entries) {
+        stream << entry.first << entry.second;
+    }
+
+    file.commit();
 }
 
 void Theme::updateHasShadow()
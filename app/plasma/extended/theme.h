@@ -119,6 +119,9 @@ private:
     void loadCompositingRoundness();
     void updateBackgrounds();
 
+    bool loadCachedBackgrounds(const QString &key);
+    void saveCachedBackgrounds(const QString &key);
+
     void setOriginalSchemeFile(const QString &file);
     void updateHasShadow();
     void updateDefaultScheme();
@@ -128,6 +131,11 @@ private:
 
     void qmlRegisterTypes();
 
+    QString backgroundsCacheKey() const;
+    QString themeVersion() const;
+
+    static QString backgroundsCacheFilePath();
+
 private:
     bool m_hasShadow{false};
     bool m_isLightTheme{false};
@@ -37,16 +37,19 @@
 #include "../../layout/sharedlayout.h"
 #include "../../layouts/importer.h"
 #include "../../layouts/manager.h"
+#include "../../layouts/metadataindex.h"
 #include "../../layouts/synchronizer.h"
 
 // Qt
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QHeaderView>
 #include <QItemSelection>
 #include <QStringList>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
+#include <QtConcurrent>
 
 // KDE
 #include <KArchive/KTar>
@@ -65,7 +68,9 @@ Layouts::Layouts(Settings::Handler::TabLayouts *parent)
       m_proxyModel(new QSortFilterProxyModel(this)),
       m_view(m_handler->ui()->layoutsView),
       m_headerView(new Settings::Layouts::HeaderView(Qt::Horizontal, m_handler->dialog())),
-      m_storage(KConfigGroup(KSharedConfig::openConfig(),"LatteSettingsDialog").group("TabLayouts"))
+      m_storage(KConfigGroup(KSharedConfig::openConfig(),"LatteSettingsDialog").group("TabLayouts")),
+      m_metadataIndex(Latte::Layouts::Importer::layoutUserDir()),
+      m_metadataWatcher(new QFutureWatcher<QList<Latte::Layouts::LayoutMetadata>>(this))
 {   
     loadConfig();
     m_proxyModel->setSourceModel(m_model);
@@ -78,6 +83,8 @@ Layouts::Layouts(Settings::Handler::TabLayouts *parent)
 
     connect(m_model, &Model::Layouts::nameDuplicated, this, &Layouts::onNameDuplicatedFrom);
 
+    connect(m_metadataWatcher, &QFutureWatcher<QList<Latte::Layouts::LayoutMetadata>>::finished, this, &Layouts::onMetadataReparsed);
+
     connect(m_headerView, &QObject::destroyed, this, [&]() {
         m_viewSortColumn = m_headerView->sortIndicatorSection();
         m_viewSortOrder = m_headerView->sortIndicatorOrder();
@@ -400,28 +407,67 @@ void Layouts::loadLayouts()
 
     Latte::Data::LayoutsTable layoutsBuffer;
 
+    m_metadataIndex.load();
+
+    QStringList layoutFiles;
+    QStringList outdatedFiles;
+
     for (const auto layout : m_handler->corona()->layoutsManager()->layouts()) {
         Latte::Data::Layout original;
         original.id = Latte::Layouts::Importer::layoutUserFilePath(layout);
+        layoutFiles << original.id;
+
+        Latte::Layout::GenericLayout *generic = m_handler->corona()->layoutsManager()->synchronizer()->layout(layout);
+        CentralLayout *centralActive = m_handler->corona()->layoutsManager()->synchronizer()->centralLayout(layout);
+
+        QString shared;
+
+        if (centralActive) {
+            //! active layouts provide their current data directly
+            original.name = centralActive->name();
+            original.icon = centralActive->icon();
+            original.backgroundStyle = centralActive->backgroundStyle();
+            original.color = centralActive->color();
+            original.background = centralActive->customBackground();
+            original.textColor = centralActive->customTextColor();
+            original.isShownInMenu = centralActive->showInMenu();
+            original.hasDisabledBorders = centralActive->disableBordersForMaximizedWindows();
+            original.activities = centralActive->activities();
+            shared = centralActive->sharedLayoutName();
+        } else {
+            //! layout files without any record are parsed immediately, outdated records
+            //! are shown read only until their layout files are parsed again
+            if (!m_metadataIndex.contains(original.id)) {
+                m_metadataIndex.insert(original.id, Latte::Layouts::MetadataIndex::readLayoutFile(original.id));
+            } else if (!m_metadataIndex.isUpToDate(original.id) && !m_metadataReparsed) {
+                outdatedFiles << original.id;
+            }
+
+            Latte::Layouts::LayoutMetadata metadata = m_metadataIndex.metadata(original.id);
 
-        CentralLayout *central = new CentralLayout(this, original.id);
+            original.name = metadata.layout.name;
+            original.icon = metadata.layout.icon;
+            original.backgroundStyle = metadata.layout.backgroundStyle;
+            original.color = metadata.layout.color;
+            original.background = metadata.layout.background;
+            original.textColor = metadata.layout.textColor;
+            original.isShownInMenu = metadata.layout.isShownInMenu;
+            original.hasDisabledBorders = metadata.layout.hasDisabledBorders;
+            original.activities = metadata.layout.activities;
 
-        original.name = central->name();
-        original.icon = central->icon();
-        original.backgroundStyle = central->backgroundStyle();
-        original.color = central->color();
-        original.background = central->customBackground();
-        original.textColor = central->customTextColor();
-        original.isActive = (m_handler->corona()->layoutsManager()->synchronizer()->layout(original.name) != nullptr);
-        original.isLocked = !central->isWritable();
-        original.isShownInMenu = central->showInMenu();
-        original.hasDisabledBorders = central->disableBordersForMaximizedWindows();
-        original.activities = central->activities();
+            if (Latte::Layouts::Importer::layoutExists(metadata.sharedLayoutName)) {
+                shared = metadata.sharedLayoutName;
+            }
+
+            if (!generic && metadata.isBroken && !outdatedFiles.contains(original.id)) {
+                brokenLayouts.append(original.name);
+            }
+        }
 
-        m_layouts[original.id] = central;
+        original.isActive = (generic != nullptr);
+        original.isLocked = !QFileInfo(original.id).isWritable();
 
         //! create initial SHARES maps
-        QString shared = central->sharedLayoutName();
         if (!shared.isEmpty()) {
             sharesMap[shared].append(original.id);
         }
@@ -432,13 +478,28 @@ void Layouts::loadLayouts()
 
         i++;
 
-        Latte::Layout::GenericLayout *generic = m_handler->corona()->layoutsManager()->synchronizer()->layout(central->name());
-
-        if ((generic && generic->isBroken()) || (!generic && central->isBroken())) {
-            brokenLayouts.append(central->name());
+        if (generic && generic->isBroken()) {
+            brokenLayouts.append(original.name);
         }
     }
 
+    m_metadataIndex.retain(layoutFiles);
+    m_metadataIndex.save();
+    m_metadataReparsed = false;
+
+    //! parse only the layout files that changed since their last indexing
+    if (!outdatedFiles.isEmpty() && !m_metadataWatcher->isRunning()) {
+        m_metadataWatcher->setFuture(QtConcurrent::run([outdatedFiles]() {
+            QList<Latte::Layouts::LayoutMetadata> metadata;
+
+            for (const auto &file : outdatedFiles) {
+                metadata << Latte::Layouts::MetadataIndex::readLayoutFile(file);
+            }
+
+            return metadata;
+        }));
+    }
+
     //! update SHARES map keys in order to use the #settingsid(s)
     QStringList tempSharedNames;
 
@@ -468,6 +529,8 @@ void Layouts::loadLayouts()
 
     //! Send original loaded data to model
     m_model->setOriginalData(layoutsBuffer, inMultiple);
+    m_model->setReadOnlyLayouts(m_metadataWatcher->isRunning() ? outdatedFiles : QStringList());
+    m_outdatedLayouts = outdatedFiles;
     m_model->setOriginalLayoutForFreeActivities(layoutsBuffer.idForName(m_handler->corona()->universalSettings()->lastNonAssignedLayoutName()));
 
     m_view->selectRow(rowForName(m_handler->corona()->layoutsManager()->currentLayoutName()));
@@ -509,6 +572,75 @@ void Layouts::loadLayouts()
     }
 }
 
+CentralLayout *Layouts::centralLayout(const QString &id)
+{
+    //! layouts are created only when they are going to be updated
+    if (!m_layouts.contains(id)) {
+        m_layouts[id] = new CentralLayout(this, id);
+    }
+
+    return m_layouts[id];
+}
+
+Latte::Data::Layout Layouts::mergedWithLayoutFile(const Latte::Data::Layout &current, const Latte::Data::Layout &original) const
+{
+    //! outdated layouts are shown with older metadata, only the properties that were
+    //! changed are applied and all the others are taken from the layout file
+    Latte::Data::Layout merged = current;
+    Latte::Layouts::LayoutMetadata file = Latte::Layouts::MetadataIndex::readLayoutFile(current.id);
+
+    if (current.icon == original.icon) {
+        merged.icon = file.layout.icon;
+    }
+
+    if (current.backgroundStyle == original.backgroundStyle
+            && current.color == original.color
+            && current.background == original.background
+            && current.textColor == original.textColor) {
+        merged.backgroundStyle = file.layout.backgroundStyle;
+        merged.color = file.layout.color;
+        merged.background = file.layout.background;
+        merged.textColor = file.layout.textColor;
+    }
+
+    if (current.isShownInMenu == original.isShownInMenu) {
+        merged.isShownInMenu = file.layout.isShownInMenu;
+    }
+
+    if (current.hasDisabledBorders == original.hasDisabledBorders) {
+        merged.hasDisabledBorders = file.layout.hasDisabledBorders;
+    }
+
+    if (current.activities == original.activities) {
+        merged.activities = file.layout.activities;
+    }
+
+    return merged;
+}
+
+void Layouts::onMetadataReparsed()
+{
+    for (const auto &metadata : m_metadataWatcher->result()) {
+        m_metadataIndex.insert(metadata.layout.id, metadata);
+    }
+
+    m_metadataIndex.save();
+    m_model->setReadOnlyLayouts(QStringList());
+
+    //! user changes must not be lost, new metadata are shown next time and
+    //! until then the outdated layouts are merged with their files when saved
+    if (!m_model->dataAreChanged()) {
+        QString selectedId = m_view->currentIndex().isValid() ? selectedLayoutCurrentData().id : QString();
+
+        m_metadataReparsed = true;
+        loadLayouts();
+
+        if (!selectedId.isEmpty()) {
+            m_view->selectRow(rowForId(selectedId));
+        }
+    }
+}
+
 const Latte::Data::Layout Layouts::addLayoutForFile(QString file, QString layoutName, bool newTempDirectory)
 {
     if (layoutName.isEmpty()) {
@@ -731,6 +863,10 @@ void Layouts::save()
         Latte::Data::Layout iLayoutOriginalData = m_model->originalData(iLayoutCurrentData.id);
         iLayoutOriginalData = iLayoutOriginalData.isEmpty() ? iLayoutCurrentData : iLayoutOriginalData;
 
+        if (m_outdatedLayouts.contains(iLayoutCurrentData.id)) {
+            iLayoutCurrentData = mergedWithLayoutFile(iLayoutCurrentData, iLayoutOriginalData);
+        }
+
         QStringList cleanedActivities;
 
         //!update only activities that are valid
@@ -744,7 +880,7 @@ void Layouts::save()
         //! update the generic parts of the layouts
         bool isOriginalLayout = m_model->originalLayoutsData().containsId(iLayoutCurrentData.id);
         Latte::Layout::GenericLayout *genericActive= isOriginalLayout ? m_handler->corona()->layoutsManager()->synchronizer()->layout(iLayoutOriginalData.name) : nullptr;
-        Latte::Layout::GenericLayout *generic = genericActive ? genericActive : m_layouts[iLayoutCurrentData.id];
+        Latte::Layout::GenericLayout *generic = genericActive ? genericActive : centralLayout(iLayoutCurrentData.id);
 
         //! unlock read-only layout
         if (!generic->isWritable()) {
@@ -762,7 +898,7 @@ void Layouts::save()
 
         //! update only the Central-specific layout parts
         CentralLayout *centralActive = isOriginalLayout ? m_handler->corona()->layoutsManager()->synchronizer()->centralLayout(iLayoutOriginalData.name) : nullptr;
-        CentralLayout *central = centralActive ? centralActive : m_layouts[iLayoutCurrentData.id];       
+        CentralLayout *central = centralActive ? centralActive : centralLayout(iLayoutCurrentData.id);
 
         central->setShowInMenu(iLayoutCurrentData.isShownInMenu);
         central->setDisableBordersForMaximizedWindows(iLayoutCurrentData.hasDisabledBorders);
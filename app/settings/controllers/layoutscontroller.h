@@ -28,9 +28,11 @@
 #include "../../lattecorona.h"
 #include "../../data/layoutdata.h"
 #include "../../data/layoutstable.h"
+#include "../../layouts/metadataindex.h"
 
 // Qt
 #include <QAbstractItemModel>
+#include <QFutureWatcher>
 #include <QHash>
 #include <QSortFilterProxyModel>
 #include <QTableView>
@@ -112,12 +114,16 @@ private slots:
     void updateLastColumnWidth();
 
     void onNameDuplicatedFrom(const QString &provenId,  const QString &trialId);
+    void onMetadataReparsed();
 
 private:
     void initView();
     void syncActiveShares();
 
     int rowForId(QString id) const;
+
+    CentralLayout *centralLayout(const QString &id);
+    Latte::Data::Layout mergedWithLayoutFile(const Latte::Data::Layout &current, const Latte::Data::Layout &original) const;
     int rowForName(QString layoutName) const;
 
     QString uniqueTempDirectory();
@@ -143,6 +149,13 @@ private:
     QSortFilterProxyModel *m_proxyModel{nullptr};
     QHash<const QString, Latte::CentralLayout *> m_layouts;
 
+    //! layouts metadata without parsing the layouts files
+    bool m_metadataReparsed{false};
+    //! layouts that are shown from outdated metadata
+    QStringList m_outdatedLayouts;
+    Latte::Layouts::MetadataIndex m_metadataIndex;
+    QFutureWatcher<QList<Latte::Layouts::LayoutMetadata>> *m_metadataWatcher{nullptr};
+
     //! temp data
     QStringList m_tempDirectories;
 };
@@ -167,6 +167,10 @@ void Layouts::removeLayout(const QString &id)
 
 void Layouts::setLayoutProperties(const Latte::Data::Layout &layout)
 {
+    if (isReadOnly(layout.id)) {
+        return;
+    }
+
     if (m_layoutsTable.containsId(layout.id) && m_layoutsTable[layout.id] != layout) {
         m_layoutsTable[layout.id] = layout;
         int dataRow = m_layoutsTable.indexOf(layout.id);
@@ -178,6 +182,28 @@ void Layouts::setLayoutProperties(const Latte::Data::Layout &layout)
     }
 }
 
+bool Layouts::isReadOnly(const QString &id) const
+{
+    return m_readOnlyLayouts.contains(id);
+}
+
+void Layouts::setReadOnlyLayouts(const QStringList &ids)
+{
+    if (m_readOnlyLayouts == ids) {
+        return;
+    }
+
+    m_readOnlyLayouts = ids;
+
+    if (m_layoutsTable.rowCount() > 0) {
+        QVector<int> roles;
+        roles << Qt::DisplayRole;
+        roles << Qt::UserRole;
+
+        emit dataChanged(index(0, IDCOLUMN), index(m_layoutsTable.rowCount() - 1, SHAREDCOLUMN), roles);
+    }
+}
+
 bool Layouts::removeRows(int row, int count, const QModelIndex &parent)
 {
     Q_UNUSED(parent)
@@ -355,6 +381,10 @@ Qt::ItemFlags Layouts::flags(const QModelIndex &index) const
 
     auto flags = QAbstractTableModel::flags(index);
 
+    if (m_layoutsTable.rowExists(row) && isReadOnly(m_layoutsTable[row].id)) {
+        return flags;
+    }
+
     if (column == MENUCOLUMN || column == BORDERSCOLUMN) {
         flags |= Qt::ItemIsUserCheckable;
     }
@@ -900,6 +930,11 @@ bool Layouts::setData(const QModelIndex &index, const QVariant &value, int role)
         return false;
     }
 
+    //! read only layouts accept only the id updates after saving
+    if (isReadOnly(m_layoutsTable[row].id) && column != IDCOLUMN) {
+        return false;
+    }
+
     QVector<int> roles;
     roles << role;
 
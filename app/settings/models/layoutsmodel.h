@@ -123,6 +123,11 @@ public:
     void removeLayout(const QString &id);
     void setLayoutProperties(const Latte::Data::Layout &layout);
 
+    //! read only layouts can not be edited by the user, e.g. when their
+    //! shown data are outdated and are going to be updated
+    bool isReadOnly(const QString &id) const;
+    void setReadOnlyLayouts(const QStringList &ids);
+
     QString layoutNameForFreeActivities() const;
     void setCurrentLayoutForFreeActivities(const QString &id);
     void setOriginalLayoutForFreeActivities(const QString &id);
@@ -181,6 +186,8 @@ private:
 
     QString m_iconsPath;
 
+    QStringList m_readOnlyLayouts;
+
     Latte::Data::ActivitiesMap m_activitiesMap;
     QHash<QString, KActivities::Info *> m_activitiesInfo;
 
@@ -106,6 +106,9 @@ public:
     int screenTrackerInterval() const;
     void setScreenTrackerInterval(int duration);
 
+    int preloadedLayouts() const;
+    void setPreloadedLayouts(int count);
+
     QString currentLayoutName() const;
     void setCurrentLayoutName(QString layoutName);
 
@@ -147,6 +150,7 @@ signals:
     void launchersChanged();
     void layoutsMemoryUsageChanged();
     void metaPressAndHoldEnabledChanged();
+    void preloadedLayoutsChanged();
     void sensitivityChanged();
     void screensCountChanged();
     void screenScalesChanged();
@@ -189,6 +193,10 @@ private:
 
     int m_screenTrackerInterval{2500};
 
+    //! inactive layouts that are kept loaded in MultipleLayouts mode, it is opt-in
+    //! because their views and containments stay in memory
+    int m_preloadedLayouts{0};
+
     QString m_currentLayoutName;
     QString m_lastNonAssignedLayoutName;
 
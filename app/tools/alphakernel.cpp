@@ -0,0 +1,194 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "alphakernel.h"
+
+// local
+#include "alphakernel_p.h"
+
+namespace Latte {
+namespace Kernels {
+
+quint64 alphaSumScalar(const QRgb *pixels, int count)
+{
+    quint64 sum{0};
+
+    for (int i = 0; i < count; ++i) {
+        sum += quint64(qAlpha(pixels[i]));
+    }
+
+    return sum;
+}
+
+int alphaMaxScalar(const QRgb *pixels, int count)
+{
+    int max{0};
+
+    for (int i = 0; i < count; ++i) {
+        max = qMax(max, qAlpha(pixels[i]));
+    }
+
+    return max;
+}
+
+#ifdef LATTE_X86_KERNELS
+//! QRgb pixels are stored in memory as B,G,R,A bytes, masking out all bytes
+//! except alpha lets the byte oriented instructions work only with the alpha channel
+__attribute__((target("sse2")))
+quint64 alphaSumSse2(const QRgb *pixels, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32(int(0xFF000000));
+
+    __m128i acc = _mm_setzero_si128();
+    int i{0};
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_and_si128(data, mask), zero));
+    }
+
+    alignas(16) quint64 lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+
+    return lanes[0] + lanes[1] + alphaSumScalar(pixels + i, count - i);
+}
+
+__attribute__((target("sse2")))
+int alphaMaxSse2(const QRgb *pixels, int count)
+{
+    const __m128i mask = _mm_set1_epi32(int(0xFF000000));
+
+    __m128i acc = _mm_setzero_si128();
+    int i{0};
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        acc = _mm_max_epu8(acc, _mm_and_si128(data, mask));
+    }
+
+    alignas(16) quint32 lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+
+    int max = alphaMaxScalar(pixels + i, count - i);
+
+    for (int lane = 0; lane < 4; ++lane) {
+        max = qMax(max, int(lanes[lane] >> 24));
+    }
+
+    return max;
+}
+
+__attribute__((target("avx2")))
+quint64 alphaSumAvx2(const QRgb *pixels, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi32(int(0xFF000000));
+
+    __m256i acc = _mm256_setzero_si256();
+    int i{0};
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_and_si256(data, mask), zero));
+    }
+
+    alignas(32) quint64 lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + alphaSumScalar(pixels + i, count - i);
+}
+
+__attribute__((target("avx2")))
+int alphaMaxAvx2(const QRgb *pixels, int count)
+{
+    const __m256i mask = _mm256_set1_epi32(int(0xFF000000));
+
+    __m256i acc = _mm256_setzero_si256();
+    int i{0};
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        acc = _mm256_max_epu8(acc, _mm256_and_si256(data, mask));
+    }
+
+    alignas(32) quint32 lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+
+    int max = alphaMaxScalar(pixels + i, count - i);
+
+    for (int lane = 0; lane < 8; ++lane) {
+        max = qMax(max, int(lanes[lane] >> 24));
+    }
+
+    return max;
+}
+#endif
+
+}
+
+namespace {
+
+struct AlphaKernels {
+    Kernels::AlphaSumKernel sum{Kernels::alphaSumScalar};
+    Kernels::AlphaMaxKernel max{Kernels::alphaMaxScalar};
+};
+
+AlphaKernels bestKernels()
+{
+    AlphaKernels kernels;
+
+    switch (CpuDispatch::bestInstructionSet()) {
+#ifdef LATTE_X86_KERNELS
+    case CpuDispatch::Avx2:
+        kernels.sum = Kernels::alphaSumAvx2;
+        kernels.max = Kernels::alphaMaxAvx2;
+        break;
+    case CpuDispatch::Sse2:
+        kernels.sum = Kernels::alphaSumSse2;
+        kernels.max = Kernels::alphaMaxSse2;
+        break;
+#endif
+    default:
+        break;
+    }
+
+    return kernels;
+}
+
+const AlphaKernels &kernels()
+{
+    static const AlphaKernels best = bestKernels();
+    return best;
+}
+
+}
+
+quint64 alphaSum(const QRgb *pixels, int count)
+{
+    return count > 0 ? kernels().sum(pixels, count) : 0;
+}
+
+int alphaMax(const QRgb *pixels, int count)
+{
+    return count > 0 ? kernels().max(pixels, count) : 0;
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ALPHAKERNEL_P_H
+#define ALPHAKERNEL_P_H
+
+// local
+#include "cpudispatch.h"
+
+// Qt
+#include <QRgb>
+
+//! Internal alpha kernels for every instruction set, alphakernel.h
+//! dispatches to the best of them and must be preferred by the application
+
+namespace Latte {
+namespace Kernels {
+
+using AlphaSumKernel = quint64 (*)(const QRgb *, int);
+using AlphaMaxKernel = int (*)(const QRgb *, int);
+
+quint64 alphaSumScalar(const QRgb *pixels, int count);
+int alphaMaxScalar(const QRgb *pixels, int count);
+
+#ifdef LATTE_X86_KERNELS
+quint64 alphaSumSse2(const QRgb *pixels, int count);
+int alphaMaxSse2(const QRgb *pixels, int count);
+
+quint64 alphaSumAvx2(const QRgb *pixels, int count);
+int alphaMaxAvx2(const QRgb *pixels, int count);
+#endif
+
+}
+}
+
+#endif
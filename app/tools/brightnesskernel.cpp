@@ -0,0 +1,132 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "brightnesskernel.h"
+
+// local
+#include "brightnesskernel_p.h"
+
+//! pixels processed before the 32bit accumulators are moved to 64bit,
+//! each 32bit lane can not overflow for that amount of pixels
+#define BLOCKPIXELS 4096
+
+namespace Latte {
+namespace Kernels {
+
+quint64 brightnessSumScalar(const QRgb *pixels, int count)
+{
+    quint64 sum{0};
+
+    for (int i = 0; i < count; ++i) {
+        sum += quint64(qRed(pixels[i])) * 299 + quint64(qGreen(pixels[i])) * 587 + quint64(qBlue(pixels[i])) * 114;
+    }
+
+    return sum;
+}
+
+#ifdef LATTE_X86_KERNELS
+//! QRgb pixels are stored in memory as B,G,R,A bytes
+__attribute__((target("sse2")))
+quint64 brightnessSumSse2(const QRgb *pixels, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_setr_epi16(114, 587, 299, 0, 114, 587, 299, 0);
+
+    quint64 sum{0};
+    int i{0};
+
+    while (i + 4 <= count) {
+        const int blockEnd = qMin(count, i + BLOCKPIXELS) - 3;
+        __m128i acc = _mm_setzero_si128();
+
+        for (; i < blockEnd; i += 4) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(data, zero), weights));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(data, zero), weights));
+        }
+
+        alignas(16) quint32 lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        sum += quint64(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    return sum + brightnessSumScalar(pixels + i, count - i);
+}
+
+__attribute__((target("avx2")))
+quint64 brightnessSumAvx2(const QRgb *pixels, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i weights = _mm256_setr_epi16(114, 587, 299, 0, 114, 587, 299, 0,
+                                              114, 587, 299, 0, 114, 587, 299, 0);
+
+    quint64 sum{0};
+    int i{0};
+
+    while (i + 8 <= count) {
+        const int blockEnd = qMin(count, i + BLOCKPIXELS) - 7;
+        __m256i acc = _mm256_setzero_si256();
+
+        for (; i < blockEnd; i += 8) {
+            const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_unpacklo_epi8(data, zero), weights));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_unpackhi_epi8(data, zero), weights));
+        }
+
+        alignas(32) quint32 lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+
+        for (int lane = 0; lane < 8; ++lane) {
+            sum += lanes[lane];
+        }
+    }
+
+    return sum + brightnessSumScalar(pixels + i, count - i);
+}
+#endif
+
+}
+
+namespace {
+
+Kernels::BrightnessSumKernel bestKernel()
+{
+    switch (CpuDispatch::bestInstructionSet()) {
+#ifdef LATTE_X86_KERNELS
+    case CpuDispatch::Avx2:
+        return Kernels::brightnessSumAvx2;
+    case CpuDispatch::Sse2:
+        return Kernels::brightnessSumSse2;
+#endif
+    default:
+        return Kernels::brightnessSumScalar;
+    }
+}
+
+}
+
+quint64 brightnessSum(const QRgb *pixels, int count)
+{
+    static const Kernels::BrightnessSumKernel kernel = bestKernel();
+
+    return count > 0 ? kernel(pixels, count) : 0;
+}
+
+}
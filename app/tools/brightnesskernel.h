@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BRIGHTNESSKERNEL_H
+#define BRIGHTNESSKERNEL_H
+
+// Qt
+#include <QRgb>
+
+namespace Latte {
+
+//! sum of (r*299 + g*587 + b*114) for all provided pixels, dividing it with 1000
+//! provides the sum of colorBrightness() for these pixels. The sum is computed
+//! with integers and as such it is exact, SIMD instructions are used when the
+//! cpu supports them
+quint64 brightnessSum(const QRgb *pixels, int count);
+
+}
+
+#endif
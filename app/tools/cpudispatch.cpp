@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cpudispatch.h"
+
+namespace Latte {
+namespace CpuDispatch {
+
+namespace {
+
+InstructionSet detectInstructionSet()
+{
+#ifdef LATTE_X86_KERNELS
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return Avx2;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return Sse2;
+    }
+#endif
+
+    return Scalar;
+}
+
+}
+
+InstructionSet bestInstructionSet()
+{
+    static const InstructionSet best = detectInstructionSet();
+
+    return best;
+}
+
+bool supports(InstructionSet instructionSet)
+{
+    return instructionSet <= bestInstructionSet();
+}
+
+}
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CPUDISPATCH_H
+#define CPUDISPATCH_H
+
+//! x86 kernels are built with per function target attributes, this way
+//! the application does not require any instruction set during build
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LATTE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Latte {
+namespace CpuDispatch {
+
+enum InstructionSet
+{
+    Scalar = 0,
+    Sse2,
+    Avx2
+};
+
+//! best instruction set that the cpu supports, it is detected only once
+InstructionSet bestInstructionSet();
+
+bool supports(InstructionSet instructionSet);
+
+}
+}
+
+#endif
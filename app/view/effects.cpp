@@ -34,6 +34,8 @@
 #include <KWindowEffects>
 #include <KWindowSystem>
 
+//! one frame at 60Hz, masks are not applied more often than that
+#define MASKSINTERVAL 16
 
 namespace Latte {
 namespace ViewPart {
@@ -44,6 +46,10 @@ Effects::Effects(Latte::View *parent)
 {
     m_corona = qobject_cast<Latte::Corona *>(m_view->corona());
 
+    m_masksTimer.setSingleShot(true);
+    m_masksTimer.setInterval(MASKSINTERVAL);
+    connect(&m_masksTimer, &QTimer::timeout, this, &Effects::applyMasks);
+
     init();
 }
 
@@ -306,7 +312,9 @@ void Effects::setInputMask(QRect area)
 
     m_inputMask = area;
 
-    m_corona->wm()->setInputMask(m_view, area);
+    if (!m_masksTimer.isActive()) {
+        m_masksTimer.start();
+    }
 
     emit inputMaskChanged();
 }
@@ -326,42 +334,30 @@ void Effects::forceMaskRedraw()
 
 void Effects::setSubtractedMaskRegion(const QString &regionid, const QRegion &region)
 {
-    if (m_subtractedMaskRegions.contains(regionid) && m_subtractedMaskRegions[regionid] == region) {
-        return;
+    if (m_subtractedMaskRegions.setRegion(regionid, region)) {
+        emit subtractedMaskRegionsChanged();
     }
-
-    m_subtractedMaskRegions[regionid] = region;
-    emit subtractedMaskRegionsChanged();
 }
 
 void Effects::removeSubtractedMaskRegion(const QString &regionid)
 {
-    if (!m_subtractedMaskRegions.contains(regionid)) {
-        return;
+    if (m_subtractedMaskRegions.removeRegion(regionid)) {
+        emit subtractedMaskRegionsChanged();
     }
-
-    m_subtractedMaskRegions.remove(regionid);
-    emit subtractedMaskRegionsChanged();
 }
 
 void Effects::setUnitedMaskRegion(const QString &regionid, const QRegion &region)
 {
-    if (m_unitedMaskRegions.contains(regionid) && m_unitedMaskRegions[regionid] == region) {
-        return;
+    if (m_unitedMaskRegions.setRegion(regionid, region)) {
+        emit unitedMaskRegionsChanged();
     }
-
-    m_unitedMaskRegions[regionid] = region;
-    emit unitedMaskRegionsChanged();
 }
 
 void Effects::removeUnitedMaskRegion(const QString &regionid)
 {
-    if (!m_unitedMaskRegions.contains(regionid)) {
-        return;
+    if (m_unitedMaskRegions.removeRegion(regionid)) {
+        emit unitedMaskRegionsChanged();
     }
-
-    m_unitedMaskRegions.remove(regionid);
-    emit unitedMaskRegionsChanged();
 }
 
 QRegion Effects::customMask(const QRect &rect)
@@ -399,17 +395,8 @@ QRegion Effects::customMask(const QRect &rect)
 
 QRegion Effects::maskCombinedRegion()
 {
-    QRegion region = m_mask;
-
-    for(auto subregion : m_subtractedMaskRegions) {
-        region = region.subtracted(subregion);
-    }
-
-    for(auto subregion : m_unitedMaskRegions) {
-        region = region.united(subregion);
-    }
-
-    return region;
+    //! subtracting all regions one by one is the same as subtracting their union
+    return QRegion(m_mask).subtracted(m_subtractedMaskRegions.united()).united(m_unitedMaskRegions.united());
 }
 
 void Effects::updateBackgroundCorners()
@@ -426,11 +413,37 @@ void Effects::updateBackgroundCorners()
 
 void Effects::updateMask()
 {
+    if (!m_masksTimer.isActive()) {
+        m_masksTimer.start();
+    }
+}
+
+void Effects::applyPendingMasks()
+{
+    if (m_masksTimer.isActive()) {
+        m_masksTimer.stop();
+        applyMasks();
+    }
+}
+
+void Effects::applyMasks()
+{
+    if (!m_view) {
+        return;
+    }
+
+    if (m_appliedInputMask != m_inputMask) {
+        m_appliedInputMask = m_inputMask;
+        m_corona->wm()->setInputMask(m_view, m_inputMask);
+    }
+
+    //! identical masks are not sent to the window system, each one triggers
+    //! a shape request and a full repaint from the compositor
+    QRegion newMask;
+
     if (KWindowSystem::compositingActive()) {
-        if (m_view->behaveAsPlasmaPanel()) {
-            m_view->setMask(QRect());
-        } else {
-            m_view->setMask(maskCombinedRegion());
+        if (!m_view->behaveAsPlasmaPanel()) {
+            newMask = maskCombinedRegion();
         }
     } else {
         QRegion fixedMask;
@@ -469,7 +482,11 @@ void Effects::updateMask()
             fixedMask = QRegion(m_mask);
         }
 
-        m_view->setMask(fixedMask);
+        newMask = fixedMask;
+    }
+
+    if (m_view->mask() != newMask) {
+        m_view->setMask(newMask);
     }
 }
 
@@ -21,6 +21,7 @@
 #define EFFECTS_H
 
 // local
+#include "helpers/regionsunion.h"
 #include "../plasma/extended/theme.h"
 
 // Qt
@@ -28,6 +29,8 @@
 #include <QPointer>
 #include <QQuickView>
 #include <QRect>
+#include <QRegion>
+#include <QTimer>
 
 // Plasma
 #include <Plasma/FrameSvg>
@@ -108,6 +111,10 @@ public:
 
     Plasma::FrameSvg::EnabledBorders enabledBorders() const;
 
+    //! masks are applied at most once per frame, this applies
+    //! immediately any mask change that is still pending
+    void applyPendingMasks();
+
 public slots:
     Q_INVOKABLE void forceMaskRedraw();
     Q_INVOKABLE void setSubtractedMaskRegion(const QString &regionid, const QRegion &region);
@@ -146,6 +153,8 @@ private slots:
     void updateBackgroundContrastValues();
     void updateBackgroundCorners();
 
+    void applyMasks();
+
 private:
     bool backgroundRadiusIsEnabled() const;
     qreal currentMidValue(const qreal &max, const qreal &factor, const qreal &min) const;
@@ -192,9 +201,13 @@ private:
     //only for the mask, not to actually paint
     Plasma::FrameSvg::EnabledBorders m_enabledBorders{Plasma::FrameSvg::AllBorders};
 
-    //! Subtracted and United Mask regions
-    QHash<QString, QRegion> m_subtractedMaskRegions;
-    QHash<QString, QRegion> m_unitedMaskRegions;
+    //! Subtracted and United Mask regions, changing one of them
+    //! recalculates only the partial unions that contain it
+    RegionsUnion m_subtractedMaskRegions;
+    RegionsUnion m_unitedMaskRegions;
+
+    QRect m_appliedInputMask;
+    QTimer m_masksTimer;
 };
 
 }
@@ -0,0 +1,117 @@
+/*
+*  Copyright 2020 Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "regionsunion.h"
+
+#define INITIALCAPACITY 8
+
+namespace Latte {
+namespace ViewPart {
+
+RegionsUnion::RegionsUnion()
+{
+    resize(INITIALCAPACITY);
+}
+
+bool RegionsUnion::contains(const QString &regionid) const
+{
+    return m_leaves.contains(regionid);
+}
+
+bool RegionsUnion::isEmpty() const
+{
+    return m_leaves.isEmpty();
+}
+
+QRegion RegionsUnion::united() const
+{
+    return m_tree[1];
+}
+
+bool RegionsUnion::setRegion(const QString &regionid, const QRegion &region)
+{
+    int leaf{-1};
+
+    if (m_leaves.contains(regionid)) {
+        leaf = m_leaves[regionid];
+
+        if (m_tree[m_capacity + leaf] == region) {
+            return false;
+        }
+    } else {
+        if (!m_freeLeaves.isEmpty()) {
+            leaf = m_freeLeaves.takeLast();
+        } else {
+            leaf = m_leaves.count();
+
+            if (leaf >= m_capacity) {
+                resize(2 * m_capacity);
+            }
+        }
+
+        m_leaves[regionid] = leaf;
+    }
+
+    m_tree[m_capacity + leaf] = region;
+    updateParents(m_capacity + leaf);
+
+    return true;
+}
+
+bool RegionsUnion::removeRegion(const QString &regionid)
+{
+    if (!m_leaves.contains(regionid)) {
+        return false;
+    }
+
+    int leaf = m_leaves.take(regionid);
+
+    m_tree[m_capacity + leaf] = QRegion();
+    updateParents(m_capacity + leaf);
+
+    m_freeLeaves << leaf;
+
+    return true;
+}
+
+void RegionsUnion::resize(int capacity)
+{
+    QVector<QRegion> tree(2 * capacity);
+
+    for (int leaf = 0; leaf < m_capacity; ++leaf) {
+        tree[capacity + leaf] = m_tree[m_capacity + leaf];
+    }
+
+    for (int node = capacity - 1; node >= 1; --node) {
+        tree[node] = tree[2 * node].united(tree[2 * node + 1]);
+    }
+
+    m_tree.swap(tree);
+    m_capacity = capacity;
+}
+
+void RegionsUnion::updateParents(int node)
+{
+    for (node = node / 2; node >= 1; node = node / 2) {
+        m_tree[node] = m_tree[2 * node].united(m_tree[2 * node + 1]);
+    }
+}
+
+}
+}
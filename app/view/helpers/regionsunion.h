@@ -0,0 +1,67 @@
+/*
+*  Copyright 2020 Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REGIONSUNION_H
+#define REGIONSUNION_H
+
+// Qt
+#include <QHash>
+#include <QRegion>
+#include <QString>
+#include <QVector>
+
+namespace Latte {
+namespace ViewPart {
+
+//! Union of regions that are identified by their id. The partial unions are
+//! kept in a binary tree whose leaves are the regions, this way changing or
+//! removing one region recalculates only the log(n) partial unions that
+//! contain it instead of uniting again all the regions.
+class RegionsUnion
+{
+public:
+    RegionsUnion();
+
+    bool contains(const QString &regionid) const;
+    bool isEmpty() const;
+
+    //! return false when nothing changed
+    bool setRegion(const QString &regionid, const QRegion &region);
+    bool removeRegion(const QString &regionid);
+
+    QRegion united() const;
+
+private:
+    void resize(int capacity);
+    void updateParents(int node);
+
+private:
+    //! leaves are placed at [capacity, 2*capacity) and node i is
+    //! the union of its children 2*i and 2*i+1, root is node 1
+    int m_capacity{0};
+    QVector<QRegion> m_tree;
+
+    QHash<QString, int> m_leaves;
+    QVector<int> m_freeLeaves;
+};
+
+}
+}
+
+#endif
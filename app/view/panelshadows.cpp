@@ -40,6 +40,17 @@
 
 #include <qdebug.h>
 
+//! server-side shadow pixmap that is shared between all windows and
+//! PanelShadows instances that use the same theme element and size
+struct SharedShadowPixmap
+{
+    Qt::HANDLE handle{nullptr};
+    int references{0};
+};
+
+typedef QHash<QString, SharedShadowPixmap> SharedShadowPixmaps;
+Q_GLOBAL_STATIC(SharedShadowPixmaps, sharedShadowPixmaps)
+
 class PanelShadows::Private
 {
 public:
@@ -66,6 +77,9 @@ public:
     void clearPixmaps();
     void setupPixmaps();
     Qt::HANDLE createPixmap(const QPixmap& source);
+    Qt::HANDLE pixmapHandle(const QPixmap &source) const;
+    void acquirePixmap(const QString &element, const QPixmap &source);
+    void acquireX11Pixmaps();
     void initPixmap(const QString &element);
     QPixmap initEmptyPixmap(const QSize &size);
     void updateShadow(const QWindow *window, Plasma::FrameSvg::EnabledBorders);
@@ -91,6 +105,10 @@ public:
     QPixmap m_emptyVerticalPix;
     QPixmap m_emptyHorizontalPix;
 
+    //! X11 pixmaps used from that instance, they are indexed by QPixmap::cacheKey()
+    QHash<qint64, Qt::HANDLE> m_pixmapHandles;
+    QStringList m_sharedPixmapKeys;
+
 #if HAVE_X11
     //! xcb connection
     xcb_connection_t* _connection;
@@ -272,6 +290,60 @@ Qt::HANDLE PanelShadows::Private::createPixmap(const QPixmap& source)
 
 }
 
+Qt::HANDLE PanelShadows::Private::pixmapHandle(const QPixmap &source) const
+{
+    return m_pixmapHandles.value(source.cacheKey(), nullptr);
+}
+
+void PanelShadows::Private::acquirePixmap(const QString &element, const QPixmap &source)
+{
+    if (source.isNull() || m_pixmapHandles.contains(source.cacheKey())) {
+        return;
+    }
+
+    //! empty pixmaps are not related to the theme and can be shared between all instances
+    const QString owner = element.startsWith(QLatin1String("empty")) ? QString() : q->theme()->themeName() + QLatin1Char('/') + q->imagePath();
+    const QString key = owner + QLatin1Char('/') + element + QLatin1Char('/') + QString::number(source.width()) + QLatin1Char('x') + QString::number(source.height());
+
+    SharedShadowPixmap &shared = (*sharedShadowPixmaps)[key];
+
+    if (!shared.handle) {
+        shared.handle = createPixmap(source);
+    }
+
+    shared.references++;
+
+    m_pixmapHandles[source.cacheKey()] = shared.handle;
+    m_sharedPixmapKeys << key;
+}
+
+void PanelShadows::Private::acquireX11Pixmaps()
+{
+#if HAVE_X11
+    if (!m_isX11) {
+        return;
+    }
+
+    //! same order as m_shadowPixmaps
+    const QStringList elements{QStringLiteral("shadow-top"), QStringLiteral("shadow-topright"),
+                               QStringLiteral("shadow-right"), QStringLiteral("shadow-bottomright"),
+                               QStringLiteral("shadow-bottom"), QStringLiteral("shadow-bottomleft"),
+                               QStringLiteral("shadow-left"), QStringLiteral("shadow-topleft")};
+
+    for (int i = 0; i < m_shadowPixmaps.count() && i < elements.count(); ++i) {
+        acquirePixmap(elements[i], m_shadowPixmaps[i]);
+    }
+
+    acquirePixmap(QStringLiteral("empty-corner"), m_emptyCornerPix);
+    acquirePixmap(QStringLiteral("empty-corner-left"), m_emptyCornerLeftPix);
+    acquirePixmap(QStringLiteral("empty-corner-top"), m_emptyCornerTopPix);
+    acquirePixmap(QStringLiteral("empty-corner-right"), m_emptyCornerRightPix);
+    acquirePixmap(QStringLiteral("empty-corner-bottom"), m_emptyCornerBottomPix);
+    acquirePixmap(QStringLiteral("empty-vertical"), m_emptyVerticalPix);
+    acquirePixmap(QStringLiteral("empty-horizontal"), m_emptyHorizontalPix);
+#endif
+}
+
 void PanelShadows::Private::initPixmap(const QString &element)
 {
     m_shadowPixmaps << q->pixmap(element);
@@ -314,6 +386,8 @@ void PanelShadows::Private::setupPixmaps()
     m_emptyVerticalPix = initEmptyPixmap(QSize(1, q->elementSize(QStringLiteral("shadow-left")).height()));
     m_emptyHorizontalPix = initEmptyPixmap(QSize(q->elementSize(QStringLiteral("shadow-top")).width(), 1));
 
+    acquireX11Pixmaps();
+
     if (m_wayland.shmPool) {
         for (auto it = m_shadowPixmaps.constBegin(); it != m_shadowPixmaps.constEnd(); ++it) {
             m_wayland.shadowBuffers << m_wayland.shmPool->createBuffer(it->toImage());
@@ -330,78 +404,78 @@ void PanelShadows::Private::setupData(Plasma::FrameSvg::EnabledBorders enabledBo
     }
     //shadow-top
     if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[0]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[0]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyHorizontalPix));
     }
 
     //shadow-topright
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[1]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[1]));
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerTopPix));
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerRightPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerPix));
     }
 
     //shadow-right
     if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[2]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[2]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyVerticalPix));
     }
 
     //shadow-bottomright
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[3]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[3]));
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerBottomPix));
     } else if (enabledBorders & Plasma::FrameSvg::RightBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerRightPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerPix));
     }
 
     //shadow-bottom
     if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[4]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[4]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyHorizontalPix));
     }
 
     //shadow-bottomleft
     if (enabledBorders & Plasma::FrameSvg::BottomBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[5]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[5]));
     } else if (enabledBorders & Plasma::FrameSvg::BottomBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerBottomPix));
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerLeftPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerPix));
     }
 
     //shadow-left
     if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[6]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[6]));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyVerticalPix));
     }
 
     //shadow-topleft
     if (enabledBorders & Plasma::FrameSvg::TopBorder &&
         enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_shadowPixmaps[7]));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_shadowPixmaps[7]));
     } else if (enabledBorders & Plasma::FrameSvg::TopBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerTopPix));
     } else if (enabledBorders & Plasma::FrameSvg::LeftBorder) {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerLeftPix));
     } else {
-        data[enabledBorders] << reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix));
+        data[enabledBorders] << reinterpret_cast<unsigned long>(pixmapHandle(m_emptyCornerPix));
     }
 #endif
 
@@ -458,41 +532,29 @@ void PanelShadows::Private::setupData(Plasma::FrameSvg::EnabledBorders enabledBo
 void PanelShadows::Private::freeX11Pixmaps()
 {
 #if HAVE_X11
-    if (!m_isX11) {
+    const QStringList keys = m_sharedPixmapKeys;
+
+    m_pixmapHandles.clear();
+    m_sharedPixmapKeys.clear();
+
+    if (!m_isX11 || sharedShadowPixmaps.isDestroyed()) {
         return;
     }
 
     auto *display = QX11Info::display();
-    if (!display) {
-        return;
-    }
 
-    foreach (const QPixmap &pixmap, m_shadowPixmaps) {
-        if (!pixmap.isNull()) {
-            XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(pixmap)));
+    for (const auto &key : keys) {
+        auto shared = sharedShadowPixmaps->find(key);
+
+        if (shared == sharedShadowPixmaps->end() || --shared->references > 0) {
+            continue;
         }
-    }
 
-    if (!m_emptyCornerPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerPix)));
-    }
-    if (!m_emptyCornerBottomPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerBottomPix)));
-    }
-    if (!m_emptyCornerLeftPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerLeftPix)));
-    }
-    if (!m_emptyCornerRightPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerRightPix)));
-    }
-    if (!m_emptyCornerTopPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyCornerTopPix)));
-    }
-    if (!m_emptyVerticalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyVerticalPix)));
-    }
-    if (!m_emptyHorizontalPix.isNull()) {
-        XFreePixmap(display, reinterpret_cast<unsigned long>(createPixmap(m_emptyHorizontalPix)));
+        if (display && shared->handle) {
+            XFreePixmap(display, reinterpret_cast<unsigned long>(shared->handle));
+        }
+
+        sharedShadowPixmaps->erase(shared);
     }
 #endif
 }
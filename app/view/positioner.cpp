@@ -65,6 +65,12 @@ Positioner::Positioner(Latte::View *parent)
     m_syncGeometryTimer.setInterval(150);
     connect(&m_syncGeometryTimer, &QTimer::timeout, this, &Positioner::immediateSyncGeometry);
 
+    //! adaptive thickness is shrinking only after the parabolic zoom has been restored
+    //! and its animations have ended, expanding is always applied immediately
+    m_shrinkThicknessTimer.setSingleShot(true);
+    m_shrinkThicknessTimer.setInterval(1000);
+    connect(&m_shrinkThicknessTimer, &QTimer::timeout, this, &Positioner::applyThicknessExpanded);
+
     m_corona = qobject_cast<Latte::Corona *>(m_view->corona());
 
     if (m_corona) {
@@ -109,6 +115,7 @@ Positioner::~Positioner()
 
     m_screenSyncTimer.stop();
     m_validateGeometryTimer.stop();
+    m_shrinkThicknessTimer.stop();
 }
 
 void Positioner::init()
@@ -210,11 +217,25 @@ void Positioner::init()
 
     connect(m_view, &Latte::View::visibilityChanged, this, &Positioner::initDelayedSignals);
 
+    connect(this, &Positioner::adaptiveThicknessChanged, this, &Positioner::updateThicknessExpanded);
+    connect(this, &Positioner::inThicknessAnimationChanged, this, &Positioner::updateThicknessExpanded);
+    connect(m_view, &Latte::View::containsDragChanged, this, &Positioner::updateThicknessExpanded);
+    connect(m_view, &Latte::View::contextMenuIsShownChanged, this, &Positioner::updateThicknessExpanded);
+    connect(m_view, &Latte::View::inEditModeChanged, this, &Positioner::updateThicknessExpanded);
+    connect(m_view, &Latte::View::behaveAsPlasmaPanelChanged, this, &Positioner::updateThicknessExpanded);
+    connect(m_view, &Latte::View::normalHighestThicknessChanged, this, [&]() {
+        if (m_adaptiveThickness && !m_thicknessExpanded) {
+            syncGeometry();
+        }
+    });
+
     initSignalingForLocationChangeSliding();
 }
 
 void Positioner::initDelayedSignals()
 {
+    connect(m_view->visibility(), &ViewPart::VisibilityManager::containsMouseChanged, this, &Positioner::updateThicknessExpanded);
+
     connect(m_view->visibility(), &ViewPart::VisibilityManager::isHiddenChanged, this, [&]() {
         if (m_view->behaveAsPlasmaPanel() && !m_view->visibility()->isHidden() && qAbs(m_slideOffset)>0) {
             //! ignore any checks to make sure the panel geometry is up-to-date
@@ -819,6 +840,130 @@ void Positioner::updatePosition(QRect availableScreenRect)
     }
 }
 
+bool Positioner::adaptiveThickness() const
+{
+    return m_adaptiveThickness;
+}
+
+void Positioner::setAdaptiveThickness(bool adaptive)
+{
+    if (m_adaptiveThickness == adaptive) {
+        return;
+    }
+
+    m_adaptiveThickness = adaptive;
+    emit adaptiveThicknessChanged();
+}
+
+bool Positioner::inThicknessAnimation() const
+{
+    return m_inThicknessAnimation;
+}
+
+void Positioner::setInThicknessAnimation(bool active)
+{
+    if (m_inThicknessAnimation == active) {
+        return;
+    }
+
+    m_inThicknessAnimation = active;
+    emit inThicknessAnimationChanged();
+}
+
+bool Positioner::thicknessExpandedIsNeeded() const
+{
+    if (!m_adaptiveThickness || m_view->behaveAsPlasmaPanel() || m_view->inEditMode()) {
+        return true;
+    }
+
+    //! parabolic zoom is triggered through user interaction with the view or
+    //! from containment animations such as new windows, attention, launchers and clicks
+    return m_inThicknessAnimation
+            || m_view->containsDrag()
+            || m_view->contextMenuIsShown()
+            || (m_view->visibility() && m_view->visibility()->containsMouse());
+}
+
+int Positioner::windowThickness() const
+{
+    if (m_thicknessExpanded) {
+        return m_view->maxThickness();
+    }
+
+    return qMin(m_view->maxThickness(), m_view->normalHighestThickness());
+}
+
+void Positioner::updateThicknessExpanded()
+{
+    if (thicknessExpandedIsNeeded()) {
+        m_shrinkThicknessTimer.stop();
+        applyThicknessExpanded();
+    } else if (m_thicknessExpanded && !m_shrinkThicknessTimer.isActive()) {
+        m_shrinkThicknessTimer.start();
+    }
+}
+
+void Positioner::applyThicknessExpanded()
+{
+    bool expanded = thicknessExpandedIsNeeded();
+
+    if (m_thicknessExpanded == expanded) {
+        return;
+    }
+
+    m_thicknessExpanded = expanded;
+
+    if (!(m_view->screen() && m_view->containment()) || m_inDelete || m_slideOffset!=0 || inSlideAnimation()
+            || m_view->geometry() != m_validGeometry) {
+        syncGeometry();
+        return;
+    }
+
+    //! only the thickness is changing, the window edge that touches the screen edge stays
+    //! at the same place. Size and position are applied at once, otherwise the contents
+    //! that are anchored at the screen edge would jump for a frame
+    int thickness = windowThickness();
+    QRect geometry = m_validGeometry;
+
+    switch (m_view->location()) {
+    case Plasma::Types::TopEdge:
+        geometry.setHeight(thickness);
+        break;
+    case Plasma::Types::BottomEdge:
+        geometry.setTop(geometry.bottom() - thickness + 1);
+        break;
+    case Plasma::Types::LeftEdge:
+        geometry.setWidth(thickness);
+        break;
+    case Plasma::Types::RightEdge:
+        geometry.setLeft(geometry.right() - thickness + 1);
+        break;
+    default:
+        return;
+    }
+
+    if (geometry == m_validGeometry) {
+        return;
+    }
+
+    m_validGeometry = geometry;
+
+    //! size constraints must allow both the old and the new size while the geometry is applied
+    m_view->setMinimumSize(geometry.size().boundedTo(m_view->size()));
+    m_view->setMaximumSize(geometry.size().expandedTo(m_view->size()));
+    m_view->setGeometry(geometry);
+    m_view->setMinimumSize(geometry.size());
+    m_view->setMaximumSize(geometry.size());
+
+    if (m_view->surface()) {
+        m_view->surface()->setPosition(geometry.topLeft());
+    }
+
+    if (m_view->formFactor() == Plasma::Types::Horizontal) {
+        emit windowSizeChanged();
+    }
+}
+
 int Positioner::slideOffset() const
 {
     return m_slideOffset;
@@ -838,7 +983,7 @@ void Positioner::setSlideOffset(int offset)
 void Positioner::resizeWindow(QRect availableScreenRect)
 {
     QSize screenSize = m_view->screen()->size();
-    QSize size = (m_view->formFactor() == Plasma::Types::Vertical) ? QSize(m_view->maxThickness(), availableScreenRect.height()) : QSize(screenSize.width(), m_view->maxThickness());
+    QSize size = (m_view->formFactor() == Plasma::Types::Vertical) ? QSize(windowThickness(), availableScreenRect.height()) : QSize(screenSize.width(), windowThickness());
 
     if (m_view->formFactor() == Plasma::Types::Vertical) {
         //qDebug() << "MAXIMUM RECT :: " << maximumRect << " - AVAILABLE RECT :: " << availableRect;
@@ -48,7 +48,9 @@ class Positioner: public QObject
 {
     Q_OBJECT
 
+    Q_PROPERTY(bool adaptiveThickness READ adaptiveThickness WRITE setAdaptiveThickness NOTIFY adaptiveThicknessChanged)
     Q_PROPERTY(bool inLocationAnimation READ inLocationAnimation NOTIFY inLocationAnimationChanged)
+    Q_PROPERTY(bool inThicknessAnimation READ inThicknessAnimation WRITE setInThicknessAnimation NOTIFY inThicknessAnimationChanged)
     Q_PROPERTY(bool inSlideAnimation READ inSlideAnimation WRITE setInSlideAnimation NOTIFY inSlideAnimationChanged)
 
     Q_PROPERTY(bool isStickedOnTopEdge READ isStickedOnTopEdge WRITE setIsStickedOnTopEdge NOTIFY isStickedOnTopEdgeChanged)
@@ -69,8 +71,18 @@ public:
     int slideOffset() const;
     void setSlideOffset(int offset);
 
+    //! window thickness follows the contents thickness and it is expanded
+    //! to the maximum thickness only when the parabolic zoom can be triggered
+    bool adaptiveThickness() const;
+    void setAdaptiveThickness(bool adaptive);
+
     bool inLocationAnimation();
 
+    //! containment animations that need the maximum thickness, e.g. tasks launching,
+    //! bouncing for attention or parabolic zoom that is not triggered from the user
+    bool inThicknessAnimation() const;
+    void setInThicknessAnimation(bool active);
+
     bool inSlideAnimation() const;
     void setInSlideAnimation(bool active);
 
@@ -104,6 +116,7 @@ public slots:
     void updateWaylandId();
 
 signals:
+    void adaptiveThicknessChanged();
     void canvasGeometryChanged();
     void currentScreenChanged();
     void edgeChanged();
@@ -126,6 +139,7 @@ signals:
 
     void onHideWindowsForSlidingOut();
     void inLocationAnimationChanged();
+    void inThicknessAnimationChanged();
     void inSlideAnimationChanged();
     void isStickedOnTopEdgeChanged();
     void isStickedOnBottomEdgeChanged();
@@ -138,6 +152,7 @@ private slots:
     void updateInLocationAnimation();
     void syncLatteViews();
     void updateContainmentScreen();
+    void updateThicknessExpanded();
 
 private:
     void init();
@@ -151,16 +166,23 @@ private:
     void validateTopBottomBorders(QRect availableScreenRect, QRegion availableScreenRegion);
 
     void setCanvasGeometry(const QRect &geometry);
+    void applyThicknessExpanded();
+
+    bool thicknessExpandedIsNeeded() const;
+    int windowThickness() const;
 
     QRect maximumNormalGeometry();
 
 private:
+    bool m_adaptiveThickness{false};
     bool m_inDelete{false};
     bool m_inLocationAnimation{false};
     bool m_inSlideAnimation{false};
+    bool m_inThicknessAnimation{false};
 
     bool m_isStickedOnTopEdge{false};
     bool m_isStickedOnBottomEdge{false};
+    bool m_thicknessExpanded{true};
 
     int m_slideOffset{0};
 
@@ -179,6 +201,7 @@ private:
     QTimer m_screenSyncTimer;
     QTimer m_syncGeometryTimer;
     QTimer m_validateGeometryTimer;
+    QTimer m_shrinkThicknessTimer;
 
     //!used at sliding out/in animation
     QString m_moveToLayout;
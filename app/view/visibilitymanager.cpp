@@ -21,6 +21,7 @@
 #include "visibilitymanager.h"
 
 // local
+#include "effects.h"
 #include "positioner.h"
 #include "view.h"
 #include "helpers/floatinggapwindow.h"
@@ -643,6 +644,8 @@ void VisibilityManager::updateGhostWindowState()
 void VisibilityManager::hide()
 {
     if (KWindowSystem::isPlatformX11()) {
+        //! a pending mask would otherwise show the view again
+        m_latteView->effects()->applyPendingMasks();
         m_lastMask = m_latteView->mask();
         m_latteView->setMask(QRect(-1, -1, 1, 1));
     } else {
@@ -125,7 +125,11 @@ WindowSystem::Tracker::LastActiveWindow *AllScreensTracker::lastActiveWindow()
 //! Window Functions
 void AllScreensTracker::requestMoveLastWindow(int localX, int localY)
 {
-    m_wm->windowsTracker()->lastActiveWindow(m_latteView->layout())->requestMove(m_latteView, localX, localY);
+    QPoint globalPoint{m_latteView->x() + localX, m_latteView->y() + localY};
+
+    if (m_wm->windowsTracker()->lastActiveWindow(m_latteView->layout())->requestMove(globalPoint)) {
+        m_latteView->unblockMouse(localX, localY);
+    }
 }
 
 }
@@ -194,7 +194,11 @@ WindowSystem::Tracker::LastActiveWindow *CurrentScreenTracker::lastActiveWindow(
 //! Window Functions
 void CurrentScreenTracker::requestMoveLastWindow(int localX, int localY)
 {
-    m_wm->windowsTracker()->lastActiveWindow(m_latteView)->requestMove(m_latteView, localX, localY);
+    QPoint globalPoint{m_latteView->x() + localX, m_latteView->y() + localY};
+
+    if (m_wm->windowsTracker()->lastActiveWindow(m_latteView)->requestMove(globalPoint)) {
+        m_latteView->unblockMouse(localX, localY);
+    }
 }
 
 }
@@ -21,9 +21,9 @@
 #include "abstractwindowinterface.h"
 
 // local
+#include "eventsrecorder.h"
 #include "tracker/schemes.h"
 #include "tracker/windowstracker.h"
-#include "../lattecorona.h"
 
 // Qt
 #include <QDebug>
@@ -36,6 +36,7 @@ namespace WindowSystem {
 
 #define MAXPLASMAPANELTHICKNESS 96
 #define MAXSIDEPANELTHICKNESS 512
+#define DEFAULTWINDOWSCHANGEDLATENCY 150
 
 AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     : QObject(parent)
@@ -43,20 +44,15 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
     m_activities = new KActivities::Consumer(this);
     m_currentActivity = m_activities->currentActivity();
 
-    m_corona = qobject_cast<Latte::Corona *>(parent);
     m_windowsTracker = new Tracker::Windows(this);
     m_schemesTracker = new Tracker::Schemes(this);
+    m_eventsRecorder = new EventsRecorder(this);
 
     rulesConfig = KSharedConfig::openConfig(QStringLiteral("taskmanagerrulesrc"));
 
-    m_windowWaitingTimer.setInterval(150);
-    m_windowWaitingTimer.setSingleShot(true);
-
-    connect(&m_windowWaitingTimer, &QTimer::timeout, this, [&]() {
-        WindowId wid = m_windowChangedWaiting;
-        m_windowChangedWaiting = QVariant();
-        emit windowChanged(wid);
-    });
+    m_windowsChangedTimer.setInterval(DEFAULTWINDOWSCHANGEDLATENCY);
+    m_windowsChangedTimer.setSingleShot(true);
+    connect(&m_windowsChangedTimer, &QTimer::timeout, this, &AbstractWindowInterface::flushWindowsChanged);
 
     connect(this, &AbstractWindowInterface::windowRemoved, this, &AbstractWindowInterface::windowRemovedSlot);
 
@@ -73,7 +69,7 @@ AbstractWindowInterface::AbstractWindowInterface(QObject *parent)
 
 AbstractWindowInterface::~AbstractWindowInterface()
 {
-    m_windowWaitingTimer.stop();
+    m_windowsChangedTimer.stop();
 
     m_schemesTracker->deleteLater();
     m_windowsTracker->deleteLater();
@@ -89,11 +85,6 @@ QString AbstractWindowInterface::currentActivity()
     return m_currentActivity;
 }
 
-Latte::Corona *AbstractWindowInterface::corona()
-{
-    return m_corona;
-}
-
 Tracker::Schemes *AbstractWindowInterface::schemesTracker()
 {
     return m_schemesTracker;
@@ -104,6 +95,27 @@ Tracker::Windows *AbstractWindowInterface::windowsTracker() const
     return m_windowsTracker;
 }
 
+PerfCounters *AbstractWindowInterface::perfCounters()
+{
+    return &m_perfCounters;
+}
+
+EventsRecorder *AbstractWindowInterface::eventsRecorder() const
+{
+    return m_eventsRecorder;
+}
+
+QList<WindowInfoWrap> AbstractWindowInterface::requestInfos(const QList<WindowId> &wids)
+{
+    QList<WindowInfoWrap> winfos;
+
+    for (const auto &wid : wids) {
+        winfos << requestInfo(wid);
+    }
+
+    return winfos;
+}
+
 bool AbstractWindowInterface::isIgnored(const WindowId &wid) const
 {
     return m_ignoredWindows.contains(wid);
@@ -249,6 +261,10 @@ void AbstractWindowInterface::unregisterWhitelistedWindow(WindowId wid)
 
 void AbstractWindowInterface::windowRemovedSlot(WindowId wid)
 {
+    if (m_windowsChangedQueued.remove(wid.toLongLong())) {
+        m_windowsChangedQueue.removeAll(wid);
+    }
+
     if (m_plasmaIgnoredWindows.contains(wid)) {
         unregisterPlasmaIgnoredWindow(wid);
     }
@@ -299,34 +315,44 @@ void AbstractWindowInterface::switchToPreviousActivity()
     activitiesController.setCurrentActivity(runningActivities.at(nextPos));
 }
 
+int AbstractWindowInterface::windowsChangedLatency() const
+{
+    return m_windowsChangedTimer.interval();
+}
+
+void AbstractWindowInterface::setWindowsChangedLatency(int latency)
+{
+    m_windowsChangedTimer.setInterval(qMax(0, latency));
+}
+
 //! Delay window changed trigerring
 void AbstractWindowInterface::considerWindowChanged(WindowId wid)
 {
-    //! Consider if the windowChanged signal should be sent DIRECTLY or WAIT
+    //! windows are only collected here, the timer is not restarted for upcoming
+    //! changes, this way windows that keep changing can not delay each other
+    //! more than the latency interval
+    if (!m_windowsChangedQueued.contains(wid.toLongLong())) {
+        m_windowsChangedQueued << wid.toLongLong();
+        m_windowsChangedQueue << wid;
+    }
 
-    if (m_windowChangedWaiting == wid && m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowWaitingTimer.start();
-        return;
+    if (!m_windowsChangedTimer.isActive()) {
+        m_windowsChangedTimer.start();
     }
+}
 
-    if (m_windowChangedWaiting != wid && !m_windowWaitingTimer.isActive()) {
-        //! window should be sent later
-        m_windowChangedWaiting = wid;
-        m_windowWaitingTimer.start();
+void AbstractWindowInterface::flushWindowsChanged()
+{
+    if (m_windowsChangedQueue.isEmpty()) {
+        return;
     }
 
-    if (m_windowChangedWaiting != wid && m_windowWaitingTimer.isActive()) {
-        m_windowWaitingTimer.stop();
-        //! sent previous waiting window
-        emit windowChanged(m_windowChangedWaiting);
+    QList<WindowId> wids;
+    wids.swap(m_windowsChangedQueue);
+    m_windowsChangedQueued.clear();
 
-        //! retrigger waiting for the upcoming window
-        m_windowChangedWaiting = wid;
-        m_windowWaitingTimer.start();
-    }
+    emit windowsChanged(wids);
 }
 
 }
 }
-
@@ -23,6 +23,7 @@
 
 // local
 #include <coretypes.h>
+#include "perfcounters.h"
 #include "schemecolors.h"
 #include "tasktools.h"
 #include "windowinfowrap.h"
@@ -41,6 +42,7 @@
 #include <QPoint>
 #include <QPointer>
 #include <QScreen>
+#include <QSet>
 #include <QTimer>
 
 // KDE
@@ -52,8 +54,8 @@
 
 
 namespace Latte {
-class Corona;
 namespace WindowSystem {
+class EventsRecorder;
 namespace Tracker {
 class Schemes;
 class Windows;
@@ -91,6 +93,9 @@ public:
     virtual WindowId activeWindow() = 0;
     virtual WindowInfoWrap requestInfo(WindowId wid) = 0;
     virtual WindowInfoWrap requestInfoActive() = 0;
+    //! windows information for many windows at once, window systems can
+    //! reimplement it in order to avoid one roundtrip per window
+    virtual QList<WindowInfoWrap> requestInfos(const QList<WindowId> &wids);
 
     virtual void skipTaskBar(const QDialog &dialog) = 0;
     virtual void slideWindow(QWindow &view, Slide location) = 0;
@@ -140,13 +145,21 @@ public:
     virtual void setFrameExtents(QWindow *view, const QMargins &margins) = 0;
     virtual void setInputMask(QWindow *window, const QRect &rect) = 0;
 
-    Latte::Corona *corona();
     Tracker::Schemes *schemesTracker();
     Tracker::Windows *windowsTracker() const;
+    PerfCounters *perfCounters();
+    EventsRecorder *eventsRecorder() const;
+
+    //! maximum time in ms that a window change can wait before it is sent
+    //! together with the other changed windows
+    int windowsChangedLatency() const;
+    void setWindowsChangedLatency(int latency);
 
 signals:
     void activeWindowChanged(WindowId wid);
     void windowChanged(WindowId winfo);
+    //! batched windows changes, each window is present only once
+    void windowsChanged(const QList<WindowId> &wids);
     void windowAdded(WindowId wid);
     void windowRemoved(WindowId wid);
     void currentDesktopChanged();
@@ -169,11 +182,13 @@ protected:
 
     QPointer<KActivities::Consumer> m_activities;
 
-    //! Sending too fast plenty of signals for the same window
-    //! has no reason and can create HIGH CPU usage. This Timer
-    //! can delay the batch sending of signals for the same window
-    WindowId m_windowChangedWaiting;
-    QTimer m_windowWaitingTimer;
+    //! Sending too fast plenty of signals for the same windows
+    //! has no reason and can create HIGH CPU usage. All changed windows
+    //! are collected and are sent together at most once per latency interval
+    QList<WindowId> m_windowsChangedQueue;
+    //! the queued windows, used in order to avoid scanning the queue for each change
+    QSet<qint64> m_windowsChangedQueued;
+    QTimer m_windowsChangedTimer;
 
     //! Plasma taskmanager rules ile
     KSharedConfig::Ptr rulesConfig;
@@ -189,12 +204,15 @@ protected:
     bool isSidepanel(const QRect &wGeometry) const;
 
 private slots:
+    void flushWindowsChanged();
     void windowRemovedSlot(WindowId wid);
 
 private:
-    Latte::Corona *m_corona;
     Tracker::Schemes *m_schemesTracker;
     Tracker::Windows *m_windowsTracker;
+    EventsRecorder *m_eventsRecorder;
+
+    PerfCounters m_perfCounters;
 };
 
 }
@@ -0,0 +1,158 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "eventsrecorder.h"
+
+// local
+#include "abstractwindowinterface.h"
+#include "tracker/windowstracker.h"
+
+// Qt
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QSaveFile>
+
+#define MAXRECORDS 8192
+#define RECORDINGMAGIC 0x4C545745
+#define RECORDINGVERSION 1
+
+namespace Latte {
+namespace WindowSystem {
+
+EventsRecorder::EventsRecorder(AbstractWindowInterface *parent)
+    : QObject(parent),
+      m_wm(parent)
+{
+}
+
+EventsRecorder::~EventsRecorder()
+{
+    setRecording(false);
+}
+
+bool EventsRecorder::isRecording() const
+{
+    return !m_connections.isEmpty();
+}
+
+void EventsRecorder::setRecording(bool recording)
+{
+    if (isRecording() == recording) {
+        return;
+    }
+
+    if (!recording) {
+        for (const auto &connection : m_connections) {
+            disconnect(connection);
+        }
+
+        m_connections.clear();
+        return;
+    }
+
+    m_records.clear();
+    m_records.reserve(MAXRECORDS);
+    m_nextRecord = 0;
+    m_startedAt = QDateTime::currentMSecsSinceEpoch();
+    m_timer.start();
+
+    //! the tracker is connected first, so its windows information are already
+    //! updated when the events are recorded
+    m_connections << connect(m_wm, &AbstractWindowInterface::windowAdded, this, &EventsRecorder::windowAdded);
+    m_connections << connect(m_wm, &AbstractWindowInterface::windowChanged, this, &EventsRecorder::windowChanged);
+    m_connections << connect(m_wm, &AbstractWindowInterface::windowsChanged, this, &EventsRecorder::windowsChanged);
+    m_connections << connect(m_wm, &AbstractWindowInterface::windowRemoved, this, &EventsRecorder::windowRemoved);
+    m_connections << connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, &EventsRecorder::activeWindowChanged);
+}
+
+void EventsRecorder::windowAdded(const WindowId &wid)
+{
+    record(WindowAdded, wid);
+}
+
+void EventsRecorder::windowChanged(const WindowId &wid)
+{
+    record(WindowChanged, wid);
+}
+
+void EventsRecorder::windowsChanged(const QList<WindowId> &wids)
+{
+    for (const auto &wid : wids) {
+        record(WindowChanged, wid);
+    }
+}
+
+void EventsRecorder::windowRemoved(const WindowId &wid)
+{
+    record(WindowRemoved, wid);
+}
+
+void EventsRecorder::activeWindowChanged(const WindowId &wid)
+{
+    record(ActiveWindowChanged, wid);
+}
+
+void EventsRecorder::record(EventType type, const WindowId &wid)
+{
+    WindowInfoWrap winfo = m_wm->windowsTracker()->infoFor(wid);
+
+    if (!winfo.isValid()) {
+        //! removed and untracked windows are identified only by their id
+        winfo.setWid(wid);
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << quint8(type) << m_timer.nsecsElapsed() / 1000 << winfo;
+
+    if (m_records.count() < MAXRECORDS) {
+        m_records << data;
+    } else {
+        m_records[m_nextRecord] = data;
+        m_nextRecord = (m_nextRecord + 1) % MAXRECORDS;
+    }
+}
+
+bool EventsRecorder::save(const QString &file) const
+{
+    QSaveFile output(file);
+
+    if (!output.open(QIODevice::WriteOnly)) {
+        qDebug() << "Windows events recording can not be saved at :: " << file;
+        return false;
+    }
+
+    QDataStream stream(&output);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << quint32(RECORDINGMAGIC) << quint32(RECORDINGVERSION) << m_startedAt << quint32(m_records.count());
+
+    //! each record is: event type (quint8), microseconds since recording started (qint64)
+    //! and the window information at that time
+    for (int i = 0; i < m_records.count(); ++i) {
+        const QByteArray &data = m_records[(m_nextRecord + i) % m_records.count()];
+        stream.writeRawData(data.constData(), data.size());
+    }
+
+    return output.commit();
+}
+
+}
+}
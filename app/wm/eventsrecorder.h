@@ -0,0 +1,93 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMEVENTSRECORDER_H
+#define WINDOWSYSTEMEVENTSRECORDER_H
+
+// local
+#include "windowinfowrap.h"
+
+// Qt
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QVector>
+
+namespace Latte {
+namespace WindowSystem {
+class AbstractWindowInterface;
+}
+}
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Records the windows events together with the window information at that time
+//! in a fixed size ring buffer. The recording can be saved on request in a compact
+//! binary file in order to reproduce offline workloads of real systems.
+class EventsRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum EventType
+    {
+        WindowAdded = 0,
+        WindowChanged,
+        WindowRemoved,
+        ActiveWindowChanged
+    };
+    Q_ENUM(EventType)
+
+    EventsRecorder(AbstractWindowInterface *parent);
+    ~EventsRecorder() override;
+
+    bool isRecording() const;
+    void setRecording(bool recording);
+
+    //! writes all recorded events, oldest first, and returns false on failure
+    bool save(const QString &file) const;
+
+private slots:
+    void windowAdded(const WindowId &wid);
+    void windowChanged(const WindowId &wid);
+    void windowsChanged(const QList<WindowId> &wids);
+    void windowRemoved(const WindowId &wid);
+    void activeWindowChanged(const WindowId &wid);
+
+private:
+    void record(EventType type, const WindowId &wid);
+
+private:
+    AbstractWindowInterface *m_wm{nullptr};
+
+    int m_nextRecord{0};
+    qint64 m_startedAt{0};
+    QElapsedTimer m_timer;
+
+    QVector<QByteArray> m_records;
+    QList<QMetaObject::Connection> m_connections;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "perfcounters.h"
+
+// Qt
+#include <QStringList>
+
+// C++
+#include <algorithm>
+
+#define MAXSAMPLES 1024
+
+namespace Latte {
+namespace WindowSystem {
+
+PerfCounters::Probe::Probe(PerfCounters *counters, Counter counter, int windowsScanned)
+    : m_counters(counters),
+      m_counter(counter),
+      m_windowsScanned(windowsScanned)
+{
+    m_timer.start();
+}
+
+PerfCounters::Probe::~Probe()
+{
+    if (m_counters) {
+        m_counters->record(m_counter, m_timer.nsecsElapsed(), m_windowsScanned);
+    }
+}
+
+PerfCounters::PerfCounters()
+    : m_stats(CountersCount)
+{
+}
+
+void PerfCounters::record(Counter counter, qint64 nsecs, int windowsScanned)
+{
+    Stats &stats = m_stats[counter];
+
+    stats.calls++;
+    stats.windowsScanned += windowsScanned;
+    stats.totalNsecs += nsecs;
+    stats.maxNsecs = qMax(stats.maxNsecs, nsecs);
+
+    if (stats.samples.count() < MAXSAMPLES) {
+        stats.samples.append(nsecs);
+    } else {
+        stats.samples[stats.nextSample] = nsecs;
+        stats.nextSample = (stats.nextSample + 1) % MAXSAMPLES;
+    }
+}
+
+void PerfCounters::reset()
+{
+    m_stats.fill(Stats(), CountersCount);
+}
+
+QString PerfCounters::name(Counter counter)
+{
+    switch (counter) {
+    case TrackerUpdateHints:
+        return QStringLiteral("Tracker::Windows::updateHints");
+    case TrackerUpdateExtraViewHints:
+        return QStringLiteral("Tracker::Windows::updateExtraViewHints");
+    case TrackerUpdateApplicationData:
+        return QStringLiteral("Tracker::Windows::updateApplicationData");
+    case XRequestInfo:
+        return QStringLiteral("XWindowInterface::requestInfo");
+    case XRequestInfos:
+        return QStringLiteral("XWindowInterface::requestInfos");
+    case WaylandUpdateWindow:
+        return QStringLiteral("WaylandInterface::updateWindow");
+    default:
+        return QString();
+    }
+}
+
+qint64 PerfCounters::percentile(QVector<qint64> samples, double ratio)
+{
+    if (samples.isEmpty()) {
+        return 0;
+    }
+
+    auto nth = samples.begin() + qMin(samples.count() - 1, int(samples.count() * ratio));
+    std::nth_element(samples.begin(), nth, samples.end());
+
+    return *nth;
+}
+
+QString PerfCounters::report() const
+{
+    QStringList lines;
+
+    for (int i = 0; i < CountersCount; ++i) {
+        const Stats &stats = m_stats[i];
+        const qint64 avgNsecs = stats.calls > 0 ? stats.totalNsecs / qint64(stats.calls) : 0;
+
+        lines << QStringLiteral("%1 calls=%2 total_us=%3 avg_us=%4 p99_us=%5 max_us=%6 windows_scanned=%7")
+                 .arg(name(static_cast<Counter>(i)))
+                 .arg(stats.calls)
+                 .arg(stats.totalNsecs / 1000)
+                 .arg(avgNsecs / 1000)
+                 .arg(percentile(stats.samples, 0.99) / 1000)
+                 .arg(stats.maxNsecs / 1000)
+                 .arg(stats.windowsScanned);
+    }
+
+    return lines.join(QLatin1Char('\n'));
+}
+
+}
+}
@@ -0,0 +1,92 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMPERFCOUNTERS_H
+#define WINDOWSYSTEMPERFCOUNTERS_H
+
+// Qt
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Lightweight performance counters for the windows tracking code paths.
+//! For each counter the number of calls, the cumulative duration, the p99
+//! duration of the most recent calls and the number of windows scanned
+//! are recorded. The figures are exported through D-Bus and --perf-report.
+class PerfCounters
+{
+public:
+    enum Counter
+    {
+        TrackerUpdateHints = 0,
+        TrackerUpdateExtraViewHints,
+        TrackerUpdateApplicationData,
+        XRequestInfo,
+        XRequestInfos,
+        WaylandUpdateWindow,
+        CountersCount
+    };
+
+    //! measures its own lifetime and records it when it is destroyed
+    class Probe
+    {
+    public:
+        Probe(PerfCounters *counters, Counter counter, int windowsScanned = 0);
+        ~Probe();
+
+    private:
+        PerfCounters *m_counters{nullptr};
+        Counter m_counter;
+        int m_windowsScanned{0};
+        QElapsedTimer m_timer;
+    };
+
+    PerfCounters();
+
+    void record(Counter counter, qint64 nsecs, int windowsScanned);
+    void reset();
+
+    //! one line per counter with space separated key=value pairs
+    QString report() const;
+
+private:
+    struct Stats {
+        quint64 calls{0};
+        quint64 windowsScanned{0};
+        qint64 totalNsecs{0};
+        qint64 maxNsecs{0};
+        //! ring buffer with the most recent durations used for percentiles
+        QVector<qint64> samples;
+        int nextSample{0};
+    };
+
+    static QString name(Counter counter);
+    static qint64 percentile(QVector<qint64> samples, double ratio);
+
+private:
+    QVector<Stats> m_stats;
+};
+
+}
+}
+
+#endif
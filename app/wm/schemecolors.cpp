@@ -21,7 +21,7 @@
 #include "schemecolors.h"
 
 // local
-#include "../layouts/importer.h"
+#include "../tools/commontools.h"
 
 // Qt
 #include <QDebug>
@@ -167,13 +167,13 @@ QString SchemeColors::possibleSchemeFile(QString scheme)
         }
     }
 
-    QString schemePath = Layouts::Importer::standardPath("color-schemes/" + tempScheme + ".colors");
+    QString schemePath = Latte::standardPath("color-schemes/" + tempScheme + ".colors");
 
     if (schemePath.isEmpty() || !QFileInfo(schemePath).exists()) {
         //! remove all whitespaces and "-" from scheme in order to access correctly its file
         QString schemeNameSimplified = tempScheme.simplified().remove(" ").remove("-");
 
-        schemePath = Layouts::Importer::standardPath("color-schemes/" + schemeNameSimplified + ".colors");
+        schemePath = Latte::standardPath("color-schemes/" + schemeNameSimplified + ".colors");
     }
 
     if (QFileInfo(schemePath).exists()) {
@@ -0,0 +1,151 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "coronaviewshost.h"
+
+// local
+#include "../../apptypes.h"
+#include "../../lattecorona.h"
+#include "../../layout/genericlayout.h"
+#include "../../layouts/manager.h"
+#include "../../view/positioner.h"
+#include "../../view/view.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+CoronaViewsHost::CoronaViewsHost(Latte::Corona *corona)
+    : ViewsHost(corona),
+      m_corona(corona)
+{
+    connect(m_corona, &Plasma::Corona::availableScreenRectChanged, this, &ViewsHost::availableScreenGeometriesChanged);
+}
+
+CoronaViewsHost::~CoronaViewsHost()
+{
+}
+
+bool CoronaViewsHost::hasMultipleLayouts() const
+{
+    return m_corona->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts;
+}
+
+QRect CoronaViewsHost::availableScreenGeometry(int screenId, const QList<Latte::Types::Visibility> &ignoreModes) const
+{
+    return m_corona->availableScreenRectWithCriteria(screenId, QString(), ignoreModes, {});
+}
+
+void CoronaViewsHost::trackView(Latte::View *view)
+{
+    connect(view, &Latte::View::activitiesChanged, this, [&, view]() {
+        emit viewActivitiesChanged(view);
+    });
+
+    connect(view, &Latte::View::absoluteGeometryChanged, this, [&, view]() {
+        emit viewGeometryChanged(view);
+    });
+
+    connect(view, &Latte::View::screenGeometryChanged, this, [&, view]() {
+        emit viewGeometryChanged(view);
+    });
+
+    connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, [&, view]() {
+        emit viewIsTouchingViewAndIsBusyChanged(view);
+    });
+
+    connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, [&, view]() {
+        emit viewIsTouchingViewAndIsBusyChanged(view);
+    });
+
+    connect(view, &Latte::View::layoutChanged, this, [&, view]() {
+        emit viewLayoutChanged(view);
+    });
+}
+
+void CoronaViewsHost::untrackView(Latte::View *view)
+{
+    disconnect(view, nullptr, this, nullptr);
+}
+
+bool CoronaViewsHost::isTouchingBottomViewAndIsBusy(Latte::View *view) const
+{
+    return view->isTouchingBottomViewAndIsBusy();
+}
+
+bool CoronaViewsHost::isTouchingTopViewAndIsBusy(Latte::View *view) const
+{
+    return view->isTouchingTopViewAndIsBusy();
+}
+
+int CoronaViewsHost::screenId(Latte::View *view) const
+{
+    return view->positioner()->currentScreenId();
+}
+
+Plasma::Types::FormFactor CoronaViewsHost::formFactor(Latte::View *view) const
+{
+    return view->formFactor();
+}
+
+Plasma::Types::Location CoronaViewsHost::location(Latte::View *view) const
+{
+    return view->location();
+}
+
+QRect CoronaViewsHost::absoluteGeometry(Latte::View *view) const
+{
+    return view->absoluteGeometry();
+}
+
+QRect CoronaViewsHost::screenGeometry(Latte::View *view) const
+{
+    return view->screenGeometry();
+}
+
+QStringList CoronaViewsHost::activities(Latte::View *view) const
+{
+    return view->activities();
+}
+
+Latte::Layout::GenericLayout *CoronaViewsHost::layout(Latte::View *view) const
+{
+    return view->layout();
+}
+
+void CoronaViewsHost::trackLayout(Latte::Layout::GenericLayout *layout)
+{
+    connect(layout, &Latte::Layout::GenericLayout::activitiesChanged, this, [&, layout]() {
+        emit layoutActivitiesChanged(layout);
+    });
+}
+
+void CoronaViewsHost::untrackLayout(Latte::Layout::GenericLayout *layout)
+{
+    disconnect(layout, nullptr, this, nullptr);
+}
+
+QStringList CoronaViewsHost::appliedActivities(Latte::Layout::GenericLayout *layout) const
+{
+    return layout->appliedActivities();
+}
+
+}
+}
+}
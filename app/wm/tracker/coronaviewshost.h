@@ -0,0 +1,77 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERCORONAVIEWSHOST_H
+#define WINDOWSYSTEMTRACKERCORONAVIEWSHOST_H
+
+// local
+#include "viewshost.h"
+
+namespace Latte {
+class Corona;
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! The application views, layouts and screens information for the windows tracker
+class CoronaViewsHost : public ViewsHost
+{
+    Q_OBJECT
+
+public:
+    CoronaViewsHost(Latte::Corona *corona);
+    ~CoronaViewsHost() override;
+
+    bool hasMultipleLayouts() const override;
+    QRect availableScreenGeometry(int screenId, const QList<Latte::Types::Visibility> &ignoreModes) const override;
+
+    void trackView(Latte::View *view) override;
+    void untrackView(Latte::View *view) override;
+
+    bool isTouchingBottomViewAndIsBusy(Latte::View *view) const override;
+    bool isTouchingTopViewAndIsBusy(Latte::View *view) const override;
+
+    int screenId(Latte::View *view) const override;
+
+    Plasma::Types::FormFactor formFactor(Latte::View *view) const override;
+    Plasma::Types::Location location(Latte::View *view) const override;
+
+    QRect absoluteGeometry(Latte::View *view) const override;
+    QRect screenGeometry(Latte::View *view) const override;
+
+    QStringList activities(Latte::View *view) const override;
+
+    Latte::Layout::GenericLayout *layout(Latte::View *view) const override;
+
+    void trackLayout(Latte::Layout::GenericLayout *layout) override;
+    void untrackLayout(Latte::Layout::GenericLayout *layout) override;
+
+    QStringList appliedActivities(Latte::Layout::GenericLayout *layout) const override;
+
+private:
+    Latte::Corona *m_corona{nullptr};
+};
+
+}
+}
+}
+
+#endif
@@ -25,7 +25,6 @@
 #include "windowstracker.h"
 #include "../abstractwindowinterface.h"
 #include "../tasktools.h"
-#include "../../view/view.h"
 
 // Qt
 #include <QDebug>
@@ -55,7 +54,7 @@ LastActiveWindow::LastActiveWindow(TrackedGeneralInfo *trackedInfo)
     });
 
     connect(m_windowsTracker, &Windows::applicationDataChanged, this, &LastActiveWindow::applicationDataChanged);
-    connect(m_windowsTracker, &Windows::windowChanged, this, &LastActiveWindow::windowChanged);
+    connect(m_windowsTracker, &Windows::windowsChanged, this, &LastActiveWindow::windowsChanged);
     connect(m_windowsTracker, &Windows::windowRemoved, this, &LastActiveWindow::windowRemoved);
 }
 
@@ -548,6 +547,51 @@ void LastActiveWindow::windowChanged(const WindowId &wid)
     }
 }
 
+void LastActiveWindow::windowsChanged(const QList<WindowId> &wids)
+{
+    if (!m_trackedInfo->enabled()) {
+        return;
+    }
+
+    //! remove from history all minimized windows or windows that changed screen
+    //! and afterwards evaluate the first history window only once for the entire batch
+    bool historyIsAffected{false};
+    bool firstItemChanged{false};
+
+    for (const auto &wid : wids) {
+        if (!m_history.contains(wid)) {
+            continue;
+        }
+
+        historyIsAffected = true;
+
+        if (m_history[0] == wid) {
+            firstItemChanged = true;
+        }
+
+        WindowInfoWrap winfo = m_windowsTracker->infoFor(wid);
+
+        if (winfo.isMinimized() || !m_trackedInfo->isTracking(winfo)) {
+            m_history.removeAll(wid);
+        }
+    }
+
+    if (!historyIsAffected) {
+        return;
+    }
+
+    cleanHistory();
+
+    if (m_history.count() > 0) {
+        if (firstItemChanged) {
+            windowChanged(m_history[0]);
+        }
+    } else {
+        //! History is empty so any demonstrated information are invalid
+        setIsValid(false);
+    }
+}
+
 void LastActiveWindow::windowRemoved(const WindowId &wid)
 {
     if (m_history.contains(wid)) {
@@ -600,16 +644,14 @@ void LastActiveWindow::requestClose()
     m_wm->requestClose(m_winId);
 }
 
-void LastActiveWindow::requestMove(Latte::View *fromView, int localX, int localY)
+bool LastActiveWindow::requestMove(const QPoint &globalPoint)
 {
-    if (!fromView || !canBeDragged()) {
-        return;
+    if (!canBeDragged()) {
+        return false;
     }
 
-    QPoint globalPoint{fromView->x() + localX, fromView->y() + localY};
     m_wm->requestMoveWindow(m_winId, globalPoint);
-
-    fromView->unblockMouse(localX, localY);
+    return true;
 }
 
 void LastActiveWindow::requestToggleIsOnAllDesktops()
@@ -26,10 +26,10 @@
 
 // Qt
 #include <QObject>
+#include <QPoint>
 #include <QRect>
 
 namespace Latte {
-class View;
 namespace WindowSystem {
 class AbstractWindowInterface;
 namespace Tracker {
@@ -128,12 +128,15 @@ public slots:
 
     Q_INVOKABLE bool canBeDragged();
 
-    void requestMove(Latte::View *fromView, int localX, int localY);
+    //! returns true when the window move was requested,
+    //! the caller is responsible to release its mouse grab afterwards
+    bool requestMove(const QPoint &globalPoint);
 
 private slots:
     void applicationDataChanged(const WindowId &wid);
 
     void windowChanged(const WindowId &wid);
+    void windowsChanged(const QList<WindowId> &wids);
     void windowRemoved(const WindowId &wid);
 
 
@@ -21,7 +21,6 @@
 
 // local
 #include "../abstractwindowinterface.h"
-#include "../../lattecorona.h"
 
 // Qt
 #include <QDir>
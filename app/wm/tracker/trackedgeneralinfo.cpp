@@ -66,6 +66,7 @@ void TrackedGeneralInfo::setEnabled(bool enabled)
     }
 
     m_enabled = enabled;
+    invalidateHintWindows();
 }
 
 bool TrackedGeneralInfo::activeWindowMaximized() const
@@ -117,9 +118,16 @@ bool TrackedGeneralInfo::isTrackingCurrentActivity() const
 
 void TrackedGeneralInfo::updateTrackingCurrentActivity()
 {
-    m_isTrackingCurrentActivity = ( m_activities.isEmpty()
-                                    || m_activities[0] == "0"
+    bool isTracking = ( m_activities.isEmpty()
+                        || m_activities[0] == "0"
             || m_activities.contains(m_wm->currentActivity()));
+
+    if (m_isTrackingCurrentActivity == isTracking) {
+        return;
+    }
+
+    m_isTrackingCurrentActivity = isTracking;
+    invalidateHintWindows();
 }
 
 
@@ -161,6 +169,42 @@ bool TrackedGeneralInfo::isTracking(const WindowInfoWrap &winfo) const
             && winfo.isOnActivity(m_wm->currentActivity()));
 }
 
+bool TrackedGeneralInfo::hintWindowsAreValid() const
+{
+    return m_hintWindowsAreValid;
+}
+
+void TrackedGeneralInfo::invalidateHintWindows()
+{
+    m_hintWindowsAreValid = false;
+    m_hintWindows.clear();
+}
+
+void TrackedGeneralInfo::resetHintWindows()
+{
+    m_hintWindowsAreValid = true;
+    m_hintWindows.clear();
+}
+
+bool TrackedGeneralInfo::isHintWindow(const WindowId &wid) const
+{
+    return m_hintWindows.contains(wid);
+}
+
+void TrackedGeneralInfo::setWindowHints(const WindowId &wid, const int hints)
+{
+    if (hints == 0) {
+        m_hintWindows.remove(wid);
+    } else {
+        m_hintWindows[wid] = hints;
+    }
+}
+
+QMap<WindowId, int> TrackedGeneralInfo::hintWindows() const
+{
+    return m_hintWindows;
+}
+
 }
 }
 }
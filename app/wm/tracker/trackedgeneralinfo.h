@@ -25,6 +25,7 @@
 #include "../windowinfowrap.h"
 
 // Qt
+#include <QMap>
 #include <QObject>
 
 namespace Latte {
@@ -75,6 +76,17 @@ public:
 
     virtual bool isTracking(const WindowInfoWrap &winfo) const;
 
+    //! windows that currently affect the tracking hints together with the
+    //! criteria they fulfill, they are used in order to update the hints
+    //! incrementally when a single window changes
+    bool hintWindowsAreValid() const;
+    void invalidateHintWindows();
+    void resetHintWindows();
+
+    bool isHintWindow(const WindowId &wid) const;
+    void setWindowHints(const WindowId &wid, const int hints);
+    QMap<WindowId, int> hintWindows() const;
+
 signals:
     void lastActiveWindowChanged();
 
@@ -96,6 +108,9 @@ private:
 
     bool m_isTrackingCurrentActivity{true};
 
+    bool m_hintWindowsAreValid{false};
+    QMap<WindowId, int> m_hintWindows;
+
     SchemeColors *m_activeWindowScheme{nullptr};
 };
 
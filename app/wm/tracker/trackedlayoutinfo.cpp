@@ -20,8 +20,8 @@
 #include "trackedlayoutinfo.h"
 
 //local
+#include "viewshost.h"
 #include "windowstracker.h"
-#include "../../layout/genericlayout.h"
 
 namespace Latte {
 namespace WindowSystem {
@@ -32,11 +32,13 @@ TrackedLayoutInfo::TrackedLayoutInfo(Tracker::Windows *tracker, Latte::Layout::G
     : TrackedGeneralInfo(tracker),
       m_layout(layout)
 {
-    m_activities = m_layout->appliedActivities();
+    m_activities = m_tracker->viewsHost()->appliedActivities(m_layout);
 
-    connect(m_layout, &Latte::Layout::GenericLayout::activitiesChanged, this, [&]() {
-        m_activities = m_layout->appliedActivities();
-        updateTrackingCurrentActivity();
+    connect(m_tracker->viewsHost(), &ViewsHost::layoutActivitiesChanged, this, [&](Latte::Layout::GenericLayout *layout) {
+        if (layout == m_layout) {
+            m_activities = m_tracker->viewsHost()->appliedActivities(m_layout);
+            updateTrackingCurrentActivity();
+        }
     });
 }
 
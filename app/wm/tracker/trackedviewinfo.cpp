@@ -20,9 +20,9 @@
 #include "trackedviewinfo.h"
 
 //local
+#include "viewshost.h"
 #include "windowstracker.h"
 #include "../schemecolors.h"
-#include "../../view/view.h"
 
 
 namespace Latte {
@@ -34,11 +34,13 @@ TrackedViewInfo::TrackedViewInfo(Tracker::Windows *tracker, Latte::View *view)
     : TrackedGeneralInfo(tracker) ,
       m_view(view)
 {
-    m_activities = m_view->activities();
+    m_activities = m_tracker->viewsHost()->activities(m_view);
 
-    connect(m_view, &Latte::View::activitiesChanged, this, [&]() {
-        m_activities = m_view->activities();
-        updateTrackingCurrentActivity();
+    connect(m_tracker->viewsHost(), &ViewsHost::viewActivitiesChanged, this, [&](Latte::View *view) {
+        if (view == m_view) {
+            m_activities = m_tracker->viewsHost()->activities(m_view);
+            updateTrackingCurrentActivity();
+        }
     });
 }
 
@@ -0,0 +1,101 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMTRACKERVIEWSHOST_H
+#define WINDOWSYSTEMTRACKERVIEWSHOST_H
+
+// local
+#include <coretypes.h>
+
+// Qt
+#include <QList>
+#include <QObject>
+#include <QRect>
+#include <QStringList>
+
+// Plasma
+#include <Plasma>
+
+namespace Latte {
+class View;
+namespace Layout {
+class GenericLayout;
+}
+}
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Views, layouts and screens information that the windows tracker needs. The tracker
+//! uses views and layouts only as keys and everything it needs to know about them
+//! is provided from here, this way it does not depend on the rest of the application.
+class ViewsHost : public QObject
+{
+    Q_OBJECT
+
+public:
+    ViewsHost(QObject *parent = nullptr);
+    ~ViewsHost() override;
+
+    //! Screens
+    virtual bool hasMultipleLayouts() const = 0;
+    virtual QRect availableScreenGeometry(int screenId, const QList<Latte::Types::Visibility> &ignoreModes) const = 0;
+
+    //! Views, their signals are sent only for the tracked views
+    virtual void trackView(Latte::View *view) = 0;
+    virtual void untrackView(Latte::View *view) = 0;
+
+    virtual bool isTouchingBottomViewAndIsBusy(Latte::View *view) const = 0;
+    virtual bool isTouchingTopViewAndIsBusy(Latte::View *view) const = 0;
+
+    virtual int screenId(Latte::View *view) const = 0;
+
+    virtual Plasma::Types::FormFactor formFactor(Latte::View *view) const = 0;
+    virtual Plasma::Types::Location location(Latte::View *view) const = 0;
+
+    virtual QRect absoluteGeometry(Latte::View *view) const = 0;
+    virtual QRect screenGeometry(Latte::View *view) const = 0;
+
+    virtual QStringList activities(Latte::View *view) const = 0;
+
+    virtual Latte::Layout::GenericLayout *layout(Latte::View *view) const = 0;
+
+    //! Layouts, their signals are sent only for the tracked layouts
+    virtual void trackLayout(Latte::Layout::GenericLayout *layout) = 0;
+    virtual void untrackLayout(Latte::Layout::GenericLayout *layout) = 0;
+
+    virtual QStringList appliedActivities(Latte::Layout::GenericLayout *layout) const = 0;
+
+signals:
+    void availableScreenGeometriesChanged();
+
+    void viewActivitiesChanged(Latte::View *view);
+    void viewGeometryChanged(Latte::View *view);
+    void viewIsTouchingViewAndIsBusyChanged(Latte::View *view);
+    void viewLayoutChanged(Latte::View *view);
+
+    void layoutActivitiesChanged(Latte::Layout::GenericLayout *layout);
+};
+
+}
+}
+}
+
+#endif
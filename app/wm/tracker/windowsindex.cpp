@@ -0,0 +1,123 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "windowsindex.h"
+
+// C++
+#include <algorithm>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+WindowsIndex::WindowsIndex()
+{
+}
+
+void WindowsIndex::clear()
+{
+    m_geometries.clear();
+    m_screens.clear();
+}
+
+void WindowsIndex::addWindow(ScreenWindows &screen, const WindowId &wid)
+{
+    auto pos = std::lower_bound(screen.windows.begin(), screen.windows.end(), wid);
+
+    if (pos == screen.windows.end() || *pos != wid) {
+        screen.windows.insert(pos, wid);
+    }
+}
+
+void WindowsIndex::removeWindow(ScreenWindows &screen, const WindowId &wid)
+{
+    auto pos = std::lower_bound(screen.windows.begin(), screen.windows.end(), wid);
+
+    if (pos != screen.windows.end() && *pos == wid) {
+        screen.windows.erase(pos);
+    }
+}
+
+void WindowsIndex::insert(const WindowId &wid, const QRect &geometry)
+{
+    auto current = m_geometries.find(wid);
+
+    if (current != m_geometries.end() && current.value() == geometry) {
+        return;
+    }
+
+    m_geometries[wid] = geometry;
+
+    for (auto &screen : m_screens) {
+        if (screen.geometry.intersects(geometry)) {
+            addWindow(screen, wid);
+        } else {
+            removeWindow(screen, wid);
+        }
+    }
+}
+
+void WindowsIndex::remove(const WindowId &wid)
+{
+    if (!m_geometries.contains(wid)) {
+        return;
+    }
+
+    m_geometries.remove(wid);
+
+    for (auto &screen : m_screens) {
+        removeWindow(screen, wid);
+    }
+}
+
+QList<WindowId> WindowsIndex::windowsIn(const QRect &screenGeometry)
+{
+    for (const auto &screen : m_screens) {
+        if (screen.geometry == screenGeometry) {
+            return screen.windows;
+        }
+    }
+
+    //! first request for that screen, m_geometries is sorted so the windows list is also sorted
+    ScreenWindows screen;
+    screen.geometry = screenGeometry;
+
+    for (auto i = m_geometries.constBegin(); i != m_geometries.constEnd(); ++i) {
+        if (screenGeometry.intersects(i.value())) {
+            screen.windows << i.key();
+        }
+    }
+
+    m_screens << screen;
+
+    return screen.windows;
+}
+
+void WindowsIndex::releaseScreensExcept(const QList<QRect> &screenGeometries)
+{
+    for (int i = m_screens.count() - 1; i >= 0; --i) {
+        if (!screenGeometries.contains(m_screens[i].geometry)) {
+            m_screens.removeAt(i);
+        }
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,75 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMWINDOWSINDEX_H
+#define WINDOWSYSTEMWINDOWSINDEX_H
+
+// local
+#include "../windowinfowrap.h"
+
+// Qt
+#include <QList>
+#include <QMap>
+#include <QRect>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Spatial index of the tracked windows per screen. Each screen that has been
+//! requested at least once keeps a sorted list of the windows that intersect it
+//! and that list is updated incrementally whenever a window geometry changes.
+//! Views can this way check only the windows that are present in their screen
+//! instead of all the windows of the system.
+class WindowsIndex
+{
+public:
+    WindowsIndex();
+
+    void clear();
+
+    void insert(const WindowId &wid, const QRect &geometry);
+    void remove(const WindowId &wid);
+
+    //! windows that intersect the given screen geometry, sorted the same way
+    //! the tracker windows are sorted
+    QList<WindowId> windowsIn(const QRect &screenGeometry);
+
+    //! forget all screens that are not present in the provided list
+    void releaseScreensExcept(const QList<QRect> &screenGeometries);
+
+private:
+    struct ScreenWindows {
+        QRect geometry;
+        QList<WindowId> windows;
+    };
+
+    void addWindow(ScreenWindows &screen, const WindowId &wid);
+    void removeWindow(ScreenWindows &screen, const WindowId &wid);
+
+private:
+    QMap<WindowId, QRect> m_geometries;
+    QList<ScreenWindows> m_screens;
+};
+
+}
+}
+}
+
+#endif
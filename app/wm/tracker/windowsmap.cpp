@@ -0,0 +1,188 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "windowsmap.h"
+
+#define EMPTYSLOT -1
+#define MINSLOTS 64
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+WindowsMap::WindowsMap()
+{
+}
+
+bool WindowsMap::contains(const WindowId &wid) const
+{
+    return indexOf(wid.toLongLong()) != EMPTYSLOT;
+}
+
+int WindowsMap::count() const
+{
+    return m_values.count();
+}
+
+void WindowsMap::clear()
+{
+    m_ids.clear();
+    m_keys.clear();
+    m_values.clear();
+    m_slots.clear();
+    m_shift = 64;
+}
+
+int WindowsMap::idealSlot(const qint64 id) const
+{
+    //! fibonacci hashing, window ids are usually sequential
+    return int((quint64(id) * Q_UINT64_C(11400714819323198485)) >> m_shift);
+}
+
+int WindowsMap::slotOf(const qint64 id) const
+{
+    if (m_slots.isEmpty()) {
+        return EMPTYSLOT;
+    }
+
+    const int mask = m_slots.count() - 1;
+
+    for (int slot = idealSlot(id); ; slot = (slot + 1) & mask) {
+        const int index = m_slots[slot];
+
+        if (index == EMPTYSLOT || m_ids[index] == id) {
+            return slot;
+        }
+    }
+}
+
+int WindowsMap::indexOf(const qint64 id) const
+{
+    const int slot = slotOf(id);
+    return slot == EMPTYSLOT ? EMPTYSLOT : m_slots[slot];
+}
+
+void WindowsMap::rehash(const int slotsCount)
+{
+    m_slots.fill(EMPTYSLOT, slotsCount);
+
+    m_shift = 64;
+    for (int size = slotsCount; size > 1; size >>= 1) {
+        --m_shift;
+    }
+
+    for (int i = 0; i < m_ids.count(); ++i) {
+        m_slots[slotOf(m_ids[i])] = i;
+    }
+}
+
+WindowInfoWrap &WindowsMap::operator[](const WindowId &wid)
+{
+    const qint64 id = wid.toLongLong();
+
+    //! keep the table at most half full
+    if ((m_ids.count() + 1) * 2 > m_slots.count()) {
+        rehash(qMax(MINSLOTS, m_slots.count() * 2));
+    }
+
+    const int slot = slotOf(id);
+
+    if (m_slots[slot] != EMPTYSLOT) {
+        return m_values[m_slots[slot]];
+    }
+
+    m_slots[slot] = m_ids.count();
+    m_ids.append(id);
+    m_keys.append(wid);
+    m_values.append(WindowInfoWrap());
+
+    return m_values.last();
+}
+
+const WindowInfoWrap &WindowsMap::operator[](const WindowId &wid) const
+{
+    static const WindowInfoWrap invalidInfo;
+
+    const int index = indexOf(wid.toLongLong());
+    return index == EMPTYSLOT ? invalidInfo : m_values[index];
+}
+
+void WindowsMap::remove(const WindowId &wid)
+{
+    const qint64 id = wid.toLongLong();
+    int hole = slotOf(id);
+
+    if (hole == EMPTYSLOT || m_slots[hole] == EMPTYSLOT) {
+        return;
+    }
+
+    const int index = m_slots[hole];
+    const int mask = m_slots.count() - 1;
+
+    //! backward shift deletion, no tombstones are needed for linear probing
+    for (int next = (hole + 1) & mask; m_slots[next] != EMPTYSLOT; next = (next + 1) & mask) {
+        const int ideal = idealSlot(m_ids[m_slots[next]]);
+
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+        }
+    }
+
+    m_slots[hole] = EMPTYSLOT;
+
+    //! move the last window in the removed window place
+    const int last = m_ids.count() - 1;
+
+    if (index != last) {
+        m_slots[slotOf(m_ids[last])] = index;
+
+        m_ids[index] = m_ids[last];
+        m_keys[index] = m_keys[last];
+        m_values[index] = std::move(m_values[last]);
+    }
+
+    m_ids.removeLast();
+    m_keys.removeLast();
+    m_values.removeLast();
+}
+
+const WindowId &WindowsMap::keyAt(int index) const
+{
+    return m_keys[index];
+}
+
+const WindowInfoWrap &WindowsMap::valueAt(int index) const
+{
+    return m_values[index];
+}
+
+WindowsMap::const_iterator WindowsMap::begin() const
+{
+    return m_values.constBegin();
+}
+
+WindowsMap::const_iterator WindowsMap::end() const
+{
+    return m_values.constEnd();
+}
+
+}
+}
+}
@@ -0,0 +1,84 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMWINDOWSMAP_H
+#define WINDOWSYSTEMWINDOWSMAP_H
+
+// local
+#include "../windowinfowrap.h"
+
+// Qt
+#include <QVector>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Open addressing hash map for the tracked windows. All window systems provide
+//! integral window ids (X11 WId, Wayland uint32) that are used directly as hash keys.
+//! Keys and windows information are stored contiguously and the hash table holds
+//! only their indexes, so iterating all windows walks a plain array. Removing a window
+//! moves the last window in its place, so no order is guaranteed during iteration.
+class WindowsMap
+{
+public:
+    using const_iterator = QVector<WindowInfoWrap>::const_iterator;
+
+    WindowsMap();
+
+    bool contains(const WindowId &wid) const;
+    int count() const;
+
+    void clear();
+    void remove(const WindowId &wid);
+
+    //! inserts a default window information when the window is not present
+    WindowInfoWrap &operator[](const WindowId &wid);
+    const WindowInfoWrap &operator[](const WindowId &wid) const;
+
+    const WindowId &keyAt(int index) const;
+    const WindowInfoWrap &valueAt(int index) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    int indexOf(const qint64 id) const;
+    int slotOf(const qint64 id) const;
+    int idealSlot(const qint64 id) const;
+
+    void rehash(const int slotsCount);
+
+private:
+    int m_shift{64};
+
+    //! dense storage
+    QVector<qint64> m_ids;
+    QVector<WindowId> m_keys;
+    QVector<WindowInfoWrap> m_values;
+
+    //! hash table with indexes to the dense storage
+    QVector<int> m_slots;
+};
+
+}
+}
+}
+
+#endif
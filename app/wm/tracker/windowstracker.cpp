@@ -24,14 +24,10 @@
 #include "schemes.h"
 #include "trackedlayoutinfo.h"
 #include "trackedviewinfo.h"
+#include "viewshost.h"
 #include "../abstractwindowinterface.h"
+#include "../perfcounters.h"
 #include "../schemecolors.h"
-#include "../../apptypes.h"
-#include "../../lattecorona.h"
-#include "../../layout/genericlayout.h"
-#include "../../layouts/manager.h"
-#include "../../view/view.h"
-#include "../../view/positioner.h"
 
 namespace Latte {
 namespace WindowSystem {
@@ -47,11 +43,27 @@ Windows::Windows(AbstractWindowInterface *parent)
 
     connect(&m_extraViewHintsTimer, &QTimer::timeout, this, &Windows::updateExtraViewHints);
 
+    //! hints are updated incrementally per window, a full update is triggered
+    //! afterwards in order to be sure that no hint was missed
+    m_hintsConsistencyTimer.setInterval(5000);
+    m_hintsConsistencyTimer.setSingleShot(true);
+
+    connect(&m_hintsConsistencyTimer, &QTimer::timeout, this, [&]() {
+        updateAllHints();
+    });
+
     //! delayed application data
     m_updateApplicationDataTimer.setInterval(1500);
     m_updateApplicationDataTimer.setSingleShot(true);
     connect(&m_updateApplicationDataTimer, &QTimer::timeout, this, &Windows::updateApplicationData);
 
+    //! views geometry changes are collected and their hints are updated together,
+    //! the timer is not restarted for upcoming changes in order for the hints
+    //! to follow a view that is still moving or resizing
+    m_viewsGeometryHintsTimer.setInterval(150);
+    m_viewsGeometryHintsTimer.setSingleShot(true);
+    connect(&m_viewsGeometryHintsTimer, &QTimer::timeout, this, &Windows::updateViewsGeometryHints);
+
     init();
 }
 
@@ -76,46 +88,48 @@ Windows::~Windows()
 
 void Windows::init()
 {
-    connect(m_wm->corona(), &Plasma::Corona::availableScreenRectChanged, this, &Windows::updateAvailableScreenGeometries);
-
     connect(m_wm, &AbstractWindowInterface::windowChanged, this, [&](WindowId wid) {
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
-
-        emit windowChanged(wid);
+        updateWindows({wid});
     });
 
+    connect(m_wm, &AbstractWindowInterface::windowsChanged, this, &Windows::updateWindows);
+
     connect(m_wm, &AbstractWindowInterface::windowRemoved, this, [&](WindowId wid) {
-        m_windows.remove(wid);
+        removeWindowInfo(wid);
 
         //! application data
         m_initializedApplicationData.removeAll(wid);
         m_delayedApplicationData.removeAll(wid);
 
-        updateAllHints();
+        updateAllHints({wid});
 
         emit windowRemoved(wid);
     });
 
     connect(m_wm, &AbstractWindowInterface::windowAdded, this, [&](WindowId wid) {
         if (!m_windows.contains(wid)) {
-            m_windows.insert(wid, m_wm->requestInfo(wid));
+            setWindowInfo(wid, m_wm->requestInfo(wid));
         }
-        updateAllHints();
+        updateAllHints({wid});
     });
 
     connect(m_wm, &AbstractWindowInterface::activeWindowChanged, this, [&](WindowId wid) {
         //! for some reason this is needed in order to update properly activeness values
         //! when the active window changes the previous active windows should be also updated
+        QList<WindowId> changedWindows;
+
         for (const auto view : m_views.keys()) {
             WindowId lastWinId = m_views[view]->lastActiveWindow()->winId();
-            if ((lastWinId) != wid && m_windows.contains(lastWinId)) {
-                m_windows[lastWinId] = m_wm->requestInfo(lastWinId);
+            if ((lastWinId) != wid && m_windows.contains(lastWinId) && !changedWindows.contains(lastWinId)) {
+                setWindowInfo(lastWinId, m_wm->requestInfo(lastWinId));
+                changedWindows << lastWinId;
             }
         }
 
-        m_windows[wid] = m_wm->requestInfo(wid);
-        updateAllHints();
+        setWindowInfo(wid, m_wm->requestInfo(wid));
+        changedWindows << wid;
+
+        updateAllHints(changedWindows);
 
         emit activeWindowChanged(wid);
     });
@@ -125,7 +139,7 @@ void Windows::init()
     });
 
     connect(m_wm, &AbstractWindowInterface::currentActivityChanged, this, [&] {
-        if (m_wm->corona()->layoutsManager()->memoryUsage() == MemoryUsage::MultipleLayouts) {
+        if (m_viewsHost && m_viewsHost->hasMultipleLayouts()) {
             //! this is needed in MultipleLayouts because there is a chance that multiple
             //! layouts are providing different available screen geometries in different Activities
             updateAvailableScreenGeometries();
@@ -135,6 +149,21 @@ void Windows::init()
     });
 }
 
+void Windows::updateWindows(const QList<WindowId> &wids)
+{
+    //! requestInfos() provides exactly the same information as requestInfo()
+    //! but for all changed windows at once
+    const QList<WindowInfoWrap> winfos = m_wm->requestInfos(wids);
+
+    for (int i = 0; i < wids.count(); ++i) {
+        setWindowInfo(wids[i], winfos[i]);
+    }
+
+    updateAllHints(wids);
+
+    emit windowsChanged(wids);
+}
+
 void Windows::initLayoutHints(Latte::Layout::GenericLayout *layout)
 {
     if (!m_layouts.contains(layout)) {
@@ -170,13 +199,45 @@ AbstractWindowInterface *Windows::wm()
     return m_wm;
 }
 
+ViewsHost *Windows::viewsHost() const
+{
+    return m_viewsHost;
+}
+
+void Windows::setViewsHost(ViewsHost *host)
+{
+    if (m_viewsHost == host) {
+        return;
+    }
+
+    if (m_viewsHost) {
+        disconnect(m_viewsHost, nullptr, this, nullptr);
+    }
+
+    m_viewsHost = host;
+
+    connect(m_viewsHost, &ViewsHost::availableScreenGeometriesChanged, this, &Windows::updateAvailableScreenGeometries);
+
+    connect(m_viewsHost, &ViewsHost::viewLayoutChanged, this, [&](Latte::View *view) {
+        if (m_views.contains(view)) {
+            addRelevantLayout(view);
+        }
+    });
+
+    connect(m_viewsHost, &ViewsHost::viewIsTouchingViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
+
+    //! windows hints for the view must be recalculated when its geometry changes
+    connect(m_viewsHost, &ViewsHost::viewGeometryChanged, this, &Windows::considerViewGeometryChanged);
+}
+
 
 void Windows::addView(Latte::View *view)
 {
-    if (m_views.contains(view)) {
+    if (!m_viewsHost || m_views.contains(view)) {
         return;
     }
 
+    m_viewsHost->trackView(view);
     m_views[view] = new TrackedViewInfo(this, view);
 
     updateAvailableScreenGeometries();
@@ -184,13 +245,6 @@ void Windows::addView(Latte::View *view)
     //! Consider Layouts
     addRelevantLayout(view);
 
-    connect(view, &Latte::View::layoutChanged, this, [&, view]() {
-        addRelevantLayout(view);
-    });
-
-    connect(view, &Latte::View::isTouchingBottomViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
-    connect(view, &Latte::View::isTouchingTopViewAndIsBusyChanged, this, &Windows::updateExtraViewHints);
-
     updateAllHints();
 
     emit informationAnnounced(view);
@@ -202,20 +256,53 @@ void Windows::removeView(Latte::View *view)
         return;
     }
 
+    m_viewsHost->untrackView(view);
     m_views[view]->deleteLater();
     m_views.remove(view);
+    m_viewsGeometryChanged.removeAll(view);
 
+    releaseUnusedScreens();
     updateRelevantLayouts();
 }
 
+void Windows::considerViewGeometryChanged(Latte::View *view)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    if (!m_viewsGeometryChanged.contains(view)) {
+        m_viewsGeometryChanged << view;
+    }
+
+    if (!m_viewsGeometryHintsTimer.isActive()) {
+        m_viewsGeometryHintsTimer.start();
+    }
+}
+
+void Windows::updateViewsGeometryHints()
+{
+    QList<Latte::View *> views;
+    views.swap(m_viewsGeometryChanged);
+
+    for (const auto view : views) {
+        if (m_views.contains(view)) {
+            updateHints(view);
+        }
+    }
+}
+
 void Windows::addRelevantLayout(Latte::View *view)
 {
-    if (view->layout()) {
+    Latte::Layout::GenericLayout *layout = m_viewsHost->layout(view);
+
+    if (layout) {
         bool initializing {false};
 
-        if (!m_layouts.contains(view->layout())) {
+        if (!m_layouts.contains(layout)) {
             initializing = true;
-            m_layouts[view->layout()] = new TrackedLayoutInfo(this, view->layout());
+            m_viewsHost->trackLayout(layout);
+            m_layouts[layout] = new TrackedLayoutInfo(this, layout);
         }
 
         //! Update always the AllScreens tracking because there is a chance a view delayed to be assigned in a layout
@@ -224,8 +311,8 @@ void Windows::addRelevantLayout(Latte::View *view)
         updateRelevantLayouts();
 
         if (initializing) {
-            updateHints(view->layout());
-            emit informationAnnouncedForLayout(view->layout());
+            updateHints(layout);
+            emit informationAnnouncedForLayout(layout);
         }
     }
 }
@@ -238,7 +325,7 @@ void Windows::updateRelevantLayouts()
     for (QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *>::iterator i=m_layouts.begin(); i!=m_layouts.end(); ++i) {
         bool hasView{false};
         for (QHash<Latte::View *, TrackedViewInfo *>::iterator j=m_views.begin(); j!=m_views.end(); ++j) {
-            if (j.key() && i.key() && i.key() == j.key()->layout()) {
+            if (j.key() && i.key() && i.key() == m_viewsHost->layout(j.key())) {
                 hasView = true;
                 break;
             }
@@ -253,6 +340,7 @@ void Windows::updateRelevantLayouts()
     }
 
     for(const auto &layout : orphanedLayouts) {
+        m_viewsHost->untrackLayout(layout);
         m_layouts.remove(layout);
     }
 
@@ -260,7 +348,7 @@ void Windows::updateRelevantLayouts()
     for (QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *>::iterator i=m_layouts.begin(); i!=m_layouts.end(); ++i) {
         bool hasViewEnabled{false};
         for (QHash<Latte::View *, TrackedViewInfo *>::iterator j=m_views.begin(); j!=m_views.end(); ++j) {
-            if (i.key() == j.key()->layout() && j.value()->enabled()) {
+            if (i.key() == m_viewsHost->layout(j.key()) && j.value()->enabled()) {
                 hasViewEnabled = true;
                 break;
             }
@@ -627,6 +715,11 @@ QIcon Windows::iconFor(const WindowId &wid)
             icon = m_wm->iconFor(wid);
         }
 
+        //! icons are cached per application name
+        if (m_windows[wid].appName().isEmpty()) {
+            m_windows[wid].setAppName(data.name);
+        }
+
         m_windows[wid].setIcon(icon);
         return icon;
     }
@@ -658,6 +751,8 @@ QString Windows::appNameFor(const WindowId &wid)
 
 void Windows::updateApplicationData()
 {
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateApplicationData, m_delayedApplicationData.count());
+
     if (m_delayedApplicationData.count() > 0) {
         for(int i=0; i<m_delayedApplicationData.count(); ++i) {
             auto wid = m_delayedApplicationData[i];
@@ -671,8 +766,8 @@ void Windows::updateApplicationData()
                     icon = m_wm->iconFor(wid);
                 }
 
-                m_windows[wid].setIcon(icon);
                 m_windows[wid].setAppName(data.name);
+                m_windows[wid].setIcon(icon);
 
                 m_initializedApplicationData.append(wid);
 
@@ -693,12 +788,55 @@ WindowInfoWrap Windows::infoFor(const WindowId &wid) const
     return m_windows[wid];
 }
 
+void Windows::addWindowsInfo(const QList<WindowInfoWrap> &winfos)
+{
+    for (const auto &winfo : winfos) {
+        if (winfo.isValid() && !m_windows.contains(winfo.wid())) {
+            setWindowInfo(winfo.wid(), winfo);
+        }
+    }
+}
+
+void Windows::setWindowInfo(const WindowId &wid, const WindowInfoWrap &winfo)
+{
+    if (winfo.appName().isEmpty() && m_windows.contains(wid)) {
+        //! window system requests do not provide application data,
+        //! they are kept from the already tracked window
+        const WindowInfoWrap current = m_windows[wid];
+
+        m_windows[wid] = winfo;
+        m_windows[wid].setAppName(current.appName());
+        m_windows[wid].setIcon(current.icon());
+    } else {
+        m_windows[wid] = winfo;
+    }
+
+    m_windowsIndex.insert(wid, winfo.geometry());
+
+    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
+    //! such windows are removed during the next hints update
+    if (isFaulty(winfo)) {
+        m_existsFaultyWindow = true;
+    }
+}
+
+void Windows::removeWindowInfo(const WindowId &wid)
+{
+    m_windows.remove(wid);
+    m_windowsIndex.remove(wid);
+}
+
 
 
 //! Windows Criteria Functions
+bool Windows::isFaulty(const WindowInfoWrap &winfo) const
+{
+    return (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0));
+}
+
 bool Windows::intersects(Latte::View *view, const WindowInfoWrap &winfo)
 {
-    return (!winfo.isMinimized() && !winfo.isShaded() && winfo.geometry().intersects(view->absoluteGeometry()));
+    return (!winfo.isMinimized() && !winfo.isShaded() && winfo.geometry().intersects(m_viewsHost->absoluteGeometry(view)));
 }
 
 bool Windows::isActive(const WindowInfoWrap &winfo)
@@ -733,39 +871,43 @@ bool Windows::isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo)
         bool inViewThicknessEdge{false};
         bool inViewLengthBoundaries{false};
 
-        QRect screenGeometry = view->screenGeometry();
+        QRect screenGeometry = m_viewsHost->screenGeometry(view);
 
         bool inCurrentScreen{screenGeometry.contains(winfo.geometry().topLeft()) || screenGeometry.contains(winfo.geometry().bottomRight())};
 
         if (inCurrentScreen) {
-            if (view->location() == Plasma::Types::TopEdge) {
-                inViewThicknessEdge = (winfo.geometry().y() == view->absoluteGeometry().bottom() + 1);
-            } else if (view->location() == Plasma::Types::BottomEdge) {
-                inViewThicknessEdge = (winfo.geometry().bottom() == view->absoluteGeometry().top() - 1);
-            } else if (view->location() == Plasma::Types::LeftEdge) {
-                inViewThicknessEdge = (winfo.geometry().x() == view->absoluteGeometry().right() + 1);
-            } else if (view->location() == Plasma::Types::RightEdge) {
-                inViewThicknessEdge = (winfo.geometry().right() == view->absoluteGeometry().left() - 1);
+            const QRect viewGeometry = m_viewsHost->absoluteGeometry(view);
+            const Plasma::Types::Location location = m_viewsHost->location(view);
+            const Plasma::Types::FormFactor formFactor = m_viewsHost->formFactor(view);
+
+            if (location == Plasma::Types::TopEdge) {
+                inViewThicknessEdge = (winfo.geometry().y() == viewGeometry.bottom() + 1);
+            } else if (location == Plasma::Types::BottomEdge) {
+                inViewThicknessEdge = (winfo.geometry().bottom() == viewGeometry.top() - 1);
+            } else if (location == Plasma::Types::LeftEdge) {
+                inViewThicknessEdge = (winfo.geometry().x() == viewGeometry.right() + 1);
+            } else if (location == Plasma::Types::RightEdge) {
+                inViewThicknessEdge = (winfo.geometry().right() == viewGeometry.left() - 1);
             }
 
-            if (view->formFactor() == Plasma::Types::Horizontal) {
-                int yCenter = view->absoluteGeometry().center().y();
+            if (formFactor == Plasma::Types::Horizontal) {
+                int yCenter = viewGeometry.center().y();
 
                 QPoint leftChecker(winfo.geometry().left(), yCenter);
                 QPoint rightChecker(winfo.geometry().right(), yCenter);
 
-                bool fulloverlap = (winfo.geometry().left()<=view->absoluteGeometry().left()) && (winfo.geometry().right()>=view->absoluteGeometry().right());
+                bool fulloverlap = (winfo.geometry().left()<=viewGeometry.left()) && (winfo.geometry().right()>=viewGeometry.right());
 
-                inViewLengthBoundaries = fulloverlap || view->absoluteGeometry().contains(leftChecker) || view->absoluteGeometry().contains(rightChecker);
-            } else if (view->formFactor() == Plasma::Types::Vertical) {
-                int xCenter = view->absoluteGeometry().center().x();
+                inViewLengthBoundaries = fulloverlap || viewGeometry.contains(leftChecker) || viewGeometry.contains(rightChecker);
+            } else if (formFactor == Plasma::Types::Vertical) {
+                int xCenter = viewGeometry.center().x();
 
                 QPoint topChecker(xCenter, winfo.geometry().top());
                 QPoint bottomChecker(xCenter, winfo.geometry().bottom());
 
-                bool fulloverlap = (winfo.geometry().top()<=view->absoluteGeometry().top()) && (winfo.geometry().bottom()>=view->absoluteGeometry().bottom());
+                bool fulloverlap = (winfo.geometry().top()<=viewGeometry.top()) && (winfo.geometry().bottom()>=viewGeometry.bottom());
 
-                inViewLengthBoundaries = fulloverlap || view->absoluteGeometry().contains(topChecker) || view->absoluteGeometry().contains(bottomChecker);
+                inViewLengthBoundaries = fulloverlap || viewGeometry.contains(topChecker) || viewGeometry.contains(bottomChecker);
             }
         }
 
@@ -777,24 +919,39 @@ bool Windows::isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo)
 
 void Windows::cleanupFaultyWindows()
 {
-    for (const auto &key : m_windows.keys()) {
-        auto winfo = m_windows[key];
-
+    //! removing a window moves the last one in its place, so iterate backwards
+    for (int i = m_windows.count() - 1; i >= 0; --i) {
         //! garbage windows removing
-        if (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0)) {
-            //qDebug() << "Faulty Geometry ::: " << winfo.wid();
-            m_windows.remove(key);
+        if (isFaulty(m_windows.valueAt(i))) {
+            //qDebug() << "Faulty Geometry ::: " << m_windows.valueAt(i).wid();
+            const WindowId wid = m_windows.keyAt(i);
+            removeWindowInfo(wid);
         }
     }
+
+    m_existsFaultyWindow = false;
+}
+
+void Windows::releaseUnusedScreens()
+{
+    QList<QRect> screenGeometries;
+
+    for (const auto view : m_views.keys()) {
+        screenGeometries << m_viewsHost->screenGeometry(view);
+    }
+
+    m_windowsIndex.releaseScreensExcept(screenGeometries);
 }
 
 
 void Windows::updateAvailableScreenGeometries()
 {
+    releaseUnusedScreens();
+
     for (const auto view : m_views.keys()) {
         if (m_views[view]->enabled()) {
-            int currentScrId = view->positioner()->currentScreenId();
-            QRect tempAvailableScreenGeometry = m_wm->corona()->availableScreenRectWithCriteria(currentScrId, QString(), m_ignoreModes, {});
+            int currentScrId = m_viewsHost->screenId(view);
+            QRect tempAvailableScreenGeometry = m_viewsHost->availableScreenGeometry(currentScrId, m_ignoreModes);
 
             if (tempAvailableScreenGeometry != m_views[view]->availableScreenGeometry()) {
                 m_views[view]->setAvailableScreenGeometry(tempAvailableScreenGeometry);
@@ -820,14 +977,41 @@ void Windows::updateAllHints()
     }
 }
 
+void Windows::updateAllHints(const QList<WindowId> &wids)
+{
+    if (m_existsFaultyWindow) {
+        //! faulty windows removal can affect any view or layout
+        updateAllHints();
+        return;
+    }
+
+    for (const auto view : m_views.keys()) {
+        updateHints(view, wids);
+    }
+
+    for (const auto layout : m_layouts.keys()) {
+        updateHints(layout, wids);
+    }
+
+    if (!m_extraViewHintsTimer.isActive()) {
+        m_extraViewHintsTimer.start();
+    }
+
+    if (!m_hintsConsistencyTimer.isActive()) {
+        m_hintsConsistencyTimer.start();
+    }
+}
+
 void Windows::updateExtraViewHints()
 {
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateExtraViewHints);
+
     for (const auto horView : m_views.keys()) {
         if (!m_views.contains(horView) || !m_views[horView]->enabled() || !m_views[horView]->isTrackingCurrentActivity()) {
             continue;
         }
 
-        if (horView->formFactor() == Plasma::Types::Horizontal) {
+        if (m_viewsHost->formFactor(horView) == Plasma::Types::Horizontal) {
             bool touchingBusyVerticalView{false};
 
             for (const auto verView : m_views.keys()) {
@@ -835,11 +1019,11 @@ void Windows::updateExtraViewHints()
                     continue;
                 }
 
-                bool sameScreen = (verView->positioner()->currentScreenId() == horView->positioner()->currentScreenId());
+                bool sameScreen = (m_viewsHost->screenId(verView) == m_viewsHost->screenId(horView));
 
-                if (verView->formFactor() == Plasma::Types::Vertical && sameScreen) {
-                    bool topTouch = verView->isTouchingTopViewAndIsBusy() && horView->location() == Plasma::Types::TopEdge;
-                    bool bottomTouch = verView->isTouchingBottomViewAndIsBusy() && horView->location() == Plasma::Types::BottomEdge;
+                if (m_viewsHost->formFactor(verView) == Plasma::Types::Vertical && sameScreen) {
+                    bool topTouch = m_viewsHost->isTouchingTopViewAndIsBusy(verView) && m_viewsHost->location(horView) == Plasma::Types::TopEdge;
+                    bool bottomTouch = m_viewsHost->isTouchingBottomViewAndIsBusy(verView) && m_viewsHost->location(horView) == Plasma::Types::BottomEdge;
 
                     if (topTouch || bottomTouch) {
                         touchingBusyVerticalView = true;
@@ -855,13 +1039,131 @@ void Windows::updateExtraViewHints()
     }
 }
 
+int Windows::viewHintsFor(Latte::View *view, const WindowInfoWrap &winfo)
+{
+    if (!m_wm->inCurrentDesktopActivity(winfo)
+            || m_wm->hasBlockedTracking(winfo.wid())
+            || winfo.isMinimized()) {
+        return NoHint;
+    }
+
+    int hints{NoHint};
+
+    if (isActiveInViewScreen(view, winfo)) {
+        hints |= ActiveInScreenHint;
+    }
+
+    if (isMaximizedInViewScreen(view, winfo)) {
+        hints |= MaximizedHint;
+    }
+
+    if (isTouchingView(view, winfo)) {
+        hints |= TouchingHint;
+    }
+
+    if (isTouchingViewEdge(view, winfo)) {
+        hints |= TouchingEdgeHint;
+    }
+
+    //! activeness matters only for windows that are relevant to the view
+    if (hints != NoHint && winfo.isActive()) {
+        hints |= ActiveHint;
+    }
+
+    return hints;
+}
+
+int Windows::layoutHintsFor(const WindowInfoWrap &winfo)
+{
+    if (!m_wm->inCurrentDesktopActivity(winfo)
+            || m_wm->hasBlockedTracking(winfo.wid())
+            || winfo.isMinimized()) {
+        return NoHint;
+    }
+
+    int hints{NoHint};
+
+    if (isActive(winfo)) {
+        hints |= ActiveHint;
+    }
+
+    if (winfo.isMaximized()) {
+        hints |= MaximizedHint;
+    }
+
+    return hints;
+}
+
 void Windows::updateHints(Latte::View *view)
 {
-    if (!m_views.contains(view) || !m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+    if (!m_views.contains(view)) {
         return;
     }
 
-    bool foundActive{false};
+    if (!m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+        m_views[view]->invalidateHintWindows();
+        return;
+    }
+
+    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
+    //! maybe a garbage collector here is a good idea!!!
+    if (m_existsFaultyWindow) {
+        cleanupFaultyWindows();
+    }
+
+    //! all view criteria require windows that are present in the view screen
+    const QList<WindowId> screenWindows = m_windowsIndex.windowsIn(m_viewsHost->screenGeometry(view));
+
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateHints, screenWindows.count());
+
+    m_views[view]->resetHintWindows();
+
+    for (const auto &wid : screenWindows) {
+        m_views[view]->setWindowHints(wid, viewHintsFor(view, m_windows[wid]));
+    }
+
+    applyHints(view);
+}
+
+void Windows::updateHints(Latte::View *view, const QList<WindowId> &wids)
+{
+    if (!m_views.contains(view)) {
+        return;
+    }
+
+    if (!m_views[view]->enabled() || !m_views[view]->isTrackingCurrentActivity()) {
+        m_views[view]->invalidateHintWindows();
+        return;
+    }
+
+    if (!m_views[view]->hintWindowsAreValid()) {
+        updateHints(view);
+        return;
+    }
+
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateHints, wids.count());
+
+    bool hintsChanged{false};
+
+    for (const auto &wid : wids) {
+        int hints = m_windows.contains(wid) ? viewHintsFor(view, m_windows[wid]) : NoHint;
+
+        if (hints == NoHint && !m_views[view]->isHintWindow(wid)) {
+            //! window was and still is irrelevant to the view
+            continue;
+        }
+
+        m_views[view]->setWindowHints(wid, hints);
+        hintsChanged = true;
+    }
+
+    if (hintsChanged) {
+        applyHints(view);
+    }
+}
+
+void Windows::applyHints(Latte::View *view)
+{
     bool foundActiveInCurScreen{false};
     bool foundActiveTouchInCurScreen{false};
     bool foundActiveEdgeTouchInCurScreen{false};
@@ -871,10 +1173,6 @@ void Windows::updateHints(Latte::View *view)
 
     bool foundActiveGroupTouchInCurScreen{false};
 
-    //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
-    //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
-
     WindowId maxWinId;
     WindowId activeWinId;
     WindowId touchWinId;
@@ -884,99 +1182,63 @@ void Windows::updateHints(Latte::View *view)
 
     //qDebug() << " -- TRACKING REPORT (SCREEN)--";
 
-    //! First Pass
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
+    //! First Pass, only windows that fulfill at least one criterium are checked
+    const QMap<WindowId, int> hintWindows = m_views[view]->hintWindows();
 
-        if ( !m_wm->inCurrentDesktopActivity(winfo)
-             || m_wm->hasBlockedTracking(winfo.wid())
-             || winfo.isMinimized()) {
-            continue;
-        }
+    for (auto i = hintWindows.constBegin(); i != hintWindows.constEnd(); ++i) {
+        const WindowId &wid = i.key();
+        const int hints = i.value();
 
-        //qDebug() << " _ _ _ ";
-        //qDebug() << "TRACKING | WINDOW INFO :: " << winfo.wid() << " _ " << winfo.appName() << " _ " << winfo.geometry() << " _ " << winfo.display();
-
-        if (isActive(winfo)) {
-            foundActive = true;
-        }
-
-        if (isActiveInViewScreen(view, winfo)) {
+        if (hints & ActiveInScreenHint) {
             foundActiveInCurScreen = true;
-            activeWinId = winfo.wid();
+            activeWinId = wid;
         }
 
         //! Maximized windows flags
-        if ((winfo.isActive() && isMaximizedInViewScreen(view, winfo)) //! active maximized windows have higher priority than the rest maximized windows
-                || (!foundMaximizedInCurScreen && isMaximizedInViewScreen(view, winfo))) {
+        if (((hints & ActiveHint) && (hints & MaximizedHint)) //! active maximized windows have higher priority than the rest maximized windows
+                || (!foundMaximizedInCurScreen && (hints & MaximizedHint))) {
             foundMaximizedInCurScreen = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
 
         //! Touching windows flags
-
-        bool touchingViewEdge = isTouchingViewEdge(view, winfo);
-        bool touchingView =  isTouchingView(view, winfo);
-
-        if (touchingView) {
-            if (winfo.isActive()) {
+        if (hints & TouchingHint) {
+            if (hints & ActiveHint) {
                 foundActiveTouchInCurScreen = true;
-                activeTouchWinId = winfo.wid();
+                activeTouchWinId = wid;
             } else {
                 foundTouchInCurScreen = true;
-                touchWinId = winfo.wid();
+                touchWinId = wid;
             }
         }
 
-        if (touchingViewEdge) {
-            if (winfo.isActive()) {
+        if (hints & TouchingEdgeHint) {
+            if (hints & ActiveHint) {
                 foundActiveEdgeTouchInCurScreen = true;
-                activeTouchEdgeWinId = winfo.wid();
+                activeTouchEdgeWinId = wid;
             } else {
                 foundTouchEdgeInCurScreen = true;
-                touchEdgeWinId = winfo.wid();
+                touchEdgeWinId = wid;
             }
         }
-
-        //qDebug() << "TRACKING |       ACTIVE:"<< foundActive <<  " ACT_CUR_SCR:" << foundTouchInCurScreen << " MAXIM:"<<foundMaximizedInCurScreen;
-        //qDebug() << "TRACKING |       TOUCHING VIEW EDGE:"<< touchingViewEdge << " TOUCHING VIEW:" << foundTouchInCurScreen;
-    }
-
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
     }
 
     //! PASS 2
     if (foundActiveInCurScreen && !foundActiveTouchInCurScreen) {
         //! Second Pass to track also Child windows if needed
-
-        //qDebug() << "Windows Array...";
-        //for (const auto &winfo : m_windows) {
-        //    qDebug() << " - " << winfo.wid() << " - " << winfo.isValid() << " - " << winfo.display() << " - " << winfo.geometry() << " parent : " << winfo.parentId();
-        //}
-        //qDebug() << " - - - - - ";
-
         WindowInfoWrap activeInfo = m_windows[activeWinId];
         WindowId mainWindowId = activeInfo.isChildWindow() ? activeInfo.parentId() : activeWinId;
 
-        for (const auto &winfo : m_windows) {
-            if (!m_wm->inCurrentDesktopActivity(winfo)
-                    || m_wm->hasBlockedTracking(winfo.wid())
-                    || winfo.isMinimized()) {
+        for (auto i = hintWindows.constBegin(); i != hintWindows.constEnd(); ++i) {
+            if (!(i.value() & TouchingHint)) {
                 continue;
             }
 
-            bool inActiveGroup = (winfo.wid() == mainWindowId || winfo.parentId() == mainWindowId);
+            const WindowInfoWrap &winfo = m_windows[i.key()];
 
             //! consider only windows that belong to active window group meaning the main window
             //! and its children
-            if (!inActiveGroup) {
-                continue;
-            }
-
-            if (isTouchingView(view, winfo)) {
+            if (winfo.wid() == mainWindowId || winfo.parentId() == mainWindowId) {
                 foundActiveGroupTouchInCurScreen = true;
                 break;
             }
@@ -1035,53 +1297,100 @@ void Windows::updateHints(Latte::View *view)
     //qDebug() << "TRACKING | existsActiveGroupTouching: " << foundActiveGroupTouchInCurScreen;
 }
 
-void Windows::updateHints(Latte::Layout::GenericLayout *layout) {
-    if (!m_layouts.contains(layout) || !m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+void Windows::updateHints(Latte::Layout::GenericLayout *layout)
+{
+    if (!m_layouts.contains(layout)) {
         return;
     }
 
-    bool foundActive{false};
-    bool foundActiveMaximized{false};
-    bool foundMaximized{false};
+    if (!m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+        m_layouts[layout]->invalidateHintWindows();
+        return;
+    }
 
     //! the notification window is not sending a remove signal and creates windows of geometry (0x0 0,0),
     //! maybe a garbage collector here is a good idea!!!
-    bool existsFaultyWindow{false};
+    if (m_existsFaultyWindow) {
+        cleanupFaultyWindows();
+    }
 
-    WindowId activeWinId;
-    WindowId maxWinId;
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateHints, m_windows.count());
 
-    for (const auto &winfo : m_windows) {
-        if (!existsFaultyWindow && (winfo.wid()<=0 || winfo.geometry() == QRect(0, 0, 0, 0))) {
-            existsFaultyWindow = true;
-        }
+    m_layouts[layout]->resetHintWindows();
+
+    for (int i = 0; i < m_windows.count(); ++i) {
+        m_layouts[layout]->setWindowHints(m_windows.keyAt(i), layoutHintsFor(m_windows.valueAt(i)));
+    }
+
+    applyHints(layout);
+}
+
+void Windows::updateHints(Latte::Layout::GenericLayout *layout, const QList<WindowId> &wids)
+{
+    if (!m_layouts.contains(layout)) {
+        return;
+    }
+
+    if (!m_layouts[layout]->enabled() || !m_layouts[layout]->isTrackingCurrentActivity()) {
+        m_layouts[layout]->invalidateHintWindows();
+        return;
+    }
+
+    if (!m_layouts[layout]->hintWindowsAreValid()) {
+        updateHints(layout);
+        return;
+    }
+
+    PerfCounters::Probe probe(m_wm->perfCounters(), PerfCounters::TrackerUpdateHints, wids.count());
+
+    bool hintsChanged{false};
+
+    for (const auto &wid : wids) {
+        int hints = m_windows.contains(wid) ? layoutHintsFor(m_windows[wid]) : NoHint;
 
-        if (!m_wm->inCurrentDesktopActivity(winfo)
-                || m_wm->hasBlockedTracking(winfo.wid())
-                || winfo.isMinimized()) {
+        if (hints == NoHint && !m_layouts[layout]->isHintWindow(wid)) {
+            //! window was and still is irrelevant to the layout
             continue;
         }
 
-        if (isActive(winfo)) {
+        m_layouts[layout]->setWindowHints(wid, hints);
+        hintsChanged = true;
+    }
+
+    if (hintsChanged) {
+        applyHints(layout);
+    }
+}
+
+void Windows::applyHints(Latte::Layout::GenericLayout *layout)
+{
+    bool foundActive{false};
+    bool foundActiveMaximized{false};
+    bool foundMaximized{false};
+
+    WindowId activeWinId;
+    WindowId maxWinId;
+
+    const QMap<WindowId, int> hintWindows = m_layouts[layout]->hintWindows();
+
+    for (auto i = hintWindows.constBegin(); i != hintWindows.constEnd(); ++i) {
+        const WindowId &wid = i.key();
+        const int hints = i.value();
+
+        if (hints & ActiveHint) {
             foundActive = true;
-            activeWinId = winfo.wid();
+            activeWinId = wid;
 
-            if (winfo.isMaximized() && !winfo.isMinimized()) {
+            if (hints & MaximizedHint) {
                 foundActiveMaximized = true;
-                maxWinId = winfo.wid();
+                maxWinId = wid;
             }
         }
 
-        if (!foundActiveMaximized && winfo.isMaximized() && !winfo.isMinimized()) {
+        if (!foundActiveMaximized && (hints & MaximizedHint)) {
             foundMaximized = true;
-            maxWinId = winfo.wid();
+            maxWinId = wid;
         }
-
-        //qDebug() << "window geometry ::: " << winfo.geometry();
-    }
-
-    if (existsFaultyWindow) {
-        cleanupFaultyWindows();
     }
 
     //! HACK: KWin Effects such as ShowDesktop have no way to be identified and as such
@@ -22,6 +22,8 @@
 
 // local
 #include <coretypes.h>
+#include "windowsindex.h"
+#include "windowsmap.h"
 #include "../windowinfowrap.h"
 
 // Qt
@@ -29,6 +31,7 @@
 
 #include <QHash>
 #include <QMap>
+#include <QPointer>
 #include <QTimer>
 
 
@@ -44,6 +47,7 @@ namespace Tracker {
 class LastActiveWindow;
 class TrackedLayoutInfo;
 class TrackedViewInfo;
+class ViewsHost;
 }
 }
 }
@@ -92,8 +96,17 @@ public:
     QString appNameFor(const WindowId &wid);
     WindowInfoWrap infoFor(const WindowId &wid) const;
 
+    //! windows information that the window system has already requested in batch,
+    //! they are used instead of requesting them again when the windows are added
+    void addWindowsInfo(const QList<WindowInfoWrap> &winfos);
+
     AbstractWindowInterface *wm();
 
+    //! views and layouts information is provided through the host,
+    //! no views are tracked until a host has been set
+    ViewsHost *viewsHost() const;
+    void setViewsHost(ViewsHost *host);
+
 signals:
     //! Views
     void enabledChanged(const Latte::View *view);
@@ -120,31 +133,43 @@ signals:
     //! overloading WM signals in order to update first m_windows and afterwards
     //! inform consumers for window changes
     void activeWindowChanged(const WindowId &wid);
-    void windowChanged(const WindowId &wid);
+    void windowsChanged(const QList<WindowId> &wids);
     void windowRemoved(const WindowId &wid);
 
     void applicationDataChanged(const WindowId &wid);
 
 private slots:
     void updateAvailableScreenGeometries();
+    void updateWindows(const QList<WindowId> &wids);
 
     void addRelevantLayout(Latte::View *view);
 
     void updateApplicationData();
     void updateRelevantLayouts();
     void updateExtraViewHints();
+    void updateViewsGeometryHints();
 
 private:
     void init();
     void initLayoutHints(Latte::Layout::GenericLayout *layout);
     void initViewHints(Latte::View *view);
     void cleanupFaultyWindows();
+    void releaseUnusedScreens();
+    void considerViewGeometryChanged(Latte::View *view);
 
     void updateAllHints();
+    void updateAllHints(const QList<WindowId> &wids);
 
     //! Views
+    //! full update from all relevant windows
     void updateHints(Latte::View *view);
     void updateHints(Latte::Layout::GenericLayout *layout);
+    //! incremental update when only specific windows changed
+    void updateHints(Latte::View *view, const QList<WindowId> &wids);
+    void updateHints(Latte::Layout::GenericLayout *layout, const QList<WindowId> &wids);
+
+    void applyHints(Latte::View *view);
+    void applyHints(Latte::Layout::GenericLayout *layout);
 
     void setActiveWindowMaximized(Latte::View *view, bool activeMaximized);
     void setActiveWindowTouching(Latte::View *view, bool activeTouching);
@@ -164,6 +189,12 @@ private:
     void setActiveWindowScheme(Latte::Layout::GenericLayout *layout, WindowSystem::SchemeColors *scheme);
 
     //! Windows
+    void setWindowInfo(const WindowId &wid, const WindowInfoWrap &winfo);
+    void removeWindowInfo(const WindowId &wid);
+
+    bool isFaulty(const WindowInfoWrap &winfo) const;
+    int layoutHintsFor(const WindowInfoWrap &winfo);
+    int viewHintsFor(Latte::View *view, const WindowInfoWrap &winfo);
     bool intersects(Latte::View *view, const WindowInfoWrap &winfo);
     bool isActive(const WindowInfoWrap &winfo);
     bool isActiveInViewScreen(Latte::View *view, const WindowInfoWrap &winfo);
@@ -172,11 +203,30 @@ private:
     bool isTouchingViewEdge(Latte::View *view, const WindowInfoWrap &winfo);
 
 private:
+    //! criteria that a window fulfills for a view or layout
+    enum WindowHint {
+        NoHint = 0,
+        ActiveHint = 1,
+        ActiveInScreenHint = 2,
+        MaximizedHint = 4,
+        TouchingHint = 8,
+        TouchingEdgeHint = 16
+    };
+
     //! a timer in order to not overload the views extra hints checking because it is not
     //! really needed that often
     QTimer m_extraViewHintsTimer;
 
+    //! a timer in order to validate periodically the incremental hints updates
+    QTimer m_hintsConsistencyTimer;
+
+    //! a timer in order to update once the hints of views whose geometry changed
+    //! many times in a row, e.g. during their slide in/out animations
+    QTimer m_viewsGeometryHintsTimer;
+    QList<Latte::View *> m_viewsGeometryChanged;
+
     AbstractWindowInterface *m_wm;
+    QPointer<ViewsHost> m_viewsHost;
     QHash<Latte::View *, TrackedViewInfo *> m_views;
     QHash<Latte::Layout::GenericLayout *, TrackedLayoutInfo *> m_layouts;
 
@@ -193,7 +243,12 @@ private:
         Latte::Types::SidebarAutoHide
     };
 
-    QMap<WindowId, WindowInfoWrap> m_windows;
+    bool m_existsFaultyWindow{false};
+
+    WindowsMap m_windows;
+
+    //! windows per screen in order for views to check only the windows of their screen
+    WindowsIndex m_windowsIndex;
 
     //! Some applications delay their application name/icon identification
     //! such as Libreoffice that updates its StartupWMClass after
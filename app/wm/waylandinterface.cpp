@@ -848,6 +848,8 @@ bool WaylandInterface::isAcceptableWindow(const KWayland::Client::PlasmaWindow *
 
 void WaylandInterface::updateWindow()
 {
+    PerfCounters::Probe probe(perfCounters(), PerfCounters::WaylandUpdateWindow, 1);
+
     PlasmaWindow *pW = qobject_cast<PlasmaWindow*>(QObject::sender());
 
     if (isValidWindow(pW)) {
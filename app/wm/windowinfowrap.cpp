@@ -20,10 +20,122 @@
 
 #include "windowinfowrap.h"
 
+// Qt
+#include <QHash>
+#include <QVector>
+
 
 namespace Latte {
 namespace WindowSystem {
 
+namespace {
+//! process-wide pools for the interned window strings, id 0 is always the empty value.
+//! Values are reference counted by the windows information that use them and
+//! are dropped when the last one is released, their ids are reused afterwards
+template <typename T>
+class InternPool
+{
+public:
+    InternPool()
+    {
+        m_values << T();
+        m_refs << 0;
+        m_ids[T()] = 0;
+    }
+
+    quint32 acquire(const T &value)
+    {
+        auto it = m_ids.constFind(value);
+
+        if (it != m_ids.constEnd()) {
+            ref(it.value());
+            return it.value();
+        }
+
+        quint32 id;
+
+        if (!m_freeIds.isEmpty()) {
+            id = m_freeIds.takeLast();
+            m_values[id] = value;
+            m_refs[id] = 1;
+        } else {
+            id = m_values.count();
+            m_values << value;
+            m_refs << 1;
+        }
+
+        m_ids[value] = id;
+
+        return id;
+    }
+
+    void ref(const quint32 id)
+    {
+        if (id > 0) {
+            ++m_refs[id];
+        }
+    }
+
+    //! returns true when the value was dropped
+    bool release(const quint32 id)
+    {
+        if (id == 0 || --m_refs[id] > 0) {
+            return false;
+        }
+
+        m_ids.remove(m_values[id]);
+        m_values[id] = T();
+        m_freeIds << id;
+
+        return true;
+    }
+
+    const T &value(const quint32 id) const
+    {
+        return m_values[id];
+    }
+
+private:
+    QVector<T> m_values;
+    QVector<quint32> m_refs;
+    QVector<quint32> m_freeIds;
+    QHash<T, quint32> m_ids;
+};
+
+InternPool<QString> &appNamesPool()
+{
+    static InternPool<QString> pool;
+    return pool;
+}
+
+InternPool<QStringList> &stringListsPool()
+{
+    static InternPool<QStringList> pool;
+    return pool;
+}
+
+//! application icons, keyed by interned application name,
+//! they live as long as their application name is used
+QHash<quint32, QIcon> &iconsCache()
+{
+    static QHash<quint32, QIcon> cache;
+    return cache;
+}
+
+void releaseAppName(const quint32 id)
+{
+    if (appNamesPool().release(id)) {
+        iconsCache().remove(id);
+    }
+}
+
+bool isSameIcon(const QIcon &icon1, const QIcon &icon2)
+{
+    return (icon1.cacheKey() == icon2.cacheKey())
+            || (!icon1.name().isEmpty() && icon1.name() == icon2.name());
+}
+}
+
 WindowInfoWrap::WindowInfoWrap()
 {
 }
@@ -31,103 +143,76 @@ WindowInfoWrap::WindowInfoWrap()
 WindowInfoWrap::WindowInfoWrap(const WindowInfoWrap &o)
     : m_wid(o.m_wid)
     , m_parentId(o.m_parentId)
+    , m_widType(o.m_widType)
+    , m_parentIdType(o.m_parentIdType)
     , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
+    , m_flags(o.m_flags)
+    , m_appNameId(o.m_appNameId)
+    , m_desktopsId(o.m_desktopsId)
+    , m_activitiesId(o.m_activitiesId)
     , m_display(o.m_display)
+    , m_icon(o.m_icon)
 {
+    appNamesPool().ref(m_appNameId);
+    stringListsPool().ref(m_desktopsId);
+    stringListsPool().ref(m_activitiesId);
 }
 
 WindowInfoWrap::WindowInfoWrap(WindowInfoWrap &&o)
     : m_wid(o.m_wid)
     , m_parentId(o.m_parentId)
+    , m_widType(o.m_widType)
+    , m_parentIdType(o.m_parentIdType)
     , m_geometry(o.m_geometry)
-    , m_isValid(o.m_isValid)
-    , m_isActive(o.m_isActive)
-    , m_isMinimized(o.m_isMinimized)
-    , m_isMaxVert(o.m_isMaxVert)
-    , m_isMaxHoriz(o.m_isMaxHoriz)
-    , m_isFullscreen(o.m_isFullscreen)
-    , m_isShaded(o.m_isShaded)
-    , m_isKeepAbove(o.m_isKeepAbove)
-    , m_isKeepBelow(o.m_isKeepBelow)
-    , m_hasSkipPager(o.m_hasSkipPager)
-    , m_hasSkipSwitcher(o.m_hasSkipSwitcher)
-    , m_hasSkipTaskbar(o.m_hasSkipTaskbar)
-    , m_isOnAllDesktops(o.m_isOnAllDesktops)
-    , m_isOnAllActivities(o.m_isOnAllActivities)
-    , m_isClosable(o.m_isClosable)
-    , m_isFullScreenable(o.m_isFullScreenable)
-    , m_isGroupable(o.m_isGroupable)
-    , m_isMaximizable(o.m_isMaximizable)
-    , m_isMinimizable(o.m_isMinimizable)
-    , m_isMovable(o.m_isMovable)
-    , m_isResizable(o.m_isResizable)
-    , m_isShadeable(o.m_isShadeable)
-    , m_isVirtualDesktopsChangeable(o.m_isVirtualDesktopsChangeable)
-    , m_desktops(o.m_desktops)
-    , m_activities(o.m_activities)
-    , m_display(o.m_display)
+    , m_flags(o.m_flags)
+    , m_appNameId(o.m_appNameId)
+    , m_desktopsId(o.m_desktopsId)
+    , m_activitiesId(o.m_activitiesId)
+    , m_display(std::move(o.m_display))
+    , m_icon(std::move(o.m_icon))
 {
+    //! the interned values references are taken over
+    o.m_appNameId = 0;
+    o.m_desktopsId = 0;
+    o.m_activitiesId = 0;
+}
+
+WindowInfoWrap::~WindowInfoWrap()
+{
+    releaseAppName(m_appNameId);
+    stringListsPool().release(m_desktopsId);
+    stringListsPool().release(m_activitiesId);
 }
 
 //! Operators
 // BEGIN: definitions
 WindowInfoWrap &WindowInfoWrap::operator=(WindowInfoWrap &&rhs)
 {
+    if (this == &rhs) {
+        return *this;
+    }
+
     m_wid = rhs.m_wid;
     m_parentId = rhs.m_parentId;
+    m_widType = rhs.m_widType;
+    m_parentIdType = rhs.m_parentIdType;
     m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
+    m_flags = rhs.m_flags;
 
-    m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
+    m_display = std::move(rhs.m_display);
+    m_icon = std::move(rhs.m_icon);
+
+    releaseAppName(m_appNameId);
+    stringListsPool().release(m_desktopsId);
+    stringListsPool().release(m_activitiesId);
+
+    m_appNameId = rhs.m_appNameId;
+    m_desktopsId = rhs.m_desktopsId;
+    m_activitiesId = rhs.m_activitiesId;
+
+    rhs.m_appNameId = 0;
+    rhs.m_desktopsId = 0;
+    rhs.m_activitiesId = 0;
     return *this;
 }
 
@@ -135,263 +220,269 @@ WindowInfoWrap &WindowInfoWrap::operator=(const WindowInfoWrap &rhs)
 {
     m_wid = rhs.m_wid;
     m_parentId = rhs.m_parentId;
+    m_widType = rhs.m_widType;
+    m_parentIdType = rhs.m_parentIdType;
     m_geometry = rhs.m_geometry;
-    m_isValid = rhs.m_isValid;
-    m_isActive = rhs.m_isActive;
-    m_isMinimized = rhs.m_isMinimized;
-    m_isMaxVert = rhs.m_isMaxVert;
-    m_isMaxHoriz = rhs.m_isMaxHoriz;
-    m_isFullscreen = rhs.m_isFullscreen;
-    m_isShaded = rhs.m_isShaded;
-    m_isKeepAbove = rhs.m_isKeepAbove;
-    m_isKeepBelow = rhs.m_isKeepBelow;
-    m_hasSkipPager = rhs.m_hasSkipPager;
-    m_hasSkipSwitcher = rhs.m_hasSkipSwitcher;
-    m_hasSkipTaskbar = rhs.m_hasSkipTaskbar;
-    m_isOnAllDesktops = rhs.m_isOnAllDesktops;
-    m_isOnAllActivities = rhs.m_isOnAllActivities;
-    m_isClosable = rhs.m_isClosable;
-    m_isFullScreenable = rhs.m_isFullScreenable;
-    m_isGroupable = rhs.m_isGroupable;
-    m_isMaximizable = rhs.m_isMaximizable;
-    m_isMinimizable = rhs.m_isMinimizable;
-    m_isMovable = rhs.m_isMovable;
-    m_isResizable = rhs.m_isResizable;
-    m_isShadeable = rhs.m_isShadeable;
-    m_isVirtualDesktopsChangeable = rhs.m_isVirtualDesktopsChangeable;
+    m_flags = rhs.m_flags;
 
     m_display = rhs.m_display;
-    m_desktops = rhs.m_desktops;
-    m_activities = rhs.m_activities;
+    m_icon = rhs.m_icon;
+
+    //! new references are taken first in order for self assignment to be safe
+    appNamesPool().ref(rhs.m_appNameId);
+    stringListsPool().ref(rhs.m_desktopsId);
+    stringListsPool().ref(rhs.m_activitiesId);
+
+    releaseAppName(m_appNameId);
+    stringListsPool().release(m_desktopsId);
+    stringListsPool().release(m_activitiesId);
+
+    m_appNameId = rhs.m_appNameId;
+    m_desktopsId = rhs.m_desktopsId;
+    m_activitiesId = rhs.m_activitiesId;
     return *this;
 }
 
+bool WindowInfoWrap::hasFlag(const Flag flag) const
+{
+    return (m_flags & flag);
+}
+
+void WindowInfoWrap::setFlag(const Flag flag, const bool enabled)
+{
+    if (enabled) {
+        m_flags |= flag;
+    } else {
+        m_flags &= ~flag;
+    }
+}
+
 //! Access properties
 bool WindowInfoWrap::isValid() const
 {
-    return m_isValid;
+    return hasFlag(IsValid);
 }
 
 void WindowInfoWrap::setIsValid(bool isValid)
 {
-    m_isValid = isValid;
+    setFlag(IsValid, isValid);
 }
 
 bool WindowInfoWrap::isActive() const
 {
-    return m_isActive;
+    return hasFlag(IsActive);
 }
 
 void WindowInfoWrap::setIsActive(bool isActive)
 {
-    m_isActive = isActive;
+    setFlag(IsActive, isActive);
 }
 
 bool WindowInfoWrap::isMinimized() const
 {
-    return m_isMinimized;
+    return hasFlag(IsMinimized);
 }
 
 void WindowInfoWrap::setIsMinimized(bool isMinimized)
 {
-    m_isMinimized = isMinimized;
+    setFlag(IsMinimized, isMinimized);
 }
 
 bool WindowInfoWrap::isMaximized() const
 {
-    return m_isMaxVert && m_isMaxHoriz;
+    return hasFlag(IsMaxVert) && hasFlag(IsMaxHoriz);
 }
 
 bool WindowInfoWrap::isMaxVert() const
 {
-    return m_isMaxVert;
+    return hasFlag(IsMaxVert);
 }
 
 void WindowInfoWrap::setIsMaxVert(bool isMaxVert)
 {
-    m_isMaxVert = isMaxVert;
+    setFlag(IsMaxVert, isMaxVert);
 }
 
 bool WindowInfoWrap::isMaxHoriz() const
 {
-    return m_isMaxHoriz;
+    return hasFlag(IsMaxHoriz);
 }
 
 void WindowInfoWrap::setIsMaxHoriz(bool isMaxHoriz)
 {
-    m_isMaxHoriz = isMaxHoriz;
+    setFlag(IsMaxHoriz, isMaxHoriz);
 }
 
 bool WindowInfoWrap::isFullscreen() const
 {
-    return m_isFullscreen;
+    return hasFlag(IsFullscreen);
 }
 
 void WindowInfoWrap::setIsFullscreen(bool isFullscreen)
 {
-    m_isFullscreen = isFullscreen;
+    setFlag(IsFullscreen, isFullscreen);
 }
 
 bool WindowInfoWrap::isShaded() const
 {
-    return m_isShaded;
+    return hasFlag(IsShaded);
 }
 
 void WindowInfoWrap::setIsShaded(bool isShaded)
 {
-    m_isShaded = isShaded;
+    setFlag(IsShaded, isShaded);
 }
 
 bool WindowInfoWrap::isKeepAbove() const
 {
-    return m_isKeepAbove;
+    return hasFlag(IsKeepAbove);
 }
 
 void WindowInfoWrap::setIsKeepAbove(bool isKeepAbove)
 {
-    m_isKeepAbove = isKeepAbove;
+    setFlag(IsKeepAbove, isKeepAbove);
 }
 
 bool WindowInfoWrap::isKeepBelow() const
 {
-    return m_isKeepBelow;
+    return hasFlag(IsKeepBelow);
 }
 
 void WindowInfoWrap::setIsKeepBelow(bool isKeepBelow)
 {
-    m_isKeepBelow = isKeepBelow;
+    setFlag(IsKeepBelow, isKeepBelow);
 }
 
 bool WindowInfoWrap::hasSkipPager() const
 {
-    return m_hasSkipPager;
+    return hasFlag(HasSkipPager);
 }
 
 void WindowInfoWrap::setHasSkipPager(bool skipPager)
 {
-    m_hasSkipPager = skipPager;
+    setFlag(HasSkipPager, skipPager);
 }
 
 bool WindowInfoWrap::hasSkipSwitcher() const
 {
-    return m_hasSkipSwitcher;
+    return hasFlag(HasSkipSwitcher);
 }
 
 void WindowInfoWrap::setHasSkipSwitcher(bool skipSwitcher)
 {
-    m_hasSkipSwitcher = skipSwitcher;
+    setFlag(HasSkipSwitcher, skipSwitcher);
 }
 
 bool WindowInfoWrap::hasSkipTaskbar() const
 {
-    return m_hasSkipTaskbar;
+    return hasFlag(HasSkipTaskbar);
 }
 
 void WindowInfoWrap::setHasSkipTaskbar(bool skipTaskbar)
 {
-    m_hasSkipTaskbar = skipTaskbar;
+    setFlag(HasSkipTaskbar, skipTaskbar);
 }
 
 bool WindowInfoWrap::isOnAllDesktops() const
 {
-    return m_isOnAllDesktops;
+    return hasFlag(IsOnAllDesktops);
 }
 
 void WindowInfoWrap::setIsOnAllDesktops(bool alldesktops)
 {
-    m_isOnAllDesktops = alldesktops;
+    setFlag(IsOnAllDesktops, alldesktops);
 }
 
 bool WindowInfoWrap::isOnAllActivities() const
 {
-    return m_isOnAllActivities;
+    return hasFlag(IsOnAllActivities);
 }
 
 void WindowInfoWrap::setIsOnAllActivities(bool allactivities)
 {
-    m_isOnAllActivities = allactivities;
+    setFlag(IsOnAllActivities, allactivities);
 }
 
 //!BEGIN: Window Abilities
 bool WindowInfoWrap::isCloseable() const
 {
-    return m_isClosable;
+    return hasFlag(IsClosable);
 }
 void WindowInfoWrap::setIsClosable(bool closable)
 {
-    m_isClosable = closable;
+    setFlag(IsClosable, closable);
 }
 
 bool WindowInfoWrap::isFullScreenable() const
 {
-    return m_isFullScreenable;
+    return hasFlag(IsFullScreenable);
 }
 void WindowInfoWrap::setIsFullScreenable(bool fullscreenable)
 {
-    m_isFullScreenable = fullscreenable;
+    setFlag(IsFullScreenable, fullscreenable);
 }
 
 bool WindowInfoWrap::isGroupable() const
 {
-    return m_isGroupable;
+    return hasFlag(IsGroupable);
 }
 void WindowInfoWrap::setIsGroupable(bool groupable)
 {
-    m_isGroupable = groupable;
+    setFlag(IsGroupable, groupable);
 }
 
 bool WindowInfoWrap::isMaximizable() const
 {
-    return m_isMaximizable;
+    return hasFlag(IsMaximizable);
 }
 void WindowInfoWrap::setIsMaximizable(bool maximizable)
 {
-    m_isMaximizable = maximizable;
+    setFlag(IsMaximizable, maximizable);
 }
 
 bool WindowInfoWrap::isMinimizable() const
 {
-    return m_isMinimizable;
+    return hasFlag(IsMinimizable);
 }
 void WindowInfoWrap::setIsMinimizable(bool minimizable)
 {
-    m_isMinimizable = minimizable;
+    setFlag(IsMinimizable, minimizable);
 }
 
 bool WindowInfoWrap::isMovable() const
 {
-    return m_isMovable;
+    return hasFlag(IsMovable);
 }
 void WindowInfoWrap::setIsMovable(bool movable)
 {
-    m_isMovable = movable;
+    setFlag(IsMovable, movable);
 }
 
 bool WindowInfoWrap::isResizable() const
 {
-    return m_isResizable;
+    return hasFlag(IsResizable);
 }
 void WindowInfoWrap::setIsResizable(bool resizable)
 {
-    m_isResizable = resizable;
+    setFlag(IsResizable, resizable);
 }
 
 bool WindowInfoWrap::isShadeable() const
 {
-    return m_isShadeable;
+    return hasFlag(IsShadeable);
 }
 void WindowInfoWrap::setIsShadeable(bool shadeble)
 {
-    m_isShadeable = shadeble;
+    setFlag(IsShadeable, shadeble);
 }
 
 bool WindowInfoWrap::isVirtualDesktopsChangeable() const
 {
-    return m_isVirtualDesktopsChangeable;
+    return hasFlag(IsVirtualDesktopsChangeable);
 }
 void WindowInfoWrap::setIsVirtualDesktopsChangeable(bool virtualdesktopchangeable)
 {
-    m_isVirtualDesktopsChangeable = virtualdesktopchangeable;
+    setFlag(IsVirtualDesktopsChangeable, virtualdesktopchangeable);
 }
 //!END: Window Abilities
 
@@ -399,23 +490,25 @@ void WindowInfoWrap::setIsVirtualDesktopsChangeable(bool virtualdesktopchangeabl
 
 bool WindowInfoWrap::isMainWindow() const
 {
-    return (m_parentId.toInt() <= 0);
+    return (m_parentId <= 0);
 }
 
 bool WindowInfoWrap::isChildWindow() const
 {
-    return (m_parentId.toInt() > 0);
+    return (m_parentId > 0);
 }
 
 
 QString WindowInfoWrap::appName() const
 {
-    return m_appName;
+    return appNamesPool().value(m_appNameId);
 }
 
 void WindowInfoWrap::setAppName(const QString &appName)
 {
-    m_appName = appName;
+    const quint32 appNameId = appNamesPool().acquire(appName);
+    releaseAppName(m_appNameId);
+    m_appNameId = appNameId;
 }
 
 QString WindowInfoWrap::display() const
@@ -430,12 +523,31 @@ void WindowInfoWrap::setDisplay(const QString &display)
 
 QIcon WindowInfoWrap::icon() const
 {
-    return m_icon;
+    if (!m_icon.isNull() || m_appNameId == 0) {
+        return m_icon;
+    }
+
+    return iconsCache().value(m_appNameId);
 }
 
 void WindowInfoWrap::setIcon(const QIcon &icon)
 {
-    m_icon = icon;
+    //! windows without application name can not share their icon
+    if (m_appNameId == 0 || icon.isNull()) {
+        m_icon = icon;
+        return;
+    }
+
+    //! the first icon of an application becomes the shared one, windows
+    //! with a different icon from their application keep their own
+    auto it = iconsCache().find(m_appNameId);
+
+    if (it == iconsCache().end()) {
+        iconsCache()[m_appNameId] = icon;
+        m_icon = QIcon();
+    } else {
+        m_icon = isSameIcon(it.value(), icon) ? QIcon() : icon;
+    }
 }
 
 QRect WindowInfoWrap::geometry() const
@@ -450,56 +562,106 @@ void WindowInfoWrap::setGeometry(const QRect &geometry)
 
 WindowId WindowInfoWrap::wid() const
 {
-    return m_wid;
+    WindowId wid(m_wid);
+    wid.convert(m_widType);
+    return wid;
 }
 
 void WindowInfoWrap::setWid(const WindowId &wid)
 {
-    m_wid = wid;
+    m_wid = wid.toLongLong();
+    m_widType = wid.userType();
 }
 
 WindowId WindowInfoWrap::parentId() const
 {
-    return m_parentId;
+    WindowId parentId(m_parentId);
+    parentId.convert(m_parentIdType);
+    return parentId;
 }
 
 void WindowInfoWrap::setParentId(const WindowId &parentId)
 {
-    if (m_wid == parentId) {
+    if (wid() == parentId) {
         return;
     }
 
-    m_parentId = parentId;
+    m_parentId = parentId.toLongLong();
+    m_parentIdType = parentId.userType();
 }
 
 QStringList WindowInfoWrap::desktops() const
 {
-    return m_desktops;
+    return stringListsPool().value(m_desktopsId);
 }
 
 void WindowInfoWrap::setDesktops(const QStringList &desktops)
 {
-    m_desktops = desktops;
+    const quint32 desktopsId = stringListsPool().acquire(desktops);
+    stringListsPool().release(m_desktopsId);
+    m_desktopsId = desktopsId;
 }
 
 QStringList WindowInfoWrap::activities() const
 {
-    return m_activities;
+    return stringListsPool().value(m_activitiesId);
 }
 
 void WindowInfoWrap::setActivities(const QStringList &activities)
 {
-    m_activities = activities;
+    const quint32 activitiesId = stringListsPool().acquire(activities);
+    stringListsPool().release(m_activitiesId);
+    m_activitiesId = activitiesId;
 }
 
 bool WindowInfoWrap::isOnDesktop(const QString &desktop) const
 {
-    return m_isOnAllDesktops || m_desktops.contains(desktop);
+    return hasFlag(IsOnAllDesktops) || stringListsPool().value(m_desktopsId).contains(desktop);
 }
 
 bool WindowInfoWrap::isOnActivity(const QString &activity) const
 {
-    return m_isOnAllActivities || m_activities.contains(activity);
+    return hasFlag(IsOnAllActivities) || stringListsPool().value(m_activitiesId).contains(activity);
+}
+
+QDataStream &operator<<(QDataStream &out, const WindowInfoWrap &winfo)
+{
+    out << winfo.m_wid << qint32(winfo.m_widType)
+        << winfo.m_parentId << qint32(winfo.m_parentIdType)
+        << winfo.m_geometry
+        << winfo.m_flags
+        << winfo.m_display
+        << winfo.appName()
+        << winfo.desktops()
+        << winfo.activities();
+
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, WindowInfoWrap &winfo)
+{
+    qint32 widType;
+    qint32 parentIdType;
+    QString appName;
+    QStringList desktops;
+    QStringList activities;
+
+    in >> winfo.m_wid >> widType
+       >> winfo.m_parentId >> parentIdType
+       >> winfo.m_geometry
+       >> winfo.m_flags
+       >> winfo.m_display
+       >> appName
+       >> desktops
+       >> activities;
+
+    winfo.m_widType = widType;
+    winfo.m_parentIdType = parentIdType;
+    winfo.setAppName(appName);
+    winfo.setDesktops(desktops);
+    winfo.setActivities(activities);
+
+    return in;
 }
 
 }
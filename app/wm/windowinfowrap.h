@@ -22,6 +22,7 @@
 #define WINDOWINFOWRAP_H
 
 // Qt
+#include <QDataStream>
 #include <QWindow>
 #include <QIcon>
 #include <QRect>
@@ -39,6 +40,7 @@ public:
     WindowInfoWrap();
     WindowInfoWrap(const WindowInfoWrap &o);
     WindowInfoWrap(WindowInfoWrap &&o);
+    ~WindowInfoWrap();
 
     WindowInfoWrap &operator=(WindowInfoWrap &&rhs);
     WindowInfoWrap &operator=(const WindowInfoWrap &rhs);
@@ -146,46 +148,67 @@ public:
     bool isOnDesktop(const QString &desktop) const;
     bool isOnActivity(const QString &activity) const;
 
+    //! compact binary form used for windows events recordings, icons are not included
+    friend QDataStream &operator<<(QDataStream &out, const WindowInfoWrap &winfo);
+    friend QDataStream &operator>>(QDataStream &in, WindowInfoWrap &winfo);
+
+private:
+    //! window state and abilities are stored as bits in order for the
+    //! window information to stay compact and cheap to copy
+    enum Flag {
+        IsValid = 1 << 0,
+        IsActive = 1 << 1,
+        IsMinimized = 1 << 2,
+        IsMaxVert = 1 << 3,
+        IsMaxHoriz = 1 << 4,
+        IsFullscreen = 1 << 5,
+        IsShaded = 1 << 6,
+        IsKeepAbove = 1 << 7,
+        IsKeepBelow = 1 << 8,
+        HasSkipPager = 1 << 9,
+        HasSkipSwitcher = 1 << 10,
+        HasSkipTaskbar = 1 << 11,
+        IsOnAllDesktops = 1 << 12,
+        IsOnAllActivities = 1 << 13,
+        //!BEGIN: Window Abilities
+        IsClosable = 1 << 14,
+        IsFullScreenable = 1 << 15,
+        IsGroupable = 1 << 16,
+        IsMaximizable = 1 << 17,
+        IsMinimizable = 1 << 18,
+        IsMovable = 1 << 19,
+        IsResizable = 1 << 20,
+        IsShadeable = 1 << 21,
+        IsVirtualDesktopsChangeable = 1 << 22
+        //!END: Window Abilities
+    };
+
+    bool hasFlag(const Flag flag) const;
+    void setFlag(const Flag flag, const bool enabled);
+
 private:
-    WindowId m_wid{0};
-    WindowId m_parentId{0};
+    //! window ids are integral for all window systems, their original type
+    //! is kept in order to provide the same WindowId that was set
+    qint64 m_wid{0};
+    qint64 m_parentId{0};
+    int m_widType{QMetaType::Int};
+    int m_parentIdType{QMetaType::Int};
 
     QRect m_geometry;
 
-    bool m_isValid{false};
-    bool m_isActive{false};
-    bool m_isMinimized{false};
-    bool m_isMaxVert{false};
-    bool m_isMaxHoriz{false};
-    bool m_isFullscreen{false};
-    bool m_isShaded{false};
-    bool m_isKeepAbove{false};
-    bool m_isKeepBelow{false};
-    bool m_hasSkipPager{false};
-    bool m_hasSkipSwitcher{false};
-    bool m_hasSkipTaskbar{false};
-    bool m_isOnAllDesktops{false};
-    bool m_isOnAllActivities{false};
+    quint32 m_flags{0};
 
-    //!BEGIN: Window Abilities
-    bool m_isClosable{false};
-    bool m_isFullScreenable{false};
-    bool m_isGroupable{false};
-    bool m_isMaximizable{false};
-    bool m_isMinimizable{false};
-    bool m_isMovable{false};
-    bool m_isResizable{false};
-    bool m_isShadeable{false};
-    bool m_isVirtualDesktopsChangeable{false};
-    //!END: Window Abilities
+    //! app names, desktops and activities are shared between many windows
+    //! and as such they are interned, the icons are cached per application
+    quint32 m_appNameId{0};
+    quint32 m_desktopsId{0};
+    quint32 m_activitiesId{0};
 
-    QString m_appName;
     QString m_display;
 
+    //! used only when the window has no application name or its icon
+    //! is different from its application cached one
     QIcon m_icon;
-
-    QStringList m_desktops;
-    QStringList m_activities;
 };
 
 }
@@ -0,0 +1,482 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "xwindowinforeader.h"
+
+// Qt
+#include <QScopedPointer>
+#include <QVector>
+#include <QtX11Extras/QX11Info>
+
+// KDE
+#include <KWindowInfo>
+#include <KWindowSystem>
+
+// X11
+#include <NETWM>
+#include <xcb/xcb.h>
+
+//! ICCCM WM_STATE of windows that are not managed
+#define WMSTATEWITHDRAWN 0
+
+namespace Latte {
+namespace WindowSystem {
+
+XWindowInfoReader::Info XWindowInfoReader::readInfo(const WindowId &wid) const
+{
+    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
+                | NET::WMWindowType
+                | NET::WMGeometry
+                | NET::WMDesktop
+                | NET::WMState
+                | NET::WMName
+                | NET::WMVisibleName,
+                NET::WM2WindowClass
+                | NET::WM2Activities
+                | NET::WM2AllowedActions
+                | NET::WM2TransientFor};
+
+    Info info;
+    info.wid = wid;
+    info.exists = winfo.valid();
+    info.windowClass = QString(winfo.windowClassName());
+    info.geometry = winfo.geometry();
+    info.hasSkipTaskbar = winfo.hasState(NET::SkipTaskbar);
+    info.hasSkipPager = winfo.hasState(NET::SkipPager);
+
+    if (!info.exists) {
+        info.winfo.setIsValid(false);
+        return info;
+    }
+
+    WindowInfoWrap &winfoWrap = info.winfo;
+
+    winfoWrap.setIsValid(true);
+    winfoWrap.setWid(wid);
+    winfoWrap.setParentId(winfo.transientFor());
+    winfoWrap.setIsActive(KWindowSystem::activeWindow() == wid.value<WId>());
+    winfoWrap.setIsMinimized(winfo.hasState(NET::Hidden));
+    winfoWrap.setIsMaxVert(winfo.hasState(NET::MaxVert));
+    winfoWrap.setIsMaxHoriz(winfo.hasState(NET::MaxHoriz));
+    winfoWrap.setIsFullscreen(winfo.hasState(NET::FullScreen));
+    winfoWrap.setIsShaded(winfo.hasState(NET::Shaded));
+    winfoWrap.setIsOnAllDesktops(winfo.onAllDesktops());
+    winfoWrap.setIsOnAllActivities(winfo.activities().empty());
+#if KF5_VERSION_MINOR >= 65
+    winfoWrap.setGeometry(visibleGeometry(wid, winfo.frameGeometry()));
+#else
+    winfoWrap.setGeometry(winfo.frameGeometry());
+#endif
+    winfoWrap.setIsKeepAbove(winfo.hasState(NET::KeepAbove));
+    winfoWrap.setIsKeepBelow(winfo.hasState(NET::KeepBelow));
+    winfoWrap.setHasSkipPager(info.hasSkipPager);
+#if KF5_VERSION_MINOR >= 45
+    winfoWrap.setHasSkipSwitcher(winfo.hasState(NET::SkipSwitcher));
+#endif
+    winfoWrap.setHasSkipTaskbar(info.hasSkipTaskbar);
+
+    //! BEGIN:Window Abilities
+    winfoWrap.setIsClosable(winfo.actionSupported(NET::ActionClose));
+    winfoWrap.setIsFullScreenable(winfo.actionSupported(NET::ActionFullScreen));
+    winfoWrap.setIsMaximizable(winfo.actionSupported(NET::ActionMax));
+    winfoWrap.setIsMinimizable(winfo.actionSupported(NET::ActionMinimize));
+    winfoWrap.setIsMovable(winfo.actionSupported(NET::ActionMove));
+    winfoWrap.setIsResizable(winfo.actionSupported(NET::ActionResize));
+    winfoWrap.setIsShadeable(winfo.actionSupported(NET::ActionShade));
+    winfoWrap.setIsVirtualDesktopsChangeable(winfo.actionSupported(NET::ActionChangeDesktop));
+    //! END:Window Abilities
+
+    winfoWrap.setDisplay(winfo.visibleName());
+    winfoWrap.setDesktops({QString(winfo.desktop())});
+    winfoWrap.setActivities(winfo.activities());
+
+    return info;
+}
+
+#if KF5_VERSION_MINOR >= 65
+QRect XWindowInfoReader::visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const
+{
+    NETWinInfo ni(QX11Info::connection(), wid.toUInt(), QX11Info::appRootWindow(), 0, NET::WM2GTKFrameExtents);
+    NETStrut struts = ni.gtkFrameExtents();
+    QMargins margins(struts.left, struts.top, struts.right, struts.bottom);
+    QRect visibleGeometry = frameGeometry;
+
+    if (!margins.isNull()) {
+        visibleGeometry -= margins;
+    }
+
+    return visibleGeometry;
+}
+#endif
+
+void XWindowInfoReader::initAtoms()
+{
+    if (!m_atoms.isEmpty()) {
+        return;
+    }
+
+    const QList<QByteArray> names{
+        QByteArrayLiteral("UTF8_STRING"),
+        QByteArrayLiteral("COMPOUND_TEXT"),
+        QByteArrayLiteral("WM_STATE"),
+        QByteArrayLiteral("_NET_WM_STATE"),
+        QByteArrayLiteral("_NET_WM_STATE_HIDDEN"),
+        QByteArrayLiteral("_NET_WM_STATE_MAXIMIZED_VERT"),
+        QByteArrayLiteral("_NET_WM_STATE_MAXIMIZED_HORZ"),
+        QByteArrayLiteral("_NET_WM_STATE_FULLSCREEN"),
+        QByteArrayLiteral("_NET_WM_STATE_SHADED"),
+        QByteArrayLiteral("_NET_WM_STATE_ABOVE"),
+        QByteArrayLiteral("_NET_WM_STATE_STAYS_ON_TOP"),
+        QByteArrayLiteral("_NET_WM_STATE_BELOW"),
+        QByteArrayLiteral("_NET_WM_STATE_SKIP_PAGER"),
+        QByteArrayLiteral("_NET_WM_STATE_SKIP_TASKBAR"),
+        QByteArrayLiteral("_KDE_NET_WM_STATE_SKIP_SWITCHER"),
+        QByteArrayLiteral("_NET_WM_DESKTOP"),
+        QByteArrayLiteral("_NET_FRAME_EXTENTS"),
+        QByteArrayLiteral("_KDE_NET_WM_FRAME_STRUT"),
+        QByteArrayLiteral("_GTK_FRAME_EXTENTS"),
+        QByteArrayLiteral("_NET_WM_NAME"),
+        QByteArrayLiteral("_NET_WM_VISIBLE_NAME"),
+        QByteArrayLiteral("_KDE_NET_WM_ACTIVITIES"),
+        QByteArrayLiteral("_NET_WM_ALLOWED_ACTIONS"),
+        QByteArrayLiteral("_NET_WM_ACTION_CLOSE"),
+        QByteArrayLiteral("_NET_WM_ACTION_FULLSCREEN"),
+        QByteArrayLiteral("_NET_WM_ACTION_MAXIMIZE_VERT"),
+        QByteArrayLiteral("_NET_WM_ACTION_MAXIMIZE_HORZ"),
+        QByteArrayLiteral("_NET_WM_ACTION_MINIMIZE"),
+        QByteArrayLiteral("_NET_WM_ACTION_MOVE"),
+        QByteArrayLiteral("_NET_WM_ACTION_RESIZE"),
+        QByteArrayLiteral("_NET_WM_ACTION_SHADE"),
+        QByteArrayLiteral("_NET_WM_ACTION_CHANGE_DESKTOP")
+    };
+
+    xcb_connection_t *c = QX11Info::connection();
+
+    //! send all requests first and afterwards wait for their replies
+    QVector<xcb_intern_atom_cookie_t> cookies;
+
+    for (const auto &name : names) {
+        cookies << xcb_intern_atom(c, false, name.length(), name.constData());
+    }
+
+    for (int i = 0; i < names.count(); ++i) {
+        QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> reply(xcb_intern_atom_reply(c, cookies[i], nullptr));
+        m_atoms[names[i]] = reply ? reply->atom : XCB_ATOM_NONE;
+    }
+}
+
+quint32 XWindowInfoReader::atom(const QByteArray &name) const
+{
+    return m_atoms.value(name, XCB_ATOM_NONE);
+}
+
+bool XWindowInfoReader::allowedActionsSupported()
+{
+    if (m_allowedActionsSupported < 0) {
+        NETRootInfo rootInfo(QX11Info::connection(), NET::Supported);
+        m_allowedActionsSupported = rootInfo.isSupported(NET::WM2AllowedActions) ? 1 : 0;
+    }
+
+    return m_allowedActionsSupported == 1;
+}
+
+namespace {
+struct WindowCookies {
+    xcb_get_geometry_cookie_t geometry;
+    xcb_translate_coordinates_cookie_t position;
+    xcb_get_property_cookie_t state;
+    xcb_get_property_cookie_t desktop;
+    xcb_get_property_cookie_t frameExtents;
+    xcb_get_property_cookie_t kdeFrameStrut;
+    xcb_get_property_cookie_t gtkFrameExtents;
+    xcb_get_property_cookie_t name;
+    xcb_get_property_cookie_t icccmName;
+    xcb_get_property_cookie_t visibleName;
+    xcb_get_property_cookie_t windowClass;
+    xcb_get_property_cookie_t activities;
+    xcb_get_property_cookie_t allowedActions;
+    xcb_get_property_cookie_t transientFor;
+    xcb_get_property_cookie_t mappingState;
+};
+
+using PropertyReply = QScopedPointer<xcb_get_property_reply_t, QScopedPointerPodDeleter>;
+
+//! collects the errors of the replies in order to be freed, otherwise they are
+//! delivered to the event queue, e.g. BadWindow for windows closed in the meantime
+class ReplyErrors
+{
+public:
+    ~ReplyErrors()
+    {
+        for (auto error : m_errors) {
+            free(error);
+        }
+    }
+
+    xcb_generic_error_t **next()
+    {
+        m_errors << nullptr;
+        return &m_errors.last();
+    }
+
+    bool hasErrors() const
+    {
+        for (const auto error : m_errors) {
+            if (error) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    QVector<xcb_generic_error_t *> m_errors;
+};
+
+//! the same as NETWinInfo, properties of an unexpected type are ignored
+QVector<quint32> cardinals(xcb_get_property_reply_t *reply, quint32 type)
+{
+    QVector<quint32> values;
+
+    if (reply && reply->type == type && reply->format == 32) {
+        const quint32 *data = reinterpret_cast<const quint32 *>(xcb_get_property_value(reply));
+        const int length = xcb_get_property_value_length(reply) / 4;
+
+        for (int i = 0; i < length; ++i) {
+            values << data[i];
+        }
+    }
+
+    return values;
+}
+
+QByteArray bytes(xcb_get_property_reply_t *reply, quint32 type)
+{
+    if (!reply || reply->type != type || reply->format != 8) {
+        return QByteArray();
+    }
+
+    return QByteArray(reinterpret_cast<const char *>(xcb_get_property_value(reply)), xcb_get_property_value_length(reply));
+}
+
+QMargins margins(const QVector<quint32> &extents)
+{
+    //! NET frame extents order is left, right, top, bottom
+    return extents.count() == 4 ? QMargins(extents[0], extents[2], extents[1], extents[3]) : QMargins();
+}
+}
+
+QList<XWindowInfoReader::Info> XWindowInfoReader::readInfos(const QList<WindowId> &wids)
+{
+    initAtoms();
+
+    xcb_connection_t *c = QX11Info::connection();
+    const xcb_window_t root = QX11Info::appRootWindow();
+
+    auto propertyCookie = [&](xcb_window_t window, quint32 property) {
+        return xcb_get_property(c, false, window, property, XCB_GET_PROPERTY_TYPE_ANY, 0, 2048);
+    };
+
+    //! send all requests for all windows first, this way only one roundtrip
+    //! latency is paid for all windows instead of a few for each one of them
+    QVector<WindowCookies> cookies;
+    cookies.reserve(wids.count());
+
+    for (const auto &wid : wids) {
+        const xcb_window_t window = static_cast<xcb_window_t>(wid.value<WId>());
+
+        WindowCookies wcookies;
+        wcookies.geometry = xcb_get_geometry(c, window);
+        wcookies.position = xcb_translate_coordinates(c, window, root, 0, 0);
+        wcookies.state = propertyCookie(window, atom("_NET_WM_STATE"));
+        wcookies.desktop = propertyCookie(window, atom("_NET_WM_DESKTOP"));
+        wcookies.frameExtents = propertyCookie(window, atom("_NET_FRAME_EXTENTS"));
+        wcookies.kdeFrameStrut = propertyCookie(window, atom("_KDE_NET_WM_FRAME_STRUT"));
+        wcookies.gtkFrameExtents = propertyCookie(window, atom("_GTK_FRAME_EXTENTS"));
+        wcookies.name = propertyCookie(window, atom("_NET_WM_NAME"));
+        wcookies.icccmName = propertyCookie(window, XCB_ATOM_WM_NAME);
+        wcookies.visibleName = propertyCookie(window, atom("_NET_WM_VISIBLE_NAME"));
+        wcookies.windowClass = propertyCookie(window, XCB_ATOM_WM_CLASS);
+        wcookies.activities = propertyCookie(window, atom("_KDE_NET_WM_ACTIVITIES"));
+        wcookies.allowedActions = propertyCookie(window, atom("_NET_WM_ALLOWED_ACTIONS"));
+        wcookies.transientFor = propertyCookie(window, XCB_ATOM_WM_TRANSIENT_FOR);
+        wcookies.mappingState = propertyCookie(window, atom("WM_STATE"));
+        cookies << wcookies;
+    }
+
+    xcb_flush(c);
+
+    const WId activeWindow = KWindowSystem::activeWindow();
+    const quint32 utf8String = atom("UTF8_STRING");
+
+    QList<Info> infos;
+
+    for (int i = 0; i < wids.count(); ++i) {
+        const WindowId &wid = wids[i];
+        const WindowCookies &wcookies = cookies[i];
+
+        ReplyErrors errors;
+
+        QScopedPointer<xcb_get_geometry_reply_t, QScopedPointerPodDeleter> geometryReply(xcb_get_geometry_reply(c, wcookies.geometry, errors.next()));
+        QScopedPointer<xcb_translate_coordinates_reply_t, QScopedPointerPodDeleter> positionReply(xcb_translate_coordinates_reply(c, wcookies.position, errors.next()));
+        PropertyReply stateReply(xcb_get_property_reply(c, wcookies.state, errors.next()));
+        PropertyReply desktopReply(xcb_get_property_reply(c, wcookies.desktop, errors.next()));
+        PropertyReply frameExtentsReply(xcb_get_property_reply(c, wcookies.frameExtents, errors.next()));
+        PropertyReply kdeFrameStrutReply(xcb_get_property_reply(c, wcookies.kdeFrameStrut, errors.next()));
+        PropertyReply gtkFrameExtentsReply(xcb_get_property_reply(c, wcookies.gtkFrameExtents, errors.next()));
+        PropertyReply nameReply(xcb_get_property_reply(c, wcookies.name, errors.next()));
+        PropertyReply icccmNameReply(xcb_get_property_reply(c, wcookies.icccmName, errors.next()));
+        PropertyReply visibleNameReply(xcb_get_property_reply(c, wcookies.visibleName, errors.next()));
+        PropertyReply windowClassReply(xcb_get_property_reply(c, wcookies.windowClass, errors.next()));
+        PropertyReply activitiesReply(xcb_get_property_reply(c, wcookies.activities, errors.next()));
+        PropertyReply allowedActionsReply(xcb_get_property_reply(c, wcookies.allowedActions, errors.next()));
+        PropertyReply transientForReply(xcb_get_property_reply(c, wcookies.transientFor, errors.next()));
+        PropertyReply mappingStateReply(xcb_get_property_reply(c, wcookies.mappingState, errors.next()));
+
+        Info info;
+        info.wid = wid;
+
+        const QVector<quint32> states = cardinals(stateReply.data(), XCB_ATOM_ATOM);
+
+        auto hasState = [&](const QByteArray &name) {
+            return states.contains(atom(name));
+        };
+
+        //! WM_CLASS holds the instance name followed by the class name
+        info.windowClass = QString(bytes(windowClassReply.data(), XCB_ATOM_STRING).split('\0').value(0));
+        info.hasSkipTaskbar = hasState("_NET_WM_STATE_SKIP_TASKBAR");
+        info.hasSkipPager = hasState("_NET_WM_STATE_SKIP_PAGER");
+
+        if (geometryReply && positionReply) {
+            info.geometry = QRect(positionReply->dst_x, positionReply->dst_y, geometryReply->width, geometryReply->height);
+        }
+
+        //! the same as KWindowInfo::valid(), withdrawn windows are not valid
+        const QVector<quint32> mappingState = cardinals(mappingStateReply.data(), atom("WM_STATE"));
+        const bool isWithdrawn = mappingState.isEmpty() || mappingState[0] == WMSTATEWITHDRAWN;
+
+        info.exists = !errors.hasErrors() && geometryReply && positionReply && !isWithdrawn;
+
+        if (!info.exists) {
+            //! window does not exist anymore
+            info.winfo.setIsValid(false);
+            infos << info;
+            continue;
+        }
+
+        const bool allActionsAllowed = !allowedActionsSupported();
+        const QVector<quint32> actions = cardinals(allowedActionsReply.data(), XCB_ATOM_ATOM);
+
+        auto actionSupported = [&](const QByteArray &name) {
+            return allActionsAllowed || actions.contains(atom(name));
+        };
+
+        //! the same as NETWinInfo, the kde frame strut is used when frame extents are not provided
+        QVector<quint32> frameExtents = cardinals(frameExtentsReply.data(), XCB_ATOM_CARDINAL);
+
+        if (frameExtents.count() != 4) {
+            frameExtents = cardinals(kdeFrameStrutReply.data(), XCB_ATOM_CARDINAL);
+        }
+
+        const QRect frameGeometry = info.geometry + margins(frameExtents);
+
+        const QVector<quint32> desktop = cardinals(desktopReply.data(), XCB_ATOM_CARDINAL);
+        const QVector<quint32> transientFor = cardinals(transientForReply.data(), XCB_ATOM_WINDOW);
+
+        //! activities are separated with commas and the all activities uuid means no specific activities
+        QStringList activities = QString::fromLatin1(bytes(activitiesReply.data(), XCB_ATOM_STRING)).split(QLatin1Char(','), QString::SkipEmptyParts);
+
+        if (activities.contains(QStringLiteral("00000000-0000-0000-0000-000000000000"))) {
+            activities.clear();
+        }
+
+        //! the same as KWindowInfo::visibleName(), the NET names are used first
+        //! and the ICCCM WM_NAME afterwards
+        QString visibleName = QString::fromUtf8(bytes(visibleNameReply.data(), utf8String));
+
+        if (visibleName.isEmpty()) {
+            visibleName = QString::fromUtf8(bytes(nameReply.data(), utf8String));
+        }
+
+        if (visibleName.isEmpty() && icccmNameReply) {
+            if (icccmNameReply->type == utf8String) {
+                visibleName = QString::fromUtf8(bytes(icccmNameReply.data(), utf8String));
+            } else if (icccmNameReply->type == XCB_ATOM_STRING) {
+                visibleName = QString::fromLatin1(bytes(icccmNameReply.data(), XCB_ATOM_STRING));
+            } else if (icccmNameReply->type == atom("COMPOUND_TEXT")) {
+                //! compound text is the same as the locale encoding for the ascii range
+                visibleName = QString::fromLocal8Bit(bytes(icccmNameReply.data(), atom("COMPOUND_TEXT")));
+            }
+        }
+
+        //! NET desktops are zero based and 0xFFFFFFFF means on all desktops
+        const bool onAllDesktops = !desktop.isEmpty() && desktop[0] == 0xFFFFFFFF;
+        const int desktopNumber = desktop.isEmpty() ? 0 : (onAllDesktops ? NET::OnAllDesktops : static_cast<int>(desktop[0]) + 1);
+
+        WindowInfoWrap &winfoWrap = info.winfo;
+
+        winfoWrap.setIsValid(true);
+        winfoWrap.setWid(wid);
+        winfoWrap.setParentId(transientFor.isEmpty() ? WId(0) : WId(transientFor[0]));
+        winfoWrap.setIsActive(activeWindow == wid.value<WId>());
+        winfoWrap.setIsMinimized(hasState("_NET_WM_STATE_HIDDEN"));
+        winfoWrap.setIsMaxVert(hasState("_NET_WM_STATE_MAXIMIZED_VERT"));
+        winfoWrap.setIsMaxHoriz(hasState("_NET_WM_STATE_MAXIMIZED_HORZ"));
+        winfoWrap.setIsFullscreen(hasState("_NET_WM_STATE_FULLSCREEN"));
+        winfoWrap.setIsShaded(hasState("_NET_WM_STATE_SHADED"));
+        winfoWrap.setIsOnAllDesktops(onAllDesktops);
+        winfoWrap.setIsOnAllActivities(activities.empty());
+#if KF5_VERSION_MINOR >= 65
+        winfoWrap.setGeometry(frameGeometry - margins(cardinals(gtkFrameExtentsReply.data(), XCB_ATOM_CARDINAL)));
+#else
+        winfoWrap.setGeometry(frameGeometry);
+#endif
+        //! the same as NETWinInfo, the legacy stays on top state means keep above
+        winfoWrap.setIsKeepAbove(hasState("_NET_WM_STATE_ABOVE") || hasState("_NET_WM_STATE_STAYS_ON_TOP"));
+        winfoWrap.setIsKeepBelow(hasState("_NET_WM_STATE_BELOW"));
+        winfoWrap.setHasSkipPager(info.hasSkipPager);
+#if KF5_VERSION_MINOR >= 45
+        winfoWrap.setHasSkipSwitcher(hasState("_KDE_NET_WM_STATE_SKIP_SWITCHER"));
+#endif
+        winfoWrap.setHasSkipTaskbar(info.hasSkipTaskbar);
+
+        //! BEGIN:Window Abilities
+        winfoWrap.setIsClosable(actionSupported("_NET_WM_ACTION_CLOSE"));
+        winfoWrap.setIsFullScreenable(actionSupported("_NET_WM_ACTION_FULLSCREEN"));
+        winfoWrap.setIsMaximizable(actionSupported("_NET_WM_ACTION_MAXIMIZE_VERT") || actionSupported("_NET_WM_ACTION_MAXIMIZE_HORZ"));
+        winfoWrap.setIsMinimizable(actionSupported("_NET_WM_ACTION_MINIMIZE"));
+        winfoWrap.setIsMovable(actionSupported("_NET_WM_ACTION_MOVE"));
+        winfoWrap.setIsResizable(actionSupported("_NET_WM_ACTION_RESIZE"));
+        winfoWrap.setIsShadeable(actionSupported("_NET_WM_ACTION_SHADE"));
+        winfoWrap.setIsVirtualDesktopsChangeable(actionSupported("_NET_WM_ACTION_CHANGE_DESKTOP"));
+        //! END:Window Abilities
+
+        winfoWrap.setDisplay(visibleName);
+        winfoWrap.setDesktops({QString(desktopNumber)});
+        winfoWrap.setActivities(activities);
+
+        infos << info;
+    }
+
+    return infos;
+}
+
+}
+}
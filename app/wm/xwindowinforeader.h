@@ -0,0 +1,84 @@
+/*
+*  Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+*
+*  This file is part of Latte-Dock
+*
+*  Latte-Dock is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU General Public License as
+*  published by the Free Software Foundation; either version 2 of
+*  the License, or (at your option) any later version.
+*
+*  Latte-Dock is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WINDOWSYSTEMXWINDOWINFOREADER_H
+#define WINDOWSYSTEMXWINDOWINFOREADER_H
+
+// local
+#include <config-latte.h>
+#include "windowinfowrap.h"
+
+// Qt
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QRect>
+#include <QString>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Reads the windows properties from X11, either for one window through KWindowInfo
+//! or for many windows at once through batched xcb requests. Both paths provide exactly
+//! the same information, whether a window is tracked or not is decided by the caller.
+class XWindowInfoReader
+{
+public:
+    struct Info
+    {
+        WindowId wid;
+        //! the same as KWindowInfo::valid(), it does not exist or it is withdrawn
+        bool exists{false};
+        //! WM_CLASS instance name
+        QString windowClass;
+        //! client geometry without the window frame
+        QRect geometry;
+        //! window states that are used from the windows acceptance checks
+        bool hasSkipTaskbar{false};
+        bool hasSkipPager{false};
+        //! all window properties, valid only when the window exists
+        WindowInfoWrap winfo;
+    };
+
+    Info readInfo(const WindowId &wid) const;
+    //! only one roundtrip latency is paid for all windows
+    QList<Info> readInfos(const QList<WindowId> &wids);
+
+private:
+    void initAtoms();
+    quint32 atom(const QByteArray &name) const;
+
+#if KF5_VERSION_MINOR >= 65
+    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const;
+#endif
+
+    //! the same as KWindowInfo, all actions are allowed when the window
+    //! manager does not support _NET_WM_ALLOWED_ACTIONS
+    bool allowedActionsSupported();
+
+private:
+    int m_allowedActionsSupported{-1};
+
+    QHash<QByteArray, quint32> m_atoms;
+};
+
+}
+}
+
+#endif
@@ -65,9 +65,23 @@ XWindowInterface::XWindowInterface(QObject *parent)
             (&KWindowSystem::windowChanged)
             , this, &XWindowInterface::windowChangedProxy);
 
+    //! request all windows information at once in order to avoid
+    //! one X roundtrip for each window during startup
+    QList<WindowId> wids;
 
     for(auto wid : KWindowSystem::self()->windows()) {
-        windowAddedProxy(wid);
+        wids << wid;
+    }
+
+    const QList<WindowInfoWrap> winfos = requestInfos(wids);
+    windowsTracker()->addWindowsInfo(winfos);
+
+    //! the same as windowAddedProxy(), the windows acceptance has already been
+    //! checked and the windows information is already tracked from the batched request
+    for (const auto &winfo : winfos) {
+        if (winfo.isValid()) {
+            emit windowAdded(winfo.wid());
+        }
     }
 }
 
@@ -328,23 +342,6 @@ void XWindowInterface::setActiveEdge(QWindow *view, bool active)
     xcb_change_property(c, XCB_PROP_MODE_REPLACE, window->winId(), atom->atom, XCB_ATOM_CARDINAL, 32, 1, &value);
 }
 
-#if KF5_VERSION_MINOR >= 65
-QRect XWindowInterface::visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const
-{
-    NETWinInfo ni(QX11Info::connection(), wid.toUInt(), QX11Info::appRootWindow(), 0, NET::WM2GTKFrameExtents);
-    NETStrut struts = ni.gtkFrameExtents();
-    QMargins margins(struts.left, struts.top, struts.right, struts.bottom);
-    QRect visibleGeometry = frameGeometry;
-
-    if (!margins.isNull()) {
-        visibleGeometry -= margins;
-    }
-
-    return visibleGeometry;
-}
-#endif
-
-
 void XWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
 {
     if (!view) {
@@ -443,70 +440,41 @@ WindowInfoWrap XWindowInterface::requestInfoActive()
 
 WindowInfoWrap XWindowInterface::requestInfo(WindowId wid)
 {
-    const KWindowInfo winfo{wid.value<WId>(), NET::WMFrameExtents
-                | NET::WMWindowType
-                | NET::WMGeometry
-                | NET::WMDesktop
-                | NET::WMState
-                | NET::WMName
-                | NET::WMVisibleName,
-                NET::WM2WindowClass
-                | NET::WM2Activities
-                | NET::WM2AllowedActions
-                | NET::WM2TransientFor};
+    PerfCounters::Probe probe(perfCounters(), PerfCounters::XRequestInfo, 1);
 
-    WindowInfoWrap winfoWrap;
+    return acceptedInfo(m_infoReader.readInfo(wid));
+}
 
-    const auto winClass = QString(winfo.windowClassName());
+QList<WindowInfoWrap> XWindowInterface::requestInfos(const QList<WindowId> &wids)
+{
+    PerfCounters::Probe probe(perfCounters(), PerfCounters::XRequestInfos, wids.count());
 
-    //!used to track Plasma DesktopView windows because during startup can not be identified properly
-    bool plasmaBlockedWindow = (winClass == QLatin1String("plasmashell") && !isAcceptableWindow(wid));
+    QList<WindowInfoWrap> winfos;
 
-    if (!winfo.valid() || plasmaBlockedWindow) {
-        winfoWrap.setIsValid(false);
-    } else if (isValidWindow(wid)) {
-        winfoWrap.setIsValid(true);
-        winfoWrap.setWid(wid);
-        winfoWrap.setParentId(winfo.transientFor());
-        winfoWrap.setIsActive(KWindowSystem::activeWindow() == wid.value<WId>());
-        winfoWrap.setIsMinimized(winfo.hasState(NET::Hidden));
-        winfoWrap.setIsMaxVert(winfo.hasState(NET::MaxVert));
-        winfoWrap.setIsMaxHoriz(winfo.hasState(NET::MaxHoriz));
-        winfoWrap.setIsFullscreen(winfo.hasState(NET::FullScreen));
-        winfoWrap.setIsShaded(winfo.hasState(NET::Shaded));
-        winfoWrap.setIsOnAllDesktops(winfo.onAllDesktops());
-        winfoWrap.setIsOnAllActivities(winfo.activities().empty());
-#if KF5_VERSION_MINOR >= 65
-        winfoWrap.setGeometry(visibleGeometry(wid, winfo.frameGeometry()));
-#else
-        winfoWrap.setGeometry(winfo.frameGeometry());
-#endif
-        winfoWrap.setIsKeepAbove(winfo.hasState(NET::KeepAbove));
-        winfoWrap.setIsKeepBelow(winfo.hasState(NET::KeepBelow));
-        winfoWrap.setHasSkipPager(winfo.hasState(NET::SkipPager));
-#if KF5_VERSION_MINOR >= 45
-        winfoWrap.setHasSkipSwitcher(winfo.hasState(NET::SkipSwitcher));
-#endif
-        winfoWrap.setHasSkipTaskbar(winfo.hasState(NET::SkipTaskbar));
+    for (const auto &info : m_infoReader.readInfos(wids)) {
+        winfos << acceptedInfo(info);
+    }
+
+    return winfos;
+}
+
+WindowInfoWrap XWindowInterface::acceptedInfo(const XWindowInfoReader::Info &info)
+{
+    WindowInfoWrap winfoWrap;
 
-        //! BEGIN:Window Abilities
-        winfoWrap.setIsClosable(winfo.actionSupported(NET::ActionClose));
-        winfoWrap.setIsFullScreenable(winfo.actionSupported(NET::ActionFullScreen));
-        winfoWrap.setIsMaximizable(winfo.actionSupported(NET::ActionMax));
-        winfoWrap.setIsMinimizable(winfo.actionSupported(NET::ActionMinimize));
-        winfoWrap.setIsMovable(winfo.actionSupported(NET::ActionMove));
-        winfoWrap.setIsResizable(winfo.actionSupported(NET::ActionResize));
-        winfoWrap.setIsShadeable(winfo.actionSupported(NET::ActionShade));
-        winfoWrap.setIsVirtualDesktopsChangeable(winfo.actionSupported(NET::ActionChangeDesktop));
-        //! END:Window Abilities
+    //!used to track Plasma DesktopView windows because during startup can not be identified properly
+    const bool plasmaBlockedWindow = (info.windowClass == QLatin1String("plasmashell")
+                                      && !isAcceptableWindow(info.wid, info.windowClass, info.hasSkipTaskbar, info.hasSkipPager, info.geometry));
 
-        winfoWrap.setDisplay(winfo.visibleName());
-        winfoWrap.setDesktops({QString(winfo.desktop())});
-        winfoWrap.setActivities(winfo.activities());
+    if (!info.exists || plasmaBlockedWindow) {
+        winfoWrap.setIsValid(false);
+    } else if (windowsTracker()->isValidFor(info.wid)
+               || isAcceptableWindow(info.wid, info.windowClass, info.hasSkipTaskbar, info.hasSkipPager, info.geometry)) {
+        winfoWrap = info.winfo;
     }
 
     if (plasmaBlockedWindow) {
-        windowRemoved(wid);
+        windowRemoved(info.wid);
     }
 
     return winfoWrap;
@@ -758,8 +726,15 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
 {
     const KWindowInfo info(wid.toUInt(), NET::WMGeometry | NET::WMState, NET::WM2WindowClass);
 
-    const auto winClass = QString(info.windowClassName());
+    return isAcceptableWindow(wid,
+                              QString(info.windowClassName()),
+                              info.hasState(NET::SkipTaskbar),
+                              info.hasState(NET::SkipPager),
+                              info.geometry());
+}
 
+bool XWindowInterface::isAcceptableWindow(const WindowId &wid, const QString &winClass, bool hasSkipTaskbar, bool hasSkipPager, const QRect &geometry)
+{
     //! ignored windows do not trackd
     if (hasBlockedTracking(wid)) {
         return false;
@@ -771,8 +746,6 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
     }
 
     //! Window Checks
-    bool hasSkipTaskbar = info.hasState(NET::SkipTaskbar);
-    bool hasSkipPager = info.hasState(NET::SkipPager);
     bool isSkipped = hasSkipTaskbar && hasSkipPager;
 
     if (isSkipped
@@ -780,16 +753,16 @@ bool XWindowInterface::isAcceptableWindow(WindowId wid)
                  || (winClass == QLatin1String("krunner"))) )) {
         registerWhitelistedWindow(wid);
     } else if (winClass == QLatin1String("plasmashell")) {
-        if (isSkipped && isSidepanel(info.geometry())) {
+        if (isSkipped && isSidepanel(geometry)) {
             registerWhitelistedWindow(wid);
             return true;
-        } else if (isPlasmaPanel(info.geometry()) || isFullScreenWindow(info.geometry())) {
+        } else if (isPlasmaPanel(geometry) || isFullScreenWindow(geometry)) {
             registerPlasmaIgnoredWindow(wid);
             return false;
         }
     } else if ((winClass == QLatin1String("latte-dock"))
                || (winClass == QLatin1String("ksmserver"))) {
-        if (isFullScreenWindow(info.geometry())) {
+        if (isFullScreenWindow(geometry)) {
             registerIgnoredWindow(wid);
             return false;
         }
@@ -25,6 +25,7 @@
 #include <config-latte.h>
 #include "abstractwindowinterface.h"
 #include "windowinfowrap.h"
+#include "xwindowinforeader.h"
 
 // Qt
 #include <QObject>
@@ -54,6 +55,7 @@ public:
     WindowId activeWindow() override;
     WindowInfoWrap requestInfo(WindowId wid) override;
     WindowInfoWrap requestInfoActive() override;
+    QList<WindowInfoWrap> requestInfos(const QList<WindowId> &wids) override;
 
     void skipTaskBar(const QDialog &dialog) override;
     void slideWindow(QWindow &view, Slide location) override;
@@ -87,11 +89,11 @@ public:
 
 private:
     bool isAcceptableWindow(WindowId wid);
+    bool isAcceptableWindow(const WindowId &wid, const QString &winClass, bool hasSkipTaskbar, bool hasSkipPager, const QRect &geometry);
     bool isValidWindow(WindowId wid);
 
-#if KF5_VERSION_MINOR >= 65
-    QRect visibleGeometry(const WindowId &wid, const QRect &frameGeometry) const;
-#endif
+    //! windows that are not tracked and are not acceptable are provided as invalid
+    WindowInfoWrap acceptedInfo(const XWindowInfoReader::Info &info);
 
     void windowAddedProxy(WId wid);
     void windowChangedProxy(WId wid, NET::Properties prop1, NET::Properties2 prop2);
@@ -104,6 +106,8 @@ private:
     //xcb_shape
     bool m_shapeExtensionChecked{false};
     bool m_shapeAvailable{false};
+
+    XWindowInfoReader m_infoReader;
 };
 
 }
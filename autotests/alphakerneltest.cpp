@@ -0,0 +1,187 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "pixelsfixture.h"
+#include "tools/alphakernel.h"
+#include "tools/alphakernel_p.h"
+
+// Qt
+#include <QtTest>
+#include <QVector>
+
+using Latte::alphaMax;
+using Latte::alphaSum;
+using PixelsFixture::Pixels;
+
+namespace {
+
+quint64 referenceSum(const QRgb *pixels, int count)
+{
+    quint64 sum{0};
+
+    for (int i = 0; i < count; ++i) {
+        sum += qAlpha(pixels[i]);
+    }
+
+    return sum;
+}
+
+int referenceMax(const QRgb *pixels, int count)
+{
+    int max{0};
+
+    for (int i = 0; i < count; ++i) {
+        max = qMax(max, qAlpha(pixels[i]));
+    }
+
+    return max;
+}
+
+struct Kernel {
+    QString name;
+    Latte::Kernels::AlphaSumKernel sum;
+    Latte::Kernels::AlphaMaxKernel max;
+};
+
+//! all kernels that the cpu can run
+QList<Kernel> supportedKernels()
+{
+    QList<Kernel> kernels{{"scalar", Latte::Kernels::alphaSumScalar, Latte::Kernels::alphaMaxScalar}};
+
+#ifdef LATTE_X86_KERNELS
+    if (Latte::CpuDispatch::supports(Latte::CpuDispatch::Sse2)) {
+        kernels << Kernel{"sse2", Latte::Kernels::alphaSumSse2, Latte::Kernels::alphaMaxSse2};
+    }
+
+    if (Latte::CpuDispatch::supports(Latte::CpuDispatch::Avx2)) {
+        kernels << Kernel{"avx2", Latte::Kernels::alphaSumAvx2, Latte::Kernels::alphaMaxAvx2};
+    } else {
+        qInfo() << "avx2 kernels are not verified, the cpu does not support them";
+    }
+#endif
+
+    kernels << Kernel{"dispatched", alphaSum, alphaMax};
+
+    return kernels;
+}
+
+}
+
+class AlphaKernelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void kernels_data();
+    void kernels();
+
+    void maxPosition_data();
+    void maxPosition();
+
+    void empty();
+};
+
+void AlphaKernelTest::kernels_data()
+{
+    QTest::addColumn<Pixels>("kind");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("offset");
+
+    //! lengths with all the tails that are not multiple of the 4 and 8 pixels vectors
+    QList<int> counts;
+
+    for (int count = 1; count <= 40; ++count) {
+        counts << count;
+    }
+
+    counts << 1023 << 1024 << 1025 << 65541;
+
+    //! color channels must never leak in alpha results
+    const QList<Pixels> kinds{Pixels::Random, Pixels::Opaque, Pixels::Saturated, Pixels::Transparent, Pixels::ColorsOnly};
+
+    for (const auto kind : kinds) {
+        for (const auto count : counts) {
+            for (const auto offset : PixelsFixture::offsets()) {
+                QTest::newRow(qPrintable(QString("%1 %2 +%3").arg(PixelsFixture::name(kind)).arg(count).arg(offset)))
+                        << kind << count << offset;
+            }
+        }
+    }
+}
+
+void AlphaKernelTest::kernels()
+{
+    QFETCH(Pixels, kind);
+    QFETCH(int, count);
+    QFETCH(int, offset);
+
+    QVector<QRgb> pixels = PixelsFixture::createPixels(kind, count + offset);
+    const QRgb *data = pixels.constData() + offset;
+
+    const quint64 expectedSum = referenceSum(data, count);
+    const int expectedMax = referenceMax(data, count);
+
+    for (const auto &kernel : supportedKernels()) {
+        QVERIFY2(kernel.sum(data, count) == expectedSum, qPrintable(kernel.name));
+        QVERIFY2(kernel.max(data, count) == expectedMax, qPrintable(kernel.name));
+    }
+}
+
+void AlphaKernelTest::maxPosition_data()
+{
+    QTest::addColumn<int>("count");
+
+    for (const auto count : {1, 3, 4, 7, 8, 9, 15, 16, 17, 23}) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+void AlphaKernelTest::maxPosition()
+{
+    QFETCH(int, count);
+
+    //! the single visible pixel is moved through the vector body and the tail
+    for (int position = 0; position < count; ++position) {
+        QVector<QRgb> pixels(count, qRgba(255, 255, 255, 1));
+        pixels[position] = qRgba(0, 0, 0, 200);
+
+        for (const auto &kernel : supportedKernels()) {
+            QVERIFY2(kernel.max(pixels.constData(), count) == 200, qPrintable(QString("%1 at %2").arg(kernel.name).arg(position)));
+            QVERIFY2(kernel.sum(pixels.constData(), count) == quint64(count - 1 + 200), qPrintable(QString("%1 at %2").arg(kernel.name).arg(position)));
+        }
+    }
+}
+
+void AlphaKernelTest::empty()
+{
+    QRgb pixel = qRgba(255, 255, 255, 255);
+
+    QCOMPARE(alphaSum(&pixel, 0), quint64(0));
+    QCOMPARE(alphaMax(&pixel, 0), 0);
+    QCOMPARE(alphaSum(nullptr, 0), quint64(0));
+    QCOMPARE(alphaMax(nullptr, 0), 0);
+    QCOMPARE(alphaSum(&pixel, -1), quint64(0));
+    QCOMPARE(alphaMax(&pixel, -1), 0);
+}
+
+QTEST_GUILESS_MAIN(AlphaKernelTest)
+
+#include "alphakerneltest.moc"
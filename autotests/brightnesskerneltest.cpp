@@ -0,0 +1,205 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "pixelsfixture.h"
+#include "tools/brightnesskernel.h"
+#include "tools/brightnesskernel_p.h"
+#include "tools/commontools.h"
+
+// Qt
+#include <QtTest>
+#include <QVector>
+
+using Latte::brightnessSum;
+using PixelsFixture::Pixels;
+
+namespace {
+
+//! exact sum that every kernel must return
+quint64 referenceSum(const QRgb *pixels, int count)
+{
+    quint64 sum{0};
+
+    for (int i = 0; i < count; ++i) {
+        sum += qRed(pixels[i]) * 299 + qGreen(pixels[i]) * 587 + qBlue(pixels[i]) * 114;
+    }
+
+    return sum;
+}
+
+//! brightness of an area as it was computed before the kernels were introduced
+float oldAreaBrightness(const QRgb *pixels, int count)
+{
+    float areaBrightness = -1000;
+
+    for (int i = 0; i < count; ++i) {
+        float pixelBrightness = Latte::colorBrightness(pixels[i]);
+        areaBrightness = (areaBrightness == -1000) ? pixelBrightness : (areaBrightness + pixelBrightness);
+    }
+
+    return areaBrightness;
+}
+
+struct Kernel {
+    QString name;
+    Latte::Kernels::BrightnessSumKernel sum;
+};
+
+//! all kernels that the cpu can run
+QList<Kernel> supportedKernels()
+{
+    QList<Kernel> kernels{{"scalar", Latte::Kernels::brightnessSumScalar}};
+
+#ifdef LATTE_X86_KERNELS
+    if (Latte::CpuDispatch::supports(Latte::CpuDispatch::Sse2)) {
+        kernels << Kernel{"sse2", Latte::Kernels::brightnessSumSse2};
+    }
+
+    if (Latte::CpuDispatch::supports(Latte::CpuDispatch::Avx2)) {
+        kernels << Kernel{"avx2", Latte::Kernels::brightnessSumAvx2};
+    } else {
+        qInfo() << "avx2 kernel is not verified, the cpu does not support it";
+    }
+#endif
+
+    return kernels;
+}
+
+}
+
+class BrightnessKernelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void kernels_data();
+    void kernels();
+
+    void dispatch_data();
+    void dispatch();
+
+    void oldLoop_data();
+    void oldLoop();
+
+    void empty();
+
+private:
+    void addRows(int maxCount);
+};
+
+void BrightnessKernelTest::addRows(int maxCount)
+{
+    QTest::addColumn<Pixels>("kind");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("offset");
+
+    //! lengths around the vector widths and the 32bit accumulators blocks
+    const QList<int> counts{1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33,
+                            4095, 4096, 4097, 4099, 8191, 8192, 8200, 12289, 262147};
+
+    //! alpha must never be part of the sum
+    const QList<Pixels> kinds{Pixels::Random, Pixels::Saturated, Pixels::Black, Pixels::ColorsOnly};
+
+    for (const auto kind : kinds) {
+        for (const auto count : counts) {
+            if (count > maxCount) {
+                continue;
+            }
+
+            for (const auto offset : PixelsFixture::offsets()) {
+                QTest::newRow(qPrintable(QString("%1 %2 +%3").arg(PixelsFixture::name(kind)).arg(count).arg(offset)))
+                        << kind << count << offset;
+            }
+        }
+    }
+}
+
+void BrightnessKernelTest::kernels_data()
+{
+    addRows(INT_MAX);
+}
+
+void BrightnessKernelTest::kernels()
+{
+    QFETCH(Pixels, kind);
+    QFETCH(int, count);
+    QFETCH(int, offset);
+
+    QVector<QRgb> pixels = PixelsFixture::createPixels(kind, count + offset);
+    const QRgb *data = pixels.constData() + offset;
+    const quint64 expected = referenceSum(data, count);
+
+    for (const auto &kernel : supportedKernels()) {
+        QVERIFY2(kernel.sum(data, count) == expected, qPrintable(kernel.name));
+    }
+}
+
+void BrightnessKernelTest::dispatch_data()
+{
+    addRows(INT_MAX);
+}
+
+void BrightnessKernelTest::dispatch()
+{
+    QFETCH(Pixels, kind);
+    QFETCH(int, count);
+    QFETCH(int, offset);
+
+    QVector<QRgb> pixels = PixelsFixture::createPixels(kind, count + offset);
+    const QRgb *data = pixels.constData() + offset;
+
+    QCOMPARE(brightnessSum(data, count), referenceSum(data, count));
+}
+
+void BrightnessKernelTest::oldLoop_data()
+{
+    //! the old float accumulation loses precision for bigger areas
+    addRows(12289);
+}
+
+void BrightnessKernelTest::oldLoop()
+{
+    QFETCH(Pixels, kind);
+    QFETCH(int, count);
+    QFETCH(int, offset);
+
+    QVector<QRgb> pixels = PixelsFixture::createPixels(kind, count + offset);
+    const QRgb *data = pixels.constData() + offset;
+
+    const double oldBrightness = oldAreaBrightness(data, count);
+    const double newBrightness = brightnessSum(data, count) / 1000.0;
+
+    QVERIFY2(qAbs(oldBrightness - newBrightness) <= 1e-3 * qMax(1.0, newBrightness),
+             qPrintable(QString("old: %1 new: %2").arg(oldBrightness, 0, 'f', 3).arg(newBrightness, 0, 'f', 3)));
+}
+
+void BrightnessKernelTest::empty()
+{
+    QRgb pixel = qRgba(255, 255, 255, 255);
+
+    QCOMPARE(brightnessSum(&pixel, 0), quint64(0));
+    QCOMPARE(brightnessSum(nullptr, 0), quint64(0));
+    QCOMPARE(brightnessSum(&pixel, -1), quint64(0));
+}
+
+QTEST_GUILESS_MAIN(BrightnessKernelTest)
+
+#include "brightnesskerneltest.moc"
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// local
+#include "layouts/idallocator.h"
+
+// Qt
+#include <QtTest>
+
+#define MAXID 32000
+
+using Latte::Layouts::IdAllocator;
+
+class IdAllocatorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sameAsScan_data();
+    void sameAsScan();
+    void invalidOccupiedIds();
+    void exhausted();
+};
+
+namespace {
+
+//! the availableId scan that was used from layouts storage before the allocator
+QString availableId(const QStringList &all, const QStringList &assigned, int base)
+{
+    int i = base;
+
+    while (i < MAXID) {
+        QString iStr = QString::number(i);
+
+        if (!all.contains(iStr) && !assigned.contains(iStr)) {
+            return iStr;
+        }
+
+        i++;
+    }
+
+    return QString("");
+}
+
+QStringList randomIds(int count, int maxId)
+{
+    QStringList ids;
+
+    for (int i = 0; i < count; ++i) {
+        ids << QString::number(qrand() % maxId);
+    }
+
+    return ids;
+}
+
+}
+
+void IdAllocatorTest::sameAsScan_data()
+{
+    QTest::addColumn<int>("seed");
+    QTest::addColumn<int>("occupiedCount");
+    QTest::addColumn<int>("maxOccupiedId");
+    QTest::addColumn<int>("containmentsCount");
+    QTest::addColumn<int>("appletsCount");
+    QTest::addColumn<bool>("interleaved");
+
+    QTest::newRow("empty corona") << 1 << 0 << 1 << 5 << 60 << false;
+    QTest::newRow("sparse corona") << 2 << 50 << 400 << 8 << 120 << false;
+    QTest::newRow("dense low ids") << 3 << 300 << 200 << 8 << 120 << false;
+    QTest::newRow("interleaved bases") << 4 << 150 << 300 << 20 << 200 << true;
+    QTest::newRow("2000 applets") << 5 << 2000 << 4000 << 40 << 2000 << false;
+}
+
+void IdAllocatorTest::sameAsScan()
+{
+    QFETCH(int, seed);
+    QFETCH(int, occupiedCount);
+    QFETCH(int, maxOccupiedId);
+    QFETCH(int, containmentsCount);
+    QFETCH(int, appletsCount);
+    QFETCH(bool, interleaved);
+
+    qsrand(seed);
+    const QStringList occupied = randomIds(occupiedCount, maxOccupiedId);
+
+    //! containments are assigned from 12 and applets from 40, same as the layouts import
+    QList<int> bases;
+
+    for (int i = 0; i < containmentsCount; ++i) {
+        bases << 12;
+    }
+
+    for (int i = 0; i < appletsCount; ++i) {
+        bases << 40;
+    }
+
+    if (interleaved) {
+        for (int i = bases.count() - 1; i > 0; --i) {
+            bases.swap(i, qrand() % (i + 1));
+        }
+    }
+
+    IdAllocator allocator(occupied);
+    QStringList assigned;
+
+    for (const auto base : bases) {
+        const QString expected = availableId(occupied, assigned, base);
+        assigned << expected;
+
+        QCOMPARE(allocator.takeAvailableId(base), expected);
+    }
+}
+
+void IdAllocatorTest::invalidOccupiedIds()
+{
+    const QStringList occupied{"abc", "-5", "", "12", "40000"};
+
+    IdAllocator allocator(occupied);
+
+    QCOMPARE(allocator.takeAvailableId(12), QString("13"));
+    QCOMPARE(allocator.takeAvailableId(0), QString("0"));
+    QCOMPARE(allocator.takeAvailableId(12), QString("14"));
+}
+
+void IdAllocatorTest::exhausted()
+{
+    QStringList occupied;
+
+    for (int i = 0; i < MAXID; ++i) {
+        if (i != MAXID - 10) {
+            occupied << QString::number(i);
+        }
+    }
+
+    IdAllocator allocator(occupied);
+
+    QCOMPARE(allocator.takeAvailableId(40), QString::number(MAXID - 10));
+    QCOMPARE(allocator.takeAvailableId(40), QString(""));
+    QCOMPARE(allocator.takeAvailableId(12), QString(""));
+}
+
+QTEST_GUILESS_MAIN(IdAllocatorTest)
+
+#include "idallocatortest.moc"
@@ -0,0 +1,366 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "layout/abstractlayout.h"
+#include "layouts/metadataindex.h"
+#include "layouts/storage.h"
+
+// Qt
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtTest>
+
+// KDE
+#include <KConfig>
+#include <KConfigGroup>
+
+using Latte::Layout::AbstractLayout;
+using Latte::Layouts::LayoutMetadata;
+using Latte::Layouts::MetadataIndex;
+
+class MetadataIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void defaults();
+    void abstractLayoutSettings_data();
+    void abstractLayoutSettings();
+    void centralLayoutSettings();
+
+    void brokenLayout_data();
+    void brokenLayout();
+
+    void roundTrip();
+    void outdatedLayout();
+    void retain();
+
+private:
+    QString layoutFile(const QString &name) const;
+
+    QTemporaryDir *m_dir{nullptr};
+};
+
+namespace {
+
+typedef QMap<QString, QString> Entries;
+
+void writeSettings(const QString &file, const Entries &settings)
+{
+    KConfig layoutFile(file, KConfig::SimpleConfig);
+    KConfigGroup layoutGroup(&layoutFile, "LayoutSettings");
+    layoutGroup.writeEntry("version", 2);
+
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        layoutGroup.writeEntry(it.key(), it.value());
+    }
+
+    layoutFile.sync();
+}
+
+//! "1:10,11;2:20" creates containments 1 and 2 with applets 10, 11 and 20.
+//! Applets ending with "*" keep only their PreloadWeight, like removed applets do
+void writeContainments(const QString &file, const QString &layout)
+{
+    KConfig layoutFile(file, KConfig::SimpleConfig);
+    KConfigGroup containments(&layoutFile, "Containments");
+
+    for (const auto &containment : layout.split(";", QString::SkipEmptyParts)) {
+        const QString cId = containment.section(":", 0, 0);
+        KConfigGroup containmentGroup = containments.group(cId);
+        containmentGroup.writeEntry("plugin", "org.kde.latte.containment");
+
+        for (QString appletId : containment.section(":", 1).split(",", QString::SkipEmptyParts)) {
+            const bool removed = appletId.endsWith("*");
+            appletId.remove("*");
+
+            KConfigGroup applet = containmentGroup.group("Applets").group(appletId);
+
+            if (removed) {
+                applet.group("Configuration").writeEntry("PreloadWeight", 42);
+            } else {
+                applet.writeEntry("plugin", "org.kde.latte.plasmoid");
+                applet.group("Configuration").group("General").writeEntry("showWindowActions", true);
+            }
+        }
+    }
+
+    layoutFile.sync();
+}
+
+void compareMetadata(const LayoutMetadata &metadata, const LayoutMetadata &expected)
+{
+    QCOMPARE(metadata.modified, expected.modified);
+    QCOMPARE(metadata.size, expected.size);
+    QVERIFY(metadata.layout == expected.layout);
+    QCOMPARE(metadata.sharedLayoutName, expected.sharedLayoutName);
+    QCOMPARE(metadata.isBroken, expected.isBroken);
+}
+
+}
+
+void MetadataIndexTest::init()
+{
+    m_dir = new QTemporaryDir();
+    QVERIFY(m_dir->isValid());
+}
+
+void MetadataIndexTest::cleanup()
+{
+    delete m_dir;
+    m_dir = nullptr;
+}
+
+QString MetadataIndexTest::layoutFile(const QString &name) const
+{
+    return m_dir->path() + "/" + name + ".layout.latte";
+}
+
+void MetadataIndexTest::defaults()
+{
+    const QString file = layoutFile("Empty");
+    writeSettings(file, Entries());
+    writeContainments(file, "1:10");
+
+    const LayoutMetadata metadata = MetadataIndex::readLayoutFile(file);
+
+    QCOMPARE(metadata.layout.id, file);
+    QCOMPARE(metadata.layout.name, QString("Empty"));
+    QCOMPARE(metadata.layout.color, QString("blue"));
+    QCOMPARE(metadata.layout.backgroundStyle, Latte::Layout::ColorBackgroundStyle);
+    QVERIFY(metadata.layout.icon.isEmpty());
+    QVERIFY(metadata.layout.background.isEmpty());
+    QVERIFY(metadata.layout.textColor.isEmpty());
+    QVERIFY(!metadata.layout.isShownInMenu);
+    QVERIFY(!metadata.layout.hasDisabledBorders);
+    QVERIFY(metadata.layout.activities.isEmpty());
+    QVERIFY(metadata.sharedLayoutName.isEmpty());
+    QVERIFY(!metadata.isBroken);
+
+    const QFileInfo info(file);
+    QCOMPARE(metadata.modified, info.lastModified().toMSecsSinceEpoch());
+    QCOMPARE(metadata.size, info.size());
+}
+
+void MetadataIndexTest::abstractLayoutSettings_data()
+{
+    QTest::addColumn<Entries>("settings");
+
+    QTest::newRow("default color") << Entries();
+    QTest::newRow("color") << Entries({{"color", "purple"}, {"icon", "favorites"}});
+    QTest::newRow("custom background") << Entries({{"color", "green"},
+                                                   {"backgroundStyle", "1"},
+                                                   {"customBackground", "/usr/share/wallpapers/custom.png"},
+                                                   {"customTextColor", "#ffffff"}});
+    QTest::newRow("custom background with color style") << Entries({{"backgroundStyle", "0"},
+                                                                    {"customBackground", "/usr/share/wallpapers/custom.png"},
+                                                                    {"customTextColor", "#101010"}});
+    QTest::newRow("deprecated background") << Entries({{"color", "red"},
+                                                       {"background", "/usr/share/wallpapers/old.png"},
+                                                       {"textColor", "#202020"},
+                                                       {"customBackground", "/usr/share/wallpapers/ignored.png"}});
+    QTest::newRow("deprecated color background") << Entries({{"background", "blue"},
+                                                             {"textColor", "#303030"},
+                                                             {"customTextColor", "#404040"}});
+}
+
+void MetadataIndexTest::abstractLayoutSettings()
+{
+    QFETCH(Entries, settings);
+
+    const QString file = layoutFile("My Layout");
+    writeSettings(file, settings);
+
+    const LayoutMetadata metadata = MetadataIndex::readLayoutFile(file);
+
+    //! AbstractLayout heals deprecated settings in its file, so it loads a copy
+    QDir(m_dir->path()).mkdir("loaded");
+    const QString loadedFile = m_dir->path() + "/loaded/My Layout.layout.latte";
+    QVERIFY(QFile::copy(file, loadedFile));
+
+    AbstractLayout layout(nullptr, loadedFile);
+
+    QCOMPARE(metadata.layout.name, layout.name());
+    QCOMPARE(metadata.layout.icon, layout.icon());
+    QCOMPARE(metadata.layout.color, layout.color());
+    QCOMPARE(metadata.layout.backgroundStyle, layout.backgroundStyle());
+    QCOMPARE(metadata.layout.background, layout.customBackground());
+    QCOMPARE(metadata.layout.textColor, layout.customTextColor());
+
+    if (settings.value("background").startsWith("/")) {
+        QCOMPARE(metadata.layout.backgroundStyle, Latte::Layout::PatternBackgroundStyle);
+        QCOMPARE(metadata.layout.background, settings.value("background"));
+        QCOMPARE(metadata.layout.textColor, settings.value("textColor"));
+    }
+
+    //! reading the metadata must never heal the layout file
+    KConfig layoutConfig(file, KConfig::SimpleConfig);
+    QCOMPARE(KConfigGroup(&layoutConfig, "LayoutSettings").readEntry("background", QString()), settings.value("background"));
+}
+
+void MetadataIndexTest::centralLayoutSettings()
+{
+    const QString file = layoutFile("Central");
+    writeSettings(file, Entries({{"showInMenu", "true"},
+                                 {"disableBordersForMaximizedWindows", "true"},
+                                 {"sharedLayout", "Shared"}}));
+
+    KConfig layoutConfig(file, KConfig::SimpleConfig);
+    const QStringList activities{"{1111-1111}", "{2222-2222}"};
+    KConfigGroup(&layoutConfig, "LayoutSettings").writeEntry("activities", activities);
+    layoutConfig.sync();
+
+    const LayoutMetadata metadata = MetadataIndex::readLayoutFile(file);
+
+    QVERIFY(metadata.layout.isShownInMenu);
+    QVERIFY(metadata.layout.hasDisabledBorders);
+    QCOMPARE(metadata.layout.activities, activities);
+    QCOMPARE(metadata.sharedLayoutName, QString("Shared"));
+}
+
+void MetadataIndexTest::brokenLayout_data()
+{
+    QTest::addColumn<QString>("containments");
+    QTest::addColumn<bool>("isBroken");
+
+    QTest::newRow("no containments") << QString() << false;
+    QTest::newRow("unique ids") << QString("1:10,11;2:20") << false;
+    QTest::newRow("duplicated applet ids") << QString("1:10,11;2:11") << true;
+    QTest::newRow("applet with containment id") << QString("1:10;2:1") << true;
+    QTest::newRow("removed applets are ignored") << QString("1:10,11*;2:11") << false;
+    QTest::newRow("removed applet with containment id") << QString("1:10;2:1*") << false;
+}
+
+void MetadataIndexTest::brokenLayout()
+{
+    QFETCH(QString, containments);
+    QFETCH(bool, isBroken);
+
+    const QString file = layoutFile("Broken");
+    writeSettings(file, Entries());
+    writeContainments(file, containments);
+
+    QCOMPARE(MetadataIndex::readLayoutFile(file).isBroken, isBroken);
+
+    //! same check as Storage::isBroken() does for layout files
+    KConfig layoutConfig(file, KConfig::SimpleConfig);
+    KConfigGroup containmentsGroup(&layoutConfig, "Containments");
+    QStringList ids = containmentsGroup.groupList();
+
+    for (const auto &cId : containmentsGroup.groupList()) {
+        KConfigGroup applets = containmentsGroup.group(cId).group("Applets");
+
+        for (const auto &appletId : applets.groupList()) {
+            if (Latte::Layouts::Storage::appletGroupIsValid(applets.group(appletId))) {
+                ids << appletId;
+            }
+        }
+    }
+
+    QCOMPARE(Latte::Layouts::Storage::hasDuplicatedIds(ids), isBroken);
+}
+
+void MetadataIndexTest::roundTrip()
+{
+    const QString file1 = layoutFile("First");
+    writeSettings(file1, Entries({{"color", "gold"},
+                                  {"icon", "favorites"},
+                                  {"showInMenu", "true"},
+                                  {"sharedLayout", "Shared"}}));
+    writeContainments(file1, "1:10");
+
+    const QString file2 = layoutFile("Second");
+    writeSettings(file2, Entries({{"background", "/usr/share/wallpapers/old.png"},
+                                  {"textColor", "#202020"},
+                                  {"disableBordersForMaximizedWindows", "true"}}));
+    writeContainments(file2, "1:10;2:10");
+
+    const LayoutMetadata metadata1 = MetadataIndex::readLayoutFile(file1);
+    const LayoutMetadata metadata2 = MetadataIndex::readLayoutFile(file2);
+    QVERIFY(metadata2.isBroken);
+
+    MetadataIndex index(m_dir->path());
+    QVERIFY(!index.contains(file1));
+
+    index.insert(file1, metadata1);
+    index.insert(file2, metadata2);
+    index.save();
+
+    QVERIFY(QFile::exists(m_dir->path() + "/layoutsmetadata"));
+
+    MetadataIndex loadedIndex(m_dir->path());
+    QVERIFY(loadedIndex.contains(file1));
+    QVERIFY(loadedIndex.contains(file2));
+    QVERIFY(loadedIndex.isUpToDate(file1));
+    QVERIFY(loadedIndex.isUpToDate(file2));
+
+    compareMetadata(loadedIndex.metadata(file1), metadata1);
+    compareMetadata(loadedIndex.metadata(file2), metadata2);
+    QCOMPARE(loadedIndex.metadata(file1).layout.id, file1);
+}
+
+void MetadataIndexTest::outdatedLayout()
+{
+    const QString file = layoutFile("Outdated");
+    writeSettings(file, Entries({{"color", "gold"}}));
+
+    MetadataIndex index(m_dir->path());
+    QVERIFY(!index.isUpToDate(file));
+
+    index.insert(file, MetadataIndex::readLayoutFile(file));
+    QVERIFY(index.isUpToDate(file));
+
+    writeSettings(file, Entries({{"color", "gold"}, {"icon", "favorites"}}));
+    QVERIFY(!index.isUpToDate(file));
+
+    QFile::remove(file);
+    QVERIFY(index.contains(file));
+    QVERIFY(!index.isUpToDate(file));
+}
+
+void MetadataIndexTest::retain()
+{
+    const QString file1 = layoutFile("First");
+    const QString file2 = layoutFile("Second");
+    writeSettings(file1, Entries());
+    writeSettings(file2, Entries());
+
+    MetadataIndex index(m_dir->path());
+    index.insert(file1, MetadataIndex::readLayoutFile(file1));
+    index.insert(file2, MetadataIndex::readLayoutFile(file2));
+    index.save();
+
+    index.retain({file2});
+    QVERIFY(!index.contains(file1));
+    QVERIFY(index.contains(file2));
+    index.save();
+
+    MetadataIndex loadedIndex(m_dir->path());
+    QVERIFY(!loadedIndex.contains(file1));
+    QVERIFY(loadedIndex.contains(file2));
+}
+
+QTEST_GUILESS_MAIN(MetadataIndexTest)
+
+#include "metadataindextest.moc"
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "parabolicengine.h"
+#include "parabolicitem.h"
+
+// Qt
+#include <QPair>
+#include <QtTest>
+#include <QVector>
+
+using Latte::ParabolicEngine;
+using Latte::ParabolicItem;
+
+namespace {
+
+using EdgeScale = QPair<qreal, qreal>;
+
+//! tasks scale updates as they were handled in QML before the engine, every
+//! request was sent to all tasks and to the parabolic ability that was
+//! informing the host for the updates that were passing the first or the last task
+class QmlParabolic
+{
+public:
+    QmlParabolic(const QVector<bool> &zoomable, const QVector<qreal> &scales)
+        : m_zoomable(zoomable),
+          m_scales(scales)
+    {
+    }
+
+    QVector<qreal> scales() const
+    {
+        return m_scales;
+    }
+
+    QList<EdgeScale> lowerEdge() const
+    {
+        return m_lowerEdge;
+    }
+
+    QList<EdgeScale> higherEdge() const
+    {
+        return m_higherEdge;
+    }
+
+    void sglUpdateLowerItemScale(int delegateIndex, qreal newScale, qreal step)
+    {
+        //! ParabolicEffect::sltTrackLowerItemScale
+        if (delegateIndex == -1) {
+            m_lowerEdge << EdgeScale(newScale, step);
+        } else if (newScale == 1 && delegateIndex >= 0) {
+            m_lowerEdge << EdgeScale(1, 0);
+        }
+
+        //! task Wrapper::sltUpdateLowerItemScale
+        for (int index = 0; index < m_scales.count(); ++index) {
+            if (delegateIndex == index) {
+                if (m_zoomable[index]) {
+                    m_scales[index] = newScale;
+
+                    if (newScale > 1) {
+                        sglUpdateLowerItemScale(delegateIndex - 1, 1, 0);
+                    }
+                } else {
+                    sglUpdateLowerItemScale(delegateIndex - 1, newScale, step);
+                }
+            } else if (newScale == 1 && index < delegateIndex) {
+                m_scales[index] = 1;
+            }
+        }
+    }
+
+    void sglUpdateHigherItemScale(int delegateIndex, qreal newScale, qreal step)
+    {
+        //! ParabolicEffect::sltTrackHigherItemScale
+        if (delegateIndex >= m_scales.count()) {
+            m_higherEdge << EdgeScale(newScale, step);
+        } else if (newScale == 1 && delegateIndex < m_scales.count()) {
+            m_higherEdge << EdgeScale(1, 0);
+        }
+
+        //! task Wrapper::sltUpdateHigherItemScale
+        for (int index = 0; index < m_scales.count(); ++index) {
+            if (delegateIndex == index) {
+                if (m_zoomable[index]) {
+                    m_scales[index] = newScale;
+
+                    if (newScale > 1) {
+                        sglUpdateHigherItemScale(delegateIndex + 1, 1, 0);
+                    }
+                } else {
+                    sglUpdateHigherItemScale(delegateIndex + 1, newScale, step);
+                }
+            } else if (newScale == 1 && index > delegateIndex) {
+                m_scales[index] = 1;
+            }
+        }
+    }
+
+private:
+    QVector<bool> m_zoomable;
+    QVector<qreal> m_scales;
+
+    QList<EdgeScale> m_lowerEdge;
+    QList<EdgeScale> m_higherEdge;
+};
+
+//! engine whose items apply the scales they receive, the same way the task
+//! wrappers are doing through their parabolic item
+class TestEngine
+{
+public:
+    TestEngine(const QVector<bool> &zoomable, const QVector<qreal> &scales)
+    {
+        m_engine.setCount(zoomable.count());
+
+        for (int index = 0; index < zoomable.count(); ++index) {
+            ParabolicItem *item = qobject_cast<ParabolicItem *>(m_engine.item(index));
+            item->setZoomable(zoomable[index]);
+            item->setCurrentScale(scales[index]);
+
+            QObject::connect(item, &ParabolicItem::sglUpdateScale, item, [item](qreal newScale, qreal step) {
+                Q_UNUSED(step)
+                item->setCurrentScale(newScale);
+            });
+
+            m_items << item;
+        }
+
+        QObject::connect(&m_engine, &ParabolicEngine::sglUpdateLowerEdgeScale, [this](qreal newScale, qreal step) {
+            m_lowerEdge << EdgeScale(newScale, step);
+        });
+
+        QObject::connect(&m_engine, &ParabolicEngine::sglUpdateHigherEdgeScale, [this](qreal newScale, qreal step) {
+            m_higherEdge << EdgeScale(newScale, step);
+        });
+    }
+
+    ParabolicEngine *engine()
+    {
+        return &m_engine;
+    }
+
+    QVector<qreal> scales() const
+    {
+        QVector<qreal> scales;
+
+        for (const auto item : m_items) {
+            scales << item->currentScale();
+        }
+
+        return scales;
+    }
+
+    QList<EdgeScale> lowerEdge() const
+    {
+        return m_lowerEdge;
+    }
+
+    QList<EdgeScale> higherEdge() const
+    {
+        return m_higherEdge;
+    }
+
+private:
+    ParabolicEngine m_engine;
+    QVector<ParabolicItem *> m_items;
+
+    QList<EdgeScale> m_lowerEdge;
+    QList<EdgeScale> m_higherEdge;
+};
+
+//! Z is a zoomable task, S a separator and H a hidden task
+QVector<bool> zoomableItems(const QString &layout)
+{
+    QVector<bool> zoomable;
+
+    for (const auto &task : layout) {
+        zoomable << (task == QLatin1Char('Z'));
+    }
+
+    return zoomable;
+}
+
+QVector<qreal> initialScales(const QVector<bool> &zoomable, bool zoomed)
+{
+    QVector<qreal> scales(zoomable.count(), 1);
+
+    if (zoomed) {
+        for (int index = 0; index < zoomable.count(); ++index) {
+            if (zoomable[index]) {
+                scales[index] = (index % 2 == 0) ? 1.2 : 1.6;
+            }
+        }
+    }
+
+    return scales;
+}
+
+//! the QML edge signals that were repeating the same restoring
+//! scale are not important, the host keeps only the last one
+QList<EdgeScale> lastEdgeScale(const QList<EdgeScale> &edge)
+{
+    return edge.mid(edge.count() - 1);
+}
+
+}
+
+class ParabolicEngineTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void updateItemScale_data();
+    void updateItemScale();
+
+    void parabolicEffect_data();
+    void parabolicEffect();
+
+    void notRequestedItems();
+};
+
+void ParabolicEngineTest::updateItemScale_data()
+{
+    QTest::addColumn<QString>("layout");
+    QTest::addColumn<bool>("zoomed");
+    QTest::addColumn<bool>("lower");
+    QTest::addColumn<int>("delegateIndex");
+    QTest::addColumn<qreal>("newScale");
+    QTest::addColumn<qreal>("step");
+
+    //! separators and hidden tasks at the edges, in the middle and in a row
+    const QStringList layouts{"", "Z", "S", "ZZZZZ", "SZZZS", "ZSZHZ", "HHZZ", "ZZSS", "ZSSHZSZ", "SHS"};
+
+    for (const auto &layout : layouts) {
+        for (const auto zoomed : {false, true}) {
+            for (const auto lower : {true, false}) {
+                //! requests from the first and the last task neighbours reach the edges
+                for (int delegateIndex = -1; delegateIndex <= layout.count(); ++delegateIndex) {
+                    for (const auto newScale : {1.0, 1.35}) {
+                        for (const auto step : {0.0, 0.5}) {
+                            QTest::newRow(qPrintable(QString("%1 %2 %3 %4 %5 %6")
+                                                     .arg(layout.isEmpty() ? QStringLiteral("empty") : layout)
+                                                     .arg(zoomed ? "zoomed" : "restored")
+                                                     .arg(lower ? "lower" : "higher")
+                                                     .arg(delegateIndex).arg(newScale).arg(step)))
+                                    << layout << zoomed << lower << delegateIndex << newScale << step;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ParabolicEngineTest::updateItemScale()
+{
+    QFETCH(QString, layout);
+    QFETCH(bool, zoomed);
+    QFETCH(bool, lower);
+    QFETCH(int, delegateIndex);
+    QFETCH(qreal, newScale);
+    QFETCH(qreal, step);
+
+    const QVector<bool> zoomable = zoomableItems(layout);
+    const QVector<qreal> scales = initialScales(zoomable, zoomed);
+
+    QmlParabolic qml(zoomable, scales);
+    TestEngine engine(zoomable, scales);
+
+    if (lower) {
+        qml.sglUpdateLowerItemScale(delegateIndex, newScale, step);
+        engine.engine()->updateLowerItemScale(delegateIndex, newScale, step);
+    } else {
+        qml.sglUpdateHigherItemScale(delegateIndex, newScale, step);
+        engine.engine()->updateHigherItemScale(delegateIndex, newScale, step);
+    }
+
+    QCOMPARE(engine.scales(), qml.scales());
+    QCOMPARE(lastEdgeScale(engine.lowerEdge()), lastEdgeScale(qml.lowerEdge()));
+    QCOMPARE(lastEdgeScale(engine.higherEdge()), lastEdgeScale(qml.higherEdge()));
+}
+
+void ParabolicEngineTest::parabolicEffect_data()
+{
+    QTest::addColumn<QString>("layout");
+    QTest::addColumn<int>("index");
+    QTest::addColumn<qreal>("mousePosition");
+    QTest::addColumn<bool>("reversed");
+
+    const QStringList layouts{"ZZZZZ", "ZSZHZ", "SZS"};
+
+    for (const auto &layout : layouts) {
+        for (int index = 0; index < layout.count(); ++index) {
+            if (layout[index] != QLatin1Char('Z')) {
+                continue;
+            }
+
+            //! the task center is at 24, the mouse is before, on and after it
+            for (const auto mousePosition : {2.0, 24.0, 40.0}) {
+                for (const auto reversed : {false, true}) {
+                    QTest::newRow(qPrintable(QString("%1 %2 %3 %4").arg(layout).arg(index).arg(mousePosition).arg(reversed ? "reversed" : "")))
+                            << layout << index << mousePosition << reversed;
+                }
+            }
+        }
+    }
+}
+
+void ParabolicEngineTest::parabolicEffect()
+{
+    QFETCH(QString, layout);
+    QFETCH(int, index);
+    QFETCH(qreal, mousePosition);
+    QFETCH(bool, reversed);
+
+    const qreal zoom = 1.6;
+    const qreal center = 24;
+
+    //! ParabolicEffect::applyParabolicEffect before the engine
+    bool positiveDirection = (mousePosition - center) >= 0;
+
+    if (reversed) {
+        positiveDirection = !positiveDirection;
+    }
+
+    const qreal zoomCenter = (zoom - 1) / 2;
+    const qreal firstComputation = (qAbs(mousePosition - center) / center) * zoomCenter;
+    const qreal bigNeighbourZoom = qMin(1 + zoomCenter + firstComputation, zoom);
+    const qreal smallNeighbourZoom = qMax(1 + zoomCenter - firstComputation, 1.0);
+
+    const qreal leftScale = positiveDirection ? smallNeighbourZoom : bigNeighbourZoom;
+    const qreal rightScale = positiveDirection ? bigNeighbourZoom : smallNeighbourZoom;
+
+    const QVector<bool> zoomable = zoomableItems(layout);
+    const QVector<qreal> scales = initialScales(zoomable, false);
+
+    QmlParabolic qml(zoomable, scales);
+    qml.sglUpdateHigherItemScale(index + 1, rightScale, 0);
+    qml.sglUpdateLowerItemScale(index - 1, leftScale, 0);
+
+    TestEngine engine(zoomable, scales);
+    engine.engine()->setZoom(zoom);
+    engine.engine()->setReversed(reversed);
+
+    const QVariantMap neighbourScales = engine.engine()->applyParabolicEffect(index, mousePosition, center);
+
+    QCOMPARE(neighbourScales["leftScale"].toReal(), leftScale);
+    QCOMPARE(neighbourScales["rightScale"].toReal(), rightScale);
+
+    QCOMPARE(engine.scales(), qml.scales());
+    QCOMPARE(lastEdgeScale(engine.lowerEdge()), lastEdgeScale(qml.lowerEdge()));
+    QCOMPARE(lastEdgeScale(engine.higherEdge()), lastEdgeScale(qml.higherEdge()));
+}
+
+void ParabolicEngineTest::notRequestedItems()
+{
+    //! tasks that have not requested their item yet are considered zoomable
+    //! and the requests that reach them are not crashing the engine
+    ParabolicEngine engine;
+    engine.setCount(4);
+
+    ParabolicItem *first = qobject_cast<ParabolicItem *>(engine.item(0));
+    QSignalSpy firstSpy(first, &ParabolicItem::sglUpdateScale);
+    QSignalSpy lowerEdgeSpy(&engine, &ParabolicEngine::sglUpdateLowerEdgeScale);
+    QSignalSpy higherEdgeSpy(&engine, &ParabolicEngine::sglUpdateHigherEdgeScale);
+
+    engine.updateHigherItemScale(2, 1.4, 0);
+    QCOMPARE(firstSpy.count(), 0);
+    QCOMPARE(higherEdgeSpy.count(), 1);
+    QCOMPARE(higherEdgeSpy.last().at(0).toReal(), 1.0);
+
+    engine.updateLowerItemScale(1, 1.4, 0);
+    QCOMPARE(firstSpy.count(), 0);
+    QCOMPARE(lowerEdgeSpy.count(), 1);
+
+    first->setCurrentScale(1.3);
+    engine.updateLowerItemScale(3, 1, 0);
+    QCOMPARE(firstSpy.count(), 1);
+    QCOMPARE(firstSpy.last().at(0).toReal(), 1.0);
+
+    QVERIFY(!engine.item(-1));
+}
+
+QTEST_GUILESS_MAIN(ParabolicEngineTest)
+
+#include "parabolicenginetest.moc"
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PIXELSFIXTURE_H
+#define PIXELSFIXTURE_H
+
+// Qt
+#include <QList>
+#include <QMetaType>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QRgb>
+#include <QString>
+#include <QVector>
+
+//! Pixels that the image kernels tests are verified with, the random
+//! pixels are seeded from their count and as such they are reproducible
+
+namespace PixelsFixture {
+
+enum class Pixels
+{
+    Random,
+    Opaque,
+    Saturated,
+    Black,
+    Transparent,
+    ColorsOnly
+};
+
+inline QVector<QRgb> createPixels(Pixels kind, int count)
+{
+    QVector<QRgb> pixels(count);
+    QRandomGenerator generator(quint32(count));
+
+    for (int i = 0; i < count; ++i) {
+        switch (kind) {
+        case Pixels::Random:
+            pixels[i] = qRgba(generator.bounded(256), generator.bounded(256), generator.bounded(256), generator.bounded(256));
+            break;
+        case Pixels::Opaque:
+            pixels[i] = qRgba(generator.bounded(256), generator.bounded(256), generator.bounded(256), 255);
+            break;
+        case Pixels::Saturated:
+            pixels[i] = qRgba(255, 255, 255, 255);
+            break;
+        case Pixels::Black:
+            pixels[i] = qRgba(0, 0, 0, 255);
+            break;
+        case Pixels::Transparent:
+            pixels[i] = qRgba(0, 0, 0, 0);
+            break;
+        case Pixels::ColorsOnly:
+            //! colors without alpha, they must never leak in alpha results
+            //! and alpha must never leak in colors results
+            pixels[i] = qRgba(generator.bounded(256), generator.bounded(256), generator.bounded(256), 0);
+            break;
+        }
+    }
+
+    return pixels;
+}
+
+inline QString name(Pixels kind)
+{
+    switch (kind) {
+    case Pixels::Random:
+        return QStringLiteral("random");
+    case Pixels::Opaque:
+        return QStringLiteral("opaque");
+    case Pixels::Saturated:
+        return QStringLiteral("saturated");
+    case Pixels::Black:
+        return QStringLiteral("black");
+    case Pixels::Transparent:
+        return QStringLiteral("transparent");
+    case Pixels::ColorsOnly:
+        return QStringLiteral("colors only");
+    }
+
+    return QString();
+}
+
+//! offsets that are not multiple of 4 pixels produce unaligned loads
+inline QList<int> offsets()
+{
+    return {0, 1, 3};
+}
+
+}
+
+Q_DECLARE_METATYPE(PixelsFixture::Pixels)
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "view/helpers/regionsunion.h"
+
+// Qt
+#include <QHash>
+#include <QtTest>
+
+using Latte::ViewPart::RegionsUnion;
+
+class RegionsUnionTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void unchanged();
+    void randomChanges();
+};
+
+namespace {
+
+QRegion naiveUnion(const QHash<QString, QRegion> &regions)
+{
+    QRegion result;
+
+    for (const auto &region : regions) {
+        result = result.united(region);
+    }
+
+    return result;
+}
+
+}
+
+void RegionsUnionTest::empty()
+{
+    RegionsUnion regions;
+
+    QVERIFY(regions.isEmpty());
+    QVERIFY(regions.united().isEmpty());
+    QVERIFY(!regions.removeRegion("missing"));
+}
+
+void RegionsUnionTest::unchanged()
+{
+    RegionsUnion regions;
+
+    QVERIFY(regions.setRegion("a", QRegion(0, 0, 10, 10)));
+    QVERIFY(!regions.setRegion("a", QRegion(0, 0, 10, 10)));
+    QVERIFY(regions.contains("a"));
+
+    QVERIFY(regions.removeRegion("a"));
+    QVERIFY(!regions.contains("a"));
+    QVERIFY(regions.united().isEmpty());
+}
+
+void RegionsUnionTest::randomChanges()
+{
+    RegionsUnion regions;
+    QHash<QString, QRegion> expected;
+
+    qsrand(2020);
+
+    //! enough ids for the tree to grow a few times and for removed leaves to be reused
+    for (int i = 0; i < 5000; ++i) {
+        const QString id = QString::number(qrand() % 70);
+
+        if (qrand() % 4 == 0) {
+            QCOMPARE(regions.removeRegion(id), expected.contains(id));
+            expected.remove(id);
+        } else {
+            const QRegion region(qrand() % 400, qrand() % 60, 1 + qrand() % 50, 1 + qrand() % 20);
+            QCOMPARE(regions.setRegion(id, region), !expected.contains(id) || expected[id] != region);
+            expected[id] = region;
+        }
+
+        QCOMPARE(regions.united(), naiveUnion(expected));
+        QCOMPARE(regions.isEmpty(), expected.isEmpty());
+    }
+}
+
+QTEST_GUILESS_MAIN(RegionsUnionTest)
+
+#include "regionsuniontest.moc"
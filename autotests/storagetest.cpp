@@ -0,0 +1,303 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "layouts/storage.h"
+
+// Qt
+#include <QtTest>
+
+// KDE
+#include <KConfig>
+#include <KConfigGroup>
+
+using Latte::Layouts::Storage;
+
+class StorageTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void groupsAreEqual();
+
+    void firstSync();
+    void unchangedLayout();
+    void changedApplet();
+    void removedApplet();
+    void addedContainment();
+    void removedContainment();
+    void layoutId();
+
+private:
+    QList<KConfigGroup> containments() const;
+    bool sync(QStringList &changedIds, QStringList &removedIds);
+
+    //! containments as they are loaded in corona and as they are stored in the layout file
+    KConfig *m_corona{nullptr};
+    KConfig *m_layoutFile{nullptr};
+
+    QStringList m_containmentIds;
+};
+
+namespace {
+
+void writeContainment(KConfigGroup containments, const QString &cId, const QString &appletId)
+{
+    KConfigGroup containment = containments.group(cId);
+    containment.writeEntry("plugin", "org.kde.latte.containment");
+    containment.writeEntry("layoutId", "My Layout");
+    containment.writeEntry("location", 4);
+    containment.group("General").writeEntry("iconSize", 64);
+
+    KConfigGroup applet = containment.group("Applets").group(appletId);
+    applet.writeEntry("plugin", "org.kde.latte.plasmoid");
+    applet.group("Configuration").group("General").writeEntry("showWindowActions", true);
+}
+
+}
+
+void StorageTest::init()
+{
+    m_corona = new KConfig(QString(), KConfig::SimpleConfig);
+    m_layoutFile = new KConfig(QString(), KConfig::SimpleConfig);
+
+    KConfigGroup coronaContainments(m_corona, "Containments");
+    writeContainment(coronaContainments, "1", "3");
+    writeContainment(coronaContainments, "2", "4");
+
+    m_containmentIds = QStringList({"1", "2"});
+}
+
+void StorageTest::cleanup()
+{
+    delete m_corona;
+    delete m_layoutFile;
+
+    m_corona = nullptr;
+    m_layoutFile = nullptr;
+}
+
+QList<KConfigGroup> StorageTest::containments() const
+{
+    KConfigGroup coronaContainments(m_corona, "Containments");
+
+    QList<KConfigGroup> groups;
+
+    for (const auto &cId : m_containmentIds) {
+        groups << coronaContainments.group(cId);
+    }
+
+    return groups;
+}
+
+bool StorageTest::sync(QStringList &changedIds, QStringList &removedIds)
+{
+    KConfigGroup storedContainments(m_layoutFile, "Containments");
+
+    changedIds.clear();
+    removedIds.clear();
+
+    bool changed = Storage::syncContainments(containments(), storedContainments, changedIds, removedIds);
+
+    changedIds.sort();
+    removedIds.sort();
+
+    return changed;
+}
+
+void StorageTest::groupsAreEqual()
+{
+    KConfig config(QString(), KConfig::SimpleConfig);
+
+    KConfigGroup group1(&config, "Group1");
+    group1.writeEntry("a", 1);
+    group1.group("Sub1").writeEntry("b", 2);
+    group1.group("Sub2").group("Nested").writeEntry("c", 3);
+
+    //! same content that is written in different order
+    KConfigGroup group2(&config, "Group2");
+    group2.group("Sub2").group("Nested").writeEntry("c", 3);
+    group2.group("Sub1").writeEntry("b", 2);
+    group2.writeEntry("a", 1);
+
+    QVERIFY(Storage::groupsAreEqual(group1, group2));
+    QVERIFY(Storage::groupsAreEqual(group2, group1));
+
+    group2.group("Sub2").group("Nested").writeEntry("c", 4);
+    QVERIFY(!Storage::groupsAreEqual(group1, group2));
+    group2.group("Sub2").group("Nested").writeEntry("c", 3);
+
+    group2.writeEntry("d", 5);
+    QVERIFY(!Storage::groupsAreEqual(group1, group2));
+    group2.deleteEntry("d");
+    QVERIFY(Storage::groupsAreEqual(group1, group2));
+
+    group2.group("Sub3").writeEntry("e", 6);
+    QVERIFY(!Storage::groupsAreEqual(group1, group2));
+    QVERIFY(!Storage::groupsAreEqual(group2, group1));
+    group2.deleteGroup("Sub3");
+    QVERIFY(Storage::groupsAreEqual(group1, group2));
+
+    group2.group("Sub1").deleteGroup();
+    group2.group("Renamed").writeEntry("b", 2);
+    QVERIFY(!Storage::groupsAreEqual(group1, group2));
+}
+
+void StorageTest::firstSync()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+    QCOMPARE(changedIds, QStringList({"1", "2"}));
+    QVERIFY(removedIds.isEmpty());
+
+    KConfigGroup storedContainments(m_layoutFile, "Containments");
+    QCOMPARE(storedContainments.group("2").group("Applets").group("4").readEntry("plugin", QString()), QString("org.kde.latte.plasmoid"));
+}
+
+void StorageTest::unchangedLayout()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    //! the stored containments are kept in order to verify that nothing was written
+    KConfig snapshot(QString(), KConfig::SimpleConfig);
+    KConfigGroup snapshotContainments(&snapshot, "Containments");
+    KConfigGroup(m_layoutFile, "Containments").copyTo(&snapshotContainments);
+
+    QVERIFY(!sync(changedIds, removedIds));
+    QVERIFY(changedIds.isEmpty());
+    QVERIFY(removedIds.isEmpty());
+
+    QVERIFY(Storage::groupsAreEqual(KConfigGroup(m_layoutFile, "Containments"), snapshotContainments));
+}
+
+void StorageTest::changedApplet()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    KConfigGroup coronaContainments(m_corona, "Containments");
+    coronaContainments.group("2").group("Applets").group("4").group("Configuration").group("General").writeEntry("showWindowActions", false);
+
+    QVERIFY(sync(changedIds, removedIds));
+    QCOMPARE(changedIds, QStringList({"2"}));
+    QVERIFY(removedIds.isEmpty());
+
+    KConfigGroup storedContainments(m_layoutFile, "Containments");
+    QCOMPARE(storedContainments.group("2").group("Applets").group("4").group("Configuration").group("General").readEntry("showWindowActions", true), false);
+    QCOMPARE(storedContainments.group("1").group("Applets").group("3").group("Configuration").group("General").readEntry("showWindowActions", false), true);
+
+    QVERIFY(!sync(changedIds, removedIds));
+}
+
+void StorageTest::removedApplet()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    //! the stored containment is replaced, removed applets must not be kept
+    KConfigGroup coronaContainments(m_corona, "Containments");
+    coronaContainments.group("1").group("Applets").deleteGroup("3");
+    coronaContainments.group("1").group("Applets").group("5").writeEntry("plugin", "org.kde.plasma.analogclock");
+
+    QVERIFY(sync(changedIds, removedIds));
+    QCOMPARE(changedIds, QStringList({"1"}));
+
+    KConfigGroup storedApplets = KConfigGroup(m_layoutFile, "Containments").group("1").group("Applets");
+    QVERIFY(!storedApplets.hasGroup("3"));
+    QVERIFY(storedApplets.hasGroup("5"));
+
+    QVERIFY(!sync(changedIds, removedIds));
+}
+
+void StorageTest::addedContainment()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    writeContainment(KConfigGroup(m_corona, "Containments"), "6", "7");
+    m_containmentIds << "6";
+
+    QVERIFY(sync(changedIds, removedIds));
+    QCOMPARE(changedIds, QStringList({"6"}));
+    QVERIFY(removedIds.isEmpty());
+    QVERIFY(KConfigGroup(m_layoutFile, "Containments").hasGroup("6"));
+}
+
+void StorageTest::removedContainment()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    KConfigGroup(m_corona, "Containments").deleteGroup("2");
+    m_containmentIds.removeAll("2");
+
+    QVERIFY(sync(changedIds, removedIds));
+    QVERIFY(changedIds.isEmpty());
+    QCOMPARE(removedIds, QStringList({"2"}));
+
+    KConfigGroup storedContainments(m_layoutFile, "Containments");
+    QVERIFY(!storedContainments.hasGroup("2"));
+    QVERIFY(storedContainments.hasGroup("1"));
+}
+
+void StorageTest::layoutId()
+{
+    QStringList changedIds;
+    QStringList removedIds;
+
+    QVERIFY(sync(changedIds, removedIds));
+
+    KConfigGroup storedContainments(m_layoutFile, "Containments");
+
+    for (const auto &cId : m_containmentIds) {
+        QVERIFY(storedContainments.group(cId).hasKey("layoutId"));
+        QCOMPARE(storedContainments.group(cId).readEntry("layoutId", QString("missing")), QString());
+    }
+
+    //! the loaded containments layoutId is not touched and it is never a reason to write
+    KConfigGroup coronaContainments(m_corona, "Containments");
+    QCOMPARE(coronaContainments.group("1").readEntry("layoutId", QString()), QString("My Layout"));
+
+    coronaContainments.group("1").writeEntry("layoutId", "Other Layout");
+    QVERIFY(!sync(changedIds, removedIds));
+
+    coronaContainments.group("1").writeEntry("layoutId", "");
+    QVERIFY(!sync(changedIds, removedIds));
+}
+
+QTEST_GUILESS_MAIN(StorageTest)
+
+#include "storagetest.moc"
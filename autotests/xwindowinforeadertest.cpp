@@ -0,0 +1,274 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// local
+#include "wm/xwindowinforeader.h"
+
+// Qt
+#include <QGuiApplication>
+#include <QtTest>
+#include <QtX11Extras/QX11Info>
+
+// X11
+#include <xcb/xcb.h>
+
+//! ICCCM WM_STATE values
+#define WMSTATEWITHDRAWN 0
+#define WMSTATENORMAL 1
+
+using Latte::WindowSystem::WindowId;
+using Latte::WindowSystem::WindowInfoWrap;
+using Latte::WindowSystem::XWindowInfoReader;
+
+class XWindowInfoReaderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void sameAsSingleRequest();
+
+private:
+    xcb_window_t createWindow(const QRect &geometry);
+    quint32 atom(const QByteArray &name);
+
+    void setCardinals(xcb_window_t window, const QByteArray &property, quint32 type, const QVector<quint32> &values);
+    void setAtoms(xcb_window_t window, const QByteArray &property, const QList<QByteArray> &names);
+    void setBytes(xcb_window_t window, const QByteArray &property, quint32 type, const QByteArray &value);
+    void setMappingState(xcb_window_t window, quint32 state);
+
+    void compare(const XWindowInfoReader::Info &single, const XWindowInfoReader::Info &batched);
+
+private:
+    QList<xcb_window_t> m_windows;
+};
+
+void XWindowInfoReaderTest::initTestCase()
+{
+    if (!QX11Info::isPlatformX11()) {
+        QSKIP("an X11 display is needed in order to create windows");
+    }
+}
+
+void XWindowInfoReaderTest::cleanupTestCase()
+{
+    if (!QX11Info::isPlatformX11()) {
+        return;
+    }
+
+    for (const auto window : m_windows) {
+        xcb_destroy_window(QX11Info::connection(), window);
+    }
+
+    xcb_flush(QX11Info::connection());
+}
+
+xcb_window_t XWindowInfoReaderTest::createWindow(const QRect &geometry)
+{
+    xcb_connection_t *c = QX11Info::connection();
+    const xcb_window_t window = xcb_generate_id(c);
+
+    xcb_create_window(c, XCB_COPY_FROM_PARENT, window, QX11Info::appRootWindow(),
+                      geometry.x(), geometry.y(), geometry.width(), geometry.height(),
+                      0, XCB_WINDOW_CLASS_INPUT_OUTPUT, XCB_COPY_FROM_PARENT, 0, nullptr);
+
+    m_windows << window;
+
+    return window;
+}
+
+quint32 XWindowInfoReaderTest::atom(const QByteArray &name)
+{
+    xcb_connection_t *c = QX11Info::connection();
+    QScopedPointer<xcb_intern_atom_reply_t, QScopedPointerPodDeleter> reply(
+                xcb_intern_atom_reply(c, xcb_intern_atom(c, false, name.length(), name.constData()), nullptr));
+
+    return reply ? reply->atom : XCB_ATOM_NONE;
+}
+
+void XWindowInfoReaderTest::setCardinals(xcb_window_t window, const QByteArray &property, quint32 type, const QVector<quint32> &values)
+{
+    xcb_change_property(QX11Info::connection(), XCB_PROP_MODE_REPLACE, window, atom(property), type, 32, values.count(), values.constData());
+}
+
+void XWindowInfoReaderTest::setAtoms(xcb_window_t window, const QByteArray &property, const QList<QByteArray> &names)
+{
+    QVector<quint32> atoms;
+
+    for (const auto &name : names) {
+        atoms << atom(name);
+    }
+
+    setCardinals(window, property, XCB_ATOM_ATOM, atoms);
+}
+
+void XWindowInfoReaderTest::setBytes(xcb_window_t window, const QByteArray &property, quint32 type, const QByteArray &value)
+{
+    xcb_change_property(QX11Info::connection(), XCB_PROP_MODE_REPLACE, window, atom(property), type, 8, value.length(), value.constData());
+}
+
+void XWindowInfoReaderTest::setMappingState(xcb_window_t window, quint32 state)
+{
+    //! WM_STATE holds the state and the icon window
+    setCardinals(window, "WM_STATE", atom("WM_STATE"), {state, XCB_WINDOW_NONE});
+}
+
+void XWindowInfoReaderTest::compare(const XWindowInfoReader::Info &single, const XWindowInfoReader::Info &batched)
+{
+    QCOMPARE(batched.wid, single.wid);
+    QCOMPARE(batched.exists, single.exists);
+    QCOMPARE(batched.windowClass, single.windowClass);
+    QCOMPARE(batched.geometry, single.geometry);
+    QCOMPARE(batched.hasSkipTaskbar, single.hasSkipTaskbar);
+    QCOMPARE(batched.hasSkipPager, single.hasSkipPager);
+
+    const WindowInfoWrap &s = single.winfo;
+    const WindowInfoWrap &b = batched.winfo;
+
+    QCOMPARE(b.isValid(), s.isValid());
+
+    if (!s.isValid()) {
+        return;
+    }
+
+    QCOMPARE(b.wid(), s.wid());
+    QCOMPARE(b.parentId(), s.parentId());
+    QCOMPARE(b.geometry(), s.geometry());
+    QCOMPARE(b.display(), s.display());
+    QCOMPARE(b.desktops(), s.desktops());
+    QCOMPARE(b.activities(), s.activities());
+    QCOMPARE(b.isActive(), s.isActive());
+    QCOMPARE(b.isMinimized(), s.isMinimized());
+    QCOMPARE(b.isMaxVert(), s.isMaxVert());
+    QCOMPARE(b.isMaxHoriz(), s.isMaxHoriz());
+    QCOMPARE(b.isFullscreen(), s.isFullscreen());
+    QCOMPARE(b.isShaded(), s.isShaded());
+    QCOMPARE(b.isKeepAbove(), s.isKeepAbove());
+    QCOMPARE(b.isKeepBelow(), s.isKeepBelow());
+    QCOMPARE(b.hasSkipPager(), s.hasSkipPager());
+    QCOMPARE(b.hasSkipSwitcher(), s.hasSkipSwitcher());
+    QCOMPARE(b.hasSkipTaskbar(), s.hasSkipTaskbar());
+    QCOMPARE(b.isOnAllDesktops(), s.isOnAllDesktops());
+    QCOMPARE(b.isOnAllActivities(), s.isOnAllActivities());
+    QCOMPARE(b.isCloseable(), s.isCloseable());
+    QCOMPARE(b.isFullScreenable(), s.isFullScreenable());
+    QCOMPARE(b.isMaximizable(), s.isMaximizable());
+    QCOMPARE(b.isMinimizable(), s.isMinimizable());
+    QCOMPARE(b.isMovable(), s.isMovable());
+    QCOMPARE(b.isResizable(), s.isResizable());
+    QCOMPARE(b.isShadeable(), s.isShadeable());
+    QCOMPARE(b.isVirtualDesktopsChangeable(), s.isVirtualDesktopsChangeable());
+}
+
+void XWindowInfoReaderTest::sameAsSingleRequest()
+{
+    const quint32 utf8String = atom("UTF8_STRING");
+
+    //! normal window with only a NET name
+    const xcb_window_t plain = createWindow(QRect(10, 20, 300, 200));
+    setMappingState(plain, WMSTATENORMAL);
+    setBytes(plain, "_NET_WM_NAME", utf8String, QStringLiteral("Plain é").toUtf8());
+
+    //! window with states, desktop, frame extents, activities and actions
+    const xcb_window_t full = createWindow(QRect(50, 60, 640, 480));
+    setMappingState(full, WMSTATENORMAL);
+    setBytes(full, "WM_CLASS", XCB_ATOM_STRING, QByteArray("konsole\0konsole\0", 16));
+    setBytes(full, "_NET_WM_NAME", utf8String, QByteArrayLiteral("Name"));
+    setBytes(full, "_NET_WM_VISIBLE_NAME", utf8String, QByteArrayLiteral("Visible Name"));
+    setAtoms(full, "_NET_WM_STATE", {"_NET_WM_STATE_MAXIMIZED_VERT", "_NET_WM_STATE_MAXIMIZED_HORZ", "_NET_WM_STATE_ABOVE",
+                                     "_NET_WM_STATE_SKIP_TASKBAR", "_NET_WM_STATE_SKIP_PAGER", "_KDE_NET_WM_STATE_SKIP_SWITCHER"});
+    setCardinals(full, "_NET_WM_DESKTOP", XCB_ATOM_CARDINAL, {1});
+    setCardinals(full, "_NET_FRAME_EXTENTS", XCB_ATOM_CARDINAL, {2, 3, 24, 4});
+    setCardinals(full, "_GTK_FRAME_EXTENTS", XCB_ATOM_CARDINAL, {1, 1, 1, 1});
+    setBytes(full, "_KDE_NET_WM_ACTIVITIES", XCB_ATOM_STRING, QByteArrayLiteral("first-activity,second-activity"));
+    setAtoms(full, "_NET_WM_ALLOWED_ACTIONS", {"_NET_WM_ACTION_CLOSE", "_NET_WM_ACTION_MOVE", "_NET_WM_ACTION_MAXIMIZE_HORZ"});
+    setCardinals(full, "WM_TRANSIENT_FOR", XCB_ATOM_WINDOW, {plain});
+
+    //! window on all desktops and activities with legacy states and frame strut
+    const xcb_window_t legacy = createWindow(QRect(0, 0, 100, 100));
+    setMappingState(legacy, WMSTATENORMAL);
+    setAtoms(legacy, "_NET_WM_STATE", {"_NET_WM_STATE_STAYS_ON_TOP", "_NET_WM_STATE_HIDDEN", "_NET_WM_STATE_SHADED"});
+    setCardinals(legacy, "_NET_WM_DESKTOP", XCB_ATOM_CARDINAL, {0xFFFFFFFF});
+    setCardinals(legacy, "_KDE_NET_WM_FRAME_STRUT", XCB_ATOM_CARDINAL, {5, 5, 30, 5});
+    setBytes(legacy, "_KDE_NET_WM_ACTIVITIES", XCB_ATOM_STRING, QByteArrayLiteral("00000000-0000-0000-0000-000000000000"));
+
+    //! window that provides only an ICCCM name and properties of unexpected types
+    const xcb_window_t icccm = createWindow(QRect(5, 5, 80, 60));
+    setMappingState(icccm, WMSTATENORMAL);
+    setBytes(icccm, "WM_NAME", XCB_ATOM_STRING, QByteArray("Caf\xe9"));
+    setBytes(icccm, "_NET_WM_NAME", XCB_ATOM_STRING, QByteArrayLiteral("not utf8 typed"));
+    setCardinals(icccm, "_NET_WM_DESKTOP", XCB_ATOM_INTEGER, {3});
+
+    //! withdrawn window, it does not exist for KWindowInfo but its class and states are still read
+    const xcb_window_t withdrawn = createWindow(QRect(0, 0, 1920, 1080));
+    setMappingState(withdrawn, WMSTATEWITHDRAWN);
+    setBytes(withdrawn, "WM_CLASS", XCB_ATOM_STRING, QByteArray("plasmashell\0plasmashell\0", 24));
+    setAtoms(withdrawn, "_NET_WM_STATE", {"_NET_WM_STATE_SKIP_TASKBAR", "_NET_WM_STATE_SKIP_PAGER"});
+
+    //! window without WM_STATE
+    const xcb_window_t unmanaged = createWindow(QRect(0, 0, 10, 10));
+
+    //! window that was closed in the meantime
+    const xcb_window_t destroyed = createWindow(QRect(0, 0, 10, 10));
+    xcb_destroy_window(QX11Info::connection(), destroyed);
+    m_windows.removeAll(destroyed);
+
+    xcb_flush(QX11Info::connection());
+
+    const QList<WindowId> wids{WindowId::fromValue<WId>(plain),
+                               WindowId::fromValue<WId>(full),
+                               WindowId::fromValue<WId>(legacy),
+                               WindowId::fromValue<WId>(icccm),
+                               WindowId::fromValue<WId>(withdrawn),
+                               WindowId::fromValue<WId>(unmanaged),
+                               WindowId::fromValue<WId>(destroyed)};
+
+    XWindowInfoReader reader;
+    const QList<XWindowInfoReader::Info> batched = reader.readInfos(wids);
+
+    QCOMPARE(batched.count(), wids.count());
+
+    for (int i = 0; i < wids.count(); ++i) {
+        compare(reader.readInfo(wids[i]), batched[i]);
+    }
+
+    //! make sure that the windows were created as intended
+    QVERIFY(batched[1].exists);
+    QVERIFY(batched[1].winfo.isValid());
+    QVERIFY(!batched[4].exists);
+    QCOMPARE(batched[4].windowClass, QStringLiteral("plasmashell"));
+    QVERIFY(!batched[5].exists);
+    QVERIFY(!batched[6].exists);
+}
+
+int main(int argc, char *argv[])
+{
+    //! the test is skipped when there is no X11 display
+    if (qEnvironmentVariableIsEmpty("DISPLAY") && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    XWindowInfoReaderTest test;
+
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "xwindowinforeadertest.moc"
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// local
+#include "layouts/idallocator.h"
+
+// Qt
+#include <QtTest>
+
+#define MAXID 32000
+#define SYNTHESIZEDCONTAINMENTS 40
+#define SYNTHESIZEDAPPLETS 2000
+
+using Latte::Layouts::IdAllocator;
+
+//! compares the layouts id allocator with the availableId scan that was used
+//! before, while a synthetic layout with 2000 applets is imported in a corona
+//! that already has the given ids
+class IdAllocatorBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void idAllocator_data();
+    void idAllocator();
+    void availableIdScan_data();
+    void availableIdScan();
+
+private:
+    void addOccupiedIdsRows();
+    QStringList occupiedIds(int count) const;
+
+private:
+    qint64 m_checksum{0};
+};
+
+namespace {
+
+QString availableId(const QStringList &all, const QStringList &assigned, int base)
+{
+    int i = base;
+
+    while (i < MAXID) {
+        QString iStr = QString::number(i);
+
+        if (!all.contains(iStr) && !assigned.contains(iStr)) {
+            return iStr;
+        }
+
+        i++;
+    }
+
+    return QString("");
+}
+
+}
+
+void IdAllocatorBenchmark::addOccupiedIdsRows()
+{
+    QTest::addColumn<int>("occupiedCount");
+
+    QTest::newRow("empty corona") << 0;
+    QTest::newRow("500 corona ids") << 500;
+    QTest::newRow("2000 corona ids") << 2000;
+}
+
+QStringList IdAllocatorBenchmark::occupiedIds(int count) const
+{
+    //! the ids of the already loaded layouts are mostly sequential with a few gaps
+    QStringList ids;
+    qsrand(count);
+
+    for (int i = 1; ids.count() < count; ++i) {
+        if (qrand() % 8 != 0) {
+            ids << QString::number(i);
+        }
+    }
+
+    return ids;
+}
+
+void IdAllocatorBenchmark::idAllocator_data()
+{
+    addOccupiedIdsRows();
+}
+
+void IdAllocatorBenchmark::idAllocator()
+{
+    QFETCH(int, occupiedCount);
+    const QStringList occupied = occupiedIds(occupiedCount);
+
+    QBENCHMARK {
+        IdAllocator allocator(occupied);
+
+        for (int i = 0; i < SYNTHESIZEDCONTAINMENTS; ++i) {
+            m_checksum += allocator.takeAvailableId(12).length();
+        }
+
+        for (int i = 0; i < SYNTHESIZEDAPPLETS; ++i) {
+            m_checksum += allocator.takeAvailableId(40).length();
+        }
+    }
+}
+
+void IdAllocatorBenchmark::availableIdScan_data()
+{
+    addOccupiedIdsRows();
+}
+
+void IdAllocatorBenchmark::availableIdScan()
+{
+    QFETCH(int, occupiedCount);
+    const QStringList occupied = occupiedIds(occupiedCount);
+
+    QBENCHMARK {
+        QStringList assigned;
+
+        for (int i = 0; i < SYNTHESIZEDCONTAINMENTS; ++i) {
+            assigned << availableId(occupied, assigned, 12);
+        }
+
+        for (int i = 0; i < SYNTHESIZEDAPPLETS; ++i) {
+            assigned << availableId(occupied, assigned, 40);
+        }
+
+        m_checksum += assigned.count();
+    }
+}
+
+QTEST_GUILESS_MAIN(IdAllocatorBenchmark)
+
+#include "idallocatorbenchmark.moc"
@@ -0,0 +1,335 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// local
+#include "layouts/idsremapper.h"
+
+// Qt
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+
+// KDE
+#include <KConfig>
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+// C++
+#include <algorithm>
+
+#define DEFAULTITERATIONS 50
+#define DEFAULTOCCUPIEDIDS 200
+#define SYNTHESIZEDVIEWS 4
+#define SYNTHESIZEDAPPLETS 30
+#define SYNTHESIZEDSYSTRAYAPPLETS 12
+
+using Latte::Layouts::IdsRemapper;
+
+namespace {
+
+struct Measurements {
+    QString name;
+    QVector<qint64> nsecs;
+    QHash<QString, qint64> io;
+    int containments{0};
+};
+
+//! rchar, wchar, syscr, syscw, read_bytes and write_bytes of the process,
+//! it is empty when the kernel does not provide task io accounting
+QHash<QString, qint64> processIo()
+{
+    QHash<QString, qint64> io;
+    QFile file(QStringLiteral("/proc/self/io"));
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return io;
+    }
+
+    for (const auto &line : QString::fromLatin1(file.readAll()).split('\n', QString::SkipEmptyParts)) {
+        QStringList fields = line.split(':');
+
+        if (fields.count() == 2) {
+            io[fields[0].trimmed()] = fields[1].trimmed().toLongLong();
+        }
+    }
+
+    return io;
+}
+
+//! a layout with a few latte views, each one with its applets and a systray
+//! whose subcontainment carries its own applets
+void synthesizeLayout(const QString &file)
+{
+    KConfig layout(file, KConfig::SimpleConfig);
+    KConfigGroup containments(&layout, "Containments");
+
+    int nextId{1};
+
+    for (int v = 0; v < SYNTHESIZEDVIEWS; ++v) {
+        KConfigGroup containment = containments.group(QString::number(nextId++));
+        containment.writeEntry("plugin", "org.kde.latte.containment");
+        containment.writeEntry("formfactor", 2);
+        containment.writeEntry("location", 4);
+        containment.writeEntry("lastScreen", 0);
+        containment.writeEntry("activityId", "");
+        containment.group("Configuration").writeEntry("PreloadWeight", 42);
+
+        QStringList order;
+
+        for (int a = 0; a < SYNTHESIZEDAPPLETS; ++a) {
+            QString appletId = QString::number(nextId++);
+            order << appletId;
+
+            KConfigGroup applet = containment.group("Applets").group(appletId);
+            applet.writeEntry("immutability", 1);
+            applet.writeEntry("plugin", a == 0 ? "org.kde.latte.plasmoid" : "org.kde.plasma.analogclock");
+            applet.group("Configuration").writeEntry("PreloadWeight", 42);
+            applet.group("Configuration").group("General").writeEntry("launchers59", QStringList{"applications:org.kde.dolphin.desktop",
+                                                                                                "applications:org.kde.konsole.desktop",
+                                                                                                "applications:firefox.desktop"});
+        }
+
+        //! systray and its subcontainment
+        QString systrayId = QString::number(nextId++);
+        QString subContainmentId = QString::number(nextId++);
+        order << systrayId;
+
+        KConfigGroup systray = containment.group("Applets").group(systrayId);
+        systray.writeEntry("plugin", "org.kde.plasma.systemtray");
+        systray.group("Configuration").writeEntry("SystrayContainmentId", subContainmentId);
+
+        KConfigGroup subContainment = containments.group(subContainmentId);
+        subContainment.writeEntry("plugin", "org.kde.plasma.private.systemtray");
+        subContainment.writeEntry("formfactor", 2);
+        subContainment.writeEntry("location", 4);
+
+        for (int a = 0; a < SYNTHESIZEDSYSTRAYAPPLETS; ++a) {
+            KConfigGroup applet = subContainment.group("Applets").group(QString::number(nextId++));
+            applet.writeEntry("immutability", 1);
+            applet.writeEntry("plugin", "org.kde.plasma.networkmanagement");
+        }
+
+        containment.group("General").writeEntry("appletOrder", order.join(";"));
+        containment.group("General").writeEntry("lockedZoomApplets", order.first());
+    }
+
+    layout.sync();
+}
+
+//! the file based import that was used before, the layout is copied, its containments
+//! are copied to a second file and the updated ids are written to a third one which
+//! is then handed to the corona
+int importThroughFiles(const IdsRemapper &remapper, const QStringList &occupiedIds, const QString &layoutFile, const QString &tmpDir)
+{
+    QString temp1FilePath = tmpDir + "/Benchmark.multiple.views";
+    QString tempLayoutFilePath = tmpDir + "/Benchmark.multiple.tmplayout";
+    QString temp2FilePath = tmpDir + "/Benchmark.views.newids";
+
+    QFile tempLayoutFile(tempLayoutFilePath);
+    QFile copyFile(temp1FilePath);
+    QFile layoutOriginalFile(layoutFile);
+
+    if (tempLayoutFile.exists()) {
+        tempLayoutFile.remove();
+    }
+
+    if (copyFile.exists()) {
+        copyFile.remove();
+    }
+
+    layoutOriginalFile.copy(tempLayoutFilePath);
+
+    {
+        KSharedConfigPtr filePtr = KSharedConfig::openConfig(tempLayoutFilePath);
+        KSharedConfigPtr newFile = KSharedConfig::openConfig(temp1FilePath);
+        KConfigGroup copyGroup = KConfigGroup(newFile, "Containments");
+        KConfigGroup current_containments = KConfigGroup(filePtr, "Containments");
+
+        current_containments.copyTo(&copyGroup);
+
+        copyGroup.sync();
+    }
+
+    QFile copyFile2(temp2FilePath);
+
+    if (copyFile2.exists()) {
+        copyFile2.remove();
+    }
+
+    {
+        KSharedConfigPtr filePtr = KSharedConfig::openConfig(temp1FilePath);
+        KSharedConfigPtr file2Ptr = KSharedConfig::openConfig(temp2FilePath);
+        KConfigGroup fixedNewContainmets = KConfigGroup(file2Ptr, "Containments");
+
+        remapper.remap(occupiedIds, QStringLiteral("Benchmark"), KConfigGroup(filePtr, "Containments"), fixedNewContainmets);
+
+        fixedNewContainmets.sync();
+    }
+
+    KSharedConfigPtr importedPtr = KSharedConfig::openConfig(temp2FilePath);
+    return KConfigGroup(importedPtr, "").group("Containments").groupList().count();
+}
+
+//! the current import, the layout file is read once and the updated ids
+//! are prepared only in memory
+int importInMemory(const IdsRemapper &remapper, const QStringList &occupiedIds, const QString &layoutFile)
+{
+    KConfig layout(layoutFile, KConfig::SimpleConfig);
+
+    KConfig importedConfig(QString(), KConfig::SimpleConfig);
+    KConfigGroup importedContainments(&importedConfig, "Containments");
+
+    remapper.remap(occupiedIds, QStringLiteral("Benchmark"), KConfigGroup(&layout, "Containments"), importedContainments);
+
+    return KConfigGroup(&importedConfig, "").group("Containments").groupList().count();
+}
+
+template<typename Import>
+void measure(Measurements &measurements, int iterations, Import import)
+{
+    QHash<QString, qint64> ioBefore = processIo();
+
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        measurements.containments = import();
+        measurements.nsecs << timer.nsecsElapsed();
+    }
+
+    QHash<QString, qint64> ioAfter = processIo();
+
+    for (const auto &key : ioAfter.keys()) {
+        measurements.io[key] = ioAfter[key] - ioBefore.value(key);
+    }
+}
+
+void report(QTextStream &out, const Measurements &measurements)
+{
+    QVector<qint64> sorted = measurements.nsecs;
+    std::sort(sorted.begin(), sorted.end());
+
+    qint64 total{0};
+
+    for (const auto nsecs : sorted) {
+        total += nsecs;
+    }
+
+    const double msecs = 1000000.0;
+    const int count = qMax(1, sorted.count());
+
+    out << measurements.name.leftJustified(10)
+        << " containments=" << measurements.containments
+        << " min_ms=" << QString::number(sorted.isEmpty() ? 0 : sorted.first() / msecs, 'f', 3)
+        << " avg_ms=" << QString::number(total / msecs / count, 'f', 3)
+        << " max_ms=" << QString::number(sorted.isEmpty() ? 0 : sorted.last() / msecs, 'f', 3);
+
+    if (measurements.io.isEmpty()) {
+        out << " io=unavailable";
+    } else {
+        //! per import
+        for (const auto &key : {"rchar", "wchar", "syscr", "syscw", "read_bytes", "write_bytes"}) {
+            out << " " << key << "=" << measurements.io.value(key) / count;
+        }
+    }
+
+    out << endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("layoutsimportbenchmark"));
+
+    //! the remapping debug output would be measured together with the import
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Compares the file based and the in memory layout import and measures their time and I/O"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("layout"), QStringLiteral("Layout file to import, a synthesized layout is used when it is missing"));
+    parser.addOptions({
+                          {{"i", "iterations"}, QStringLiteral("Number of imports for each path."), QStringLiteral("iterations"), QString::number(DEFAULTITERATIONS)},
+                          {"occupied", QStringLiteral("Number of ids that are already used from other layouts in the corona."), QStringLiteral("occupied"), QString::number(DEFAULTOCCUPIEDIDS)}
+                      });
+    parser.process(app);
+
+    const int iterations = qMax(1, parser.value(QStringLiteral("iterations")).toInt());
+    const int occupied = qMax(0, parser.value(QStringLiteral("occupied")).toInt());
+
+    QTemporaryDir tmpDir;
+
+    if (!tmpDir.isValid()) {
+        qWarning() << "temporary directory could not be created";
+        return 1;
+    }
+
+    QString layoutFile;
+
+    if (parser.positionalArguments().isEmpty()) {
+        layoutFile = tmpDir.path() + "/Benchmark.layout.latte";
+        synthesizeLayout(layoutFile);
+    } else {
+        layoutFile = parser.positionalArguments().first();
+    }
+
+    if (!QFile::exists(layoutFile)) {
+        qWarning() << "layout file does not exist :: " << layoutFile;
+        return 1;
+    }
+
+    QStringList occupiedIds;
+
+    for (int i = 1; i <= occupied; ++i) {
+        occupiedIds << QString::number(i);
+    }
+
+    IdsRemapper remapper;
+
+    Measurements files;
+    files.name = QStringLiteral("files");
+    measure(files, iterations, [&]() {
+        return importThroughFiles(remapper, occupiedIds, layoutFile, tmpDir.path());
+    });
+
+    Measurements memory;
+    memory.name = QStringLiteral("memory");
+    measure(memory, iterations, [&]() {
+        return importInMemory(remapper, occupiedIds, layoutFile);
+    });
+
+    QTextStream out(stdout);
+    out << "layout=" << (parser.positionalArguments().isEmpty() ? QStringLiteral("synthesized") : layoutFile)
+        << " size_bytes=" << QFile(layoutFile).size()
+        << " iterations=" << iterations
+        << " occupied_ids=" << occupied << endl;
+
+    report(out, files);
+    report(out, memory);
+
+    return 0;
+}
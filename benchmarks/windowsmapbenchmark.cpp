@@ -0,0 +1,232 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "wm/windowinfowrap.h"
+#include "wm/tracker/windowsmap.h"
+
+// Qt
+#include <QMap>
+#include <QtTest>
+
+using Latte::WindowSystem::WindowId;
+using Latte::WindowSystem::WindowInfoWrap;
+using Latte::WindowSystem::Tracker::WindowsMap;
+
+//! compares the tracker windows map with the QMap that was used before
+//! for typical windows counts, run with -tickcounter or -callgrind
+//! for more stable results than the default walltime
+class WindowsMapBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertWindowsMap_data();
+    void insertWindowsMap();
+    void insertQMap_data();
+    void insertQMap();
+
+    void lookupWindowsMap_data();
+    void lookupWindowsMap();
+    void lookupQMap_data();
+    void lookupQMap();
+
+    void iterateWindowsMap_data();
+    void iterateWindowsMap();
+    void iterateQMap_data();
+    void iterateQMap();
+
+private:
+    void addWindowsCountRows();
+    QList<WindowId> windowIds(int count) const;
+    WindowInfoWrap windowInfo(const WindowId &wid) const;
+
+    template <typename Map>
+    void insertWindows(Map &windows, const QList<WindowId> &wids) const;
+
+private:
+    qint64 m_checksum{0};
+};
+
+void WindowsMapBenchmark::addWindowsCountRows()
+{
+    QTest::addColumn<int>("windowsCount");
+
+    QTest::newRow("50 windows") << 50;
+    QTest::newRow("500 windows") << 500;
+    QTest::newRow("5000 windows") << 5000;
+}
+
+QList<WindowId> WindowsMapBenchmark::windowIds(int count) const
+{
+    //! X11 window ids are allocated per client in sequential ranges
+    QList<WindowId> wids;
+    qsrand(count);
+
+    for (int i = 0; i < count; ++i) {
+        const WId client = 0x1000000 + (qrand() % 64) * 0x200000;
+        wids << QVariant::fromValue<WId>(client + i);
+    }
+
+    return wids;
+}
+
+WindowInfoWrap WindowsMapBenchmark::windowInfo(const WindowId &wid) const
+{
+    WindowInfoWrap winfo;
+    winfo.setWid(wid);
+    winfo.setIsValid(true);
+    winfo.setGeometry(QRect(int(wid.toLongLong() % 1920), 0, 800, 600));
+    winfo.setAppName(QStringLiteral("application"));
+    winfo.setDesktops({QStringLiteral("1")});
+    winfo.setActivities({QStringLiteral("activity")});
+
+    return winfo;
+}
+
+template <typename Map>
+void WindowsMapBenchmark::insertWindows(Map &windows, const QList<WindowId> &wids) const
+{
+    for (const auto &wid : wids) {
+        windows[wid] = windowInfo(wid);
+    }
+}
+
+void WindowsMapBenchmark::insertWindowsMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::insertWindowsMap()
+{
+    QFETCH(int, windowsCount);
+    const QList<WindowId> wids = windowIds(windowsCount);
+
+    QBENCHMARK {
+        WindowsMap windows;
+        insertWindows(windows, wids);
+        m_checksum += windows.count();
+    }
+}
+
+void WindowsMapBenchmark::insertQMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::insertQMap()
+{
+    QFETCH(int, windowsCount);
+    const QList<WindowId> wids = windowIds(windowsCount);
+
+    QBENCHMARK {
+        QMap<WindowId, WindowInfoWrap> windows;
+        insertWindows(windows, wids);
+        m_checksum += windows.count();
+    }
+}
+
+void WindowsMapBenchmark::lookupWindowsMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::lookupWindowsMap()
+{
+    QFETCH(int, windowsCount);
+    const QList<WindowId> wids = windowIds(windowsCount);
+
+    WindowsMap map;
+    insertWindows(map, wids);
+    const WindowsMap &windows = map;
+
+    QBENCHMARK {
+        for (const auto &wid : wids) {
+            if (windows.contains(wid)) {
+                m_checksum += windows[wid].geometry().x();
+            }
+        }
+    }
+}
+
+void WindowsMapBenchmark::lookupQMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::lookupQMap()
+{
+    QFETCH(int, windowsCount);
+    const QList<WindowId> wids = windowIds(windowsCount);
+
+    QMap<WindowId, WindowInfoWrap> map;
+    insertWindows(map, wids);
+    const QMap<WindowId, WindowInfoWrap> &windows = map;
+
+    QBENCHMARK {
+        for (const auto &wid : wids) {
+            if (windows.contains(wid)) {
+                m_checksum += windows[wid].geometry().x();
+            }
+        }
+    }
+}
+
+void WindowsMapBenchmark::iterateWindowsMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::iterateWindowsMap()
+{
+    QFETCH(int, windowsCount);
+
+    WindowsMap windows;
+    insertWindows(windows, windowIds(windowsCount));
+
+    QBENCHMARK {
+        for (const auto &winfo : windows) {
+            m_checksum += winfo.geometry().width();
+        }
+    }
+}
+
+void WindowsMapBenchmark::iterateQMap_data()
+{
+    addWindowsCountRows();
+}
+
+void WindowsMapBenchmark::iterateQMap()
+{
+    QFETCH(int, windowsCount);
+
+    QMap<WindowId, WindowInfoWrap> windows;
+    insertWindows(windows, windowIds(windowsCount));
+
+    QBENCHMARK {
+        for (const auto &winfo : windows) {
+            m_checksum += winfo.geometry().width();
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(WindowsMapBenchmark)
+
+#include "windowsmapbenchmark.moc"
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "benchmarkviewshost.h"
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+BenchmarkViewsHost::BenchmarkViewsHost(QObject *parent)
+    : ViewsHost(parent)
+{
+}
+
+BenchmarkViewsHost::~BenchmarkViewsHost()
+{
+    qDeleteAll(m_views);
+}
+
+void BenchmarkViewsHost::addScreen(const QRect &geometry, const QRect &availableGeometry)
+{
+    m_screens << geometry;
+    m_availableScreens << availableGeometry;
+
+    emit availableScreenGeometriesChanged();
+}
+
+int BenchmarkViewsHost::screensCount() const
+{
+    return m_screens.count();
+}
+
+Latte::View *BenchmarkViewsHost::addView(int screenId, const QRect &absoluteGeometry, Plasma::Types::Location location)
+{
+    ViewData *view = new ViewData;
+    view->screenId = screenId;
+    view->absoluteGeometry = absoluteGeometry;
+    view->location = location;
+
+    m_views << view;
+
+    return reinterpret_cast<Latte::View *>(view);
+}
+
+QList<Latte::View *> BenchmarkViewsHost::views() const
+{
+    QList<Latte::View *> views;
+
+    for (const auto view : m_views) {
+        views << reinterpret_cast<Latte::View *>(view);
+    }
+
+    return views;
+}
+
+const BenchmarkViewsHost::ViewData *BenchmarkViewsHost::data(Latte::View *view) const
+{
+    return reinterpret_cast<const ViewData *>(view);
+}
+
+bool BenchmarkViewsHost::hasMultipleLayouts() const
+{
+    return false;
+}
+
+QRect BenchmarkViewsHost::availableScreenGeometry(int screenId, const QList<Latte::Types::Visibility> &ignoreModes) const
+{
+    Q_UNUSED(ignoreModes)
+
+    return m_availableScreens.value(screenId);
+}
+
+void BenchmarkViewsHost::trackView(Latte::View *view)
+{
+    Q_UNUSED(view)
+}
+
+void BenchmarkViewsHost::untrackView(Latte::View *view)
+{
+    Q_UNUSED(view)
+}
+
+bool BenchmarkViewsHost::isTouchingBottomViewAndIsBusy(Latte::View *view) const
+{
+    Q_UNUSED(view)
+
+    return false;
+}
+
+bool BenchmarkViewsHost::isTouchingTopViewAndIsBusy(Latte::View *view) const
+{
+    Q_UNUSED(view)
+
+    return false;
+}
+
+int BenchmarkViewsHost::screenId(Latte::View *view) const
+{
+    return data(view)->screenId;
+}
+
+Plasma::Types::FormFactor BenchmarkViewsHost::formFactor(Latte::View *view) const
+{
+    Plasma::Types::Location edge = location(view);
+
+    return (edge == Plasma::Types::TopEdge || edge == Plasma::Types::BottomEdge) ? Plasma::Types::Horizontal : Plasma::Types::Vertical;
+}
+
+Plasma::Types::Location BenchmarkViewsHost::location(Latte::View *view) const
+{
+    return data(view)->location;
+}
+
+QRect BenchmarkViewsHost::absoluteGeometry(Latte::View *view) const
+{
+    return data(view)->absoluteGeometry;
+}
+
+QRect BenchmarkViewsHost::screenGeometry(Latte::View *view) const
+{
+    return m_screens.value(data(view)->screenId);
+}
+
+QStringList BenchmarkViewsHost::activities(Latte::View *view) const
+{
+    Q_UNUSED(view)
+
+    return QStringList();
+}
+
+Latte::Layout::GenericLayout *BenchmarkViewsHost::layout(Latte::View *view) const
+{
+    Q_UNUSED(view)
+
+    return reinterpret_cast<Latte::Layout::GenericLayout *>(const_cast<int *>(&m_layoutKey));
+}
+
+void BenchmarkViewsHost::trackLayout(Latte::Layout::GenericLayout *layout)
+{
+    Q_UNUSED(layout)
+}
+
+void BenchmarkViewsHost::untrackLayout(Latte::Layout::GenericLayout *layout)
+{
+    Q_UNUSED(layout)
+}
+
+QStringList BenchmarkViewsHost::appliedActivities(Latte::Layout::GenericLayout *layout) const
+{
+    Q_UNUSED(layout)
+
+    return QStringList();
+}
+
+}
+}
+}
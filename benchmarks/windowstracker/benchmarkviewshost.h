@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BENCHMARKVIEWSHOST_H
+#define BENCHMARKVIEWSHOST_H
+
+// local
+#include "wm/tracker/viewshost.h"
+
+// Qt
+#include <QList>
+#include <QRect>
+
+namespace Latte {
+namespace WindowSystem {
+namespace Tracker {
+
+//! Benchmark screens with fixed geometries and views that are shown on all activities
+//! and belong to the same layout. Views and layouts are only keys for the windows
+//! tracker, so they are plain benchmark records behind the application types.
+class BenchmarkViewsHost : public ViewsHost
+{
+    Q_OBJECT
+
+public:
+    BenchmarkViewsHost(QObject *parent = nullptr);
+    ~BenchmarkViewsHost() override;
+
+    void addScreen(const QRect &geometry, const QRect &availableGeometry);
+    int screensCount() const;
+
+    Latte::View *addView(int screenId, const QRect &absoluteGeometry, Plasma::Types::Location location);
+    QList<Latte::View *> views() const;
+
+    bool hasMultipleLayouts() const override;
+    QRect availableScreenGeometry(int screenId, const QList<Latte::Types::Visibility> &ignoreModes) const override;
+
+    void trackView(Latte::View *view) override;
+    void untrackView(Latte::View *view) override;
+
+    bool isTouchingBottomViewAndIsBusy(Latte::View *view) const override;
+    bool isTouchingTopViewAndIsBusy(Latte::View *view) const override;
+
+    int screenId(Latte::View *view) const override;
+
+    Plasma::Types::FormFactor formFactor(Latte::View *view) const override;
+    Plasma::Types::Location location(Latte::View *view) const override;
+
+    QRect absoluteGeometry(Latte::View *view) const override;
+    QRect screenGeometry(Latte::View *view) const override;
+
+    QStringList activities(Latte::View *view) const override;
+
+    Latte::Layout::GenericLayout *layout(Latte::View *view) const override;
+
+    void trackLayout(Latte::Layout::GenericLayout *layout) override;
+    void untrackLayout(Latte::Layout::GenericLayout *layout) override;
+
+    QStringList appliedActivities(Latte::Layout::GenericLayout *layout) const override;
+
+private:
+    struct ViewData {
+        int screenId{0};
+        QRect absoluteGeometry;
+        Plasma::Types::Location location{Plasma::Types::BottomEdge};
+    };
+
+    const ViewData *data(Latte::View *view) const;
+
+private:
+    //! its address is used as the single layout key
+    int m_layoutKey{0};
+
+    QList<QRect> m_screens;
+    QList<QRect> m_availableScreens;
+
+    QList<ViewData *> m_views;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "replaywindowinterface.h"
+
+namespace Latte {
+namespace WindowSystem {
+
+ReplayWindowInterface::ReplayWindowInterface(QObject *parent)
+    : AbstractWindowInterface(parent)
+{
+}
+
+ReplayWindowInterface::~ReplayWindowInterface()
+{
+}
+
+void ReplayWindowInterface::setViewExtraFlags(QObject *view, bool isPanelWindow, Latte::Types::Visibility mode)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(isPanelWindow)
+    Q_UNUSED(mode)
+}
+
+void ReplayWindowInterface::setViewStruts(QWindow &view, const QRect &rect, Plasma::Types::Location location)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(rect)
+    Q_UNUSED(location)
+}
+
+void ReplayWindowInterface::setWindowOnActivities(QWindow &view, const QStringList &activities)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(activities)
+}
+
+void ReplayWindowInterface::removeViewStruts(QWindow &view)
+{
+    Q_UNUSED(view)
+}
+
+WindowId ReplayWindowInterface::activeWindow()
+{
+    return m_activeWindow;
+}
+
+WindowInfoWrap ReplayWindowInterface::requestInfo(WindowId wid)
+{
+    if (!m_windows.contains(wid)) {
+        return WindowInfoWrap();
+    }
+
+    //! activeness is decided only from the replayed active window changes
+    WindowInfoWrap winfo = m_windows[wid];
+    winfo.setIsActive(wid == m_activeWindow);
+
+    return winfo;
+}
+
+WindowInfoWrap ReplayWindowInterface::requestInfoActive()
+{
+    return requestInfo(m_activeWindow);
+}
+
+void ReplayWindowInterface::skipTaskBar(const QDialog &dialog)
+{
+    Q_UNUSED(dialog)
+}
+
+void ReplayWindowInterface::slideWindow(QWindow &view, Slide location)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(location)
+}
+
+void ReplayWindowInterface::enableBlurBehind(QWindow &view)
+{
+    Q_UNUSED(view)
+}
+
+void ReplayWindowInterface::setActiveEdge(QWindow *view, bool active)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(active)
+}
+
+void ReplayWindowInterface::requestActivate(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::requestClose(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::requestMoveWindow(WindowId wid, QPoint from)
+{
+    Q_UNUSED(wid)
+    Q_UNUSED(from)
+}
+
+void ReplayWindowInterface::requestToggleIsOnAllDesktops(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::requestToggleKeepAbove(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::requestToggleMinimized(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::requestToggleMaximized(WindowId wid)
+{
+    Q_UNUSED(wid)
+}
+
+void ReplayWindowInterface::setKeepAbove(WindowId wid, bool active)
+{
+    Q_UNUSED(wid)
+    Q_UNUSED(active)
+}
+
+void ReplayWindowInterface::setKeepBelow(WindowId wid, bool active)
+{
+    Q_UNUSED(wid)
+    Q_UNUSED(active)
+}
+
+bool ReplayWindowInterface::windowCanBeDragged(WindowId wid)
+{
+    WindowInfoWrap winfo = requestInfo(wid);
+    return (winfo.isValid() && !winfo.isMinimized() && winfo.isMovable());
+}
+
+bool ReplayWindowInterface::windowCanBeMaximized(WindowId wid)
+{
+    WindowInfoWrap winfo = requestInfo(wid);
+    return (winfo.isValid() && winfo.isMaximizable());
+}
+
+QIcon ReplayWindowInterface::iconFor(WindowId wid)
+{
+    Q_UNUSED(wid)
+    return QIcon();
+}
+
+WindowId ReplayWindowInterface::winIdFor(QString appId, QRect geometry)
+{
+    Q_UNUSED(appId)
+    Q_UNUSED(geometry)
+    return WindowId();
+}
+
+WindowId ReplayWindowInterface::winIdFor(QString appId, QString title)
+{
+    Q_UNUSED(appId)
+    Q_UNUSED(title)
+    return WindowId();
+}
+
+AppData ReplayWindowInterface::appDataFor(WindowId wid)
+{
+    //! recordings contain only the application names, the icons
+    //! are not needed in order to measure the tracking code paths
+    AppData data;
+
+    if (m_windows.contains(wid)) {
+        data.id = m_windows[wid].appName();
+        data.name = m_windows[wid].appName();
+    }
+
+    return data;
+}
+
+void ReplayWindowInterface::switchToNextVirtualDesktop()
+{
+}
+
+void ReplayWindowInterface::switchToPreviousVirtualDesktop()
+{
+}
+
+void ReplayWindowInterface::setFrameExtents(QWindow *view, const QMargins &margins)
+{
+    Q_UNUSED(view)
+    Q_UNUSED(margins)
+}
+
+void ReplayWindowInterface::setInputMask(QWindow *window, const QRect &rect)
+{
+    Q_UNUSED(window)
+    Q_UNUSED(rect)
+}
+
+void ReplayWindowInterface::setCurrentDesktop(const QString &desktop)
+{
+    if (m_currentDesktop == desktop) {
+        return;
+    }
+
+    m_currentDesktop = desktop;
+    emit currentDesktopChanged();
+}
+
+void ReplayWindowInterface::setCurrentActivity(const QString &activity)
+{
+    if (m_currentActivity == activity) {
+        return;
+    }
+
+    m_currentActivity = activity;
+    emit currentActivityChanged();
+}
+
+void ReplayWindowInterface::addWindow(const WindowInfoWrap &winfo)
+{
+    m_windows[winfo.wid()] = winfo;
+    emit windowAdded(winfo.wid());
+}
+
+void ReplayWindowInterface::changeWindow(const WindowInfoWrap &winfo)
+{
+    m_windows[winfo.wid()] = winfo;
+
+    if (!m_changedWindows.contains(winfo.wid())) {
+        m_changedWindows << winfo.wid();
+    }
+}
+
+void ReplayWindowInterface::removeWindow(const WindowId &wid)
+{
+    m_windows.remove(wid);
+    m_changedWindows.removeAll(wid);
+
+    if (m_activeWindow == wid) {
+        m_activeWindow = WindowId();
+    }
+
+    emit windowRemoved(wid);
+}
+
+void ReplayWindowInterface::activateWindow(const WindowInfoWrap &winfo)
+{
+    if (winfo.isValid()) {
+        m_windows[winfo.wid()] = winfo;
+    }
+
+    m_activeWindow = winfo.wid();
+    emit activeWindowChanged(winfo.wid());
+}
+
+void ReplayWindowInterface::flushChangedWindows()
+{
+    if (m_changedWindows.isEmpty()) {
+        return;
+    }
+
+    QList<WindowId> wids;
+    wids.swap(m_changedWindows);
+
+    emit windowsChanged(wids);
+}
+
+int ReplayWindowInterface::changedWindowsCount() const
+{
+    return m_changedWindows.count();
+}
+
+}
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REPLAYWINDOWINTERFACE_H
+#define REPLAYWINDOWINTERFACE_H
+
+// local
+#include "wm/abstractwindowinterface.h"
+#include "wm/windowinfowrap.h"
+
+// Qt
+#include <QList>
+#include <QMap>
+
+namespace Latte {
+namespace WindowSystem {
+
+//! Window system that does not talk to any real window manager. Its windows
+//! state is fed from recorded or synthesized windows events and it answers
+//! the windows tracker requests only from that state.
+class ReplayWindowInterface : public AbstractWindowInterface
+{
+    Q_OBJECT
+
+public:
+    explicit ReplayWindowInterface(QObject *parent = nullptr);
+    ~ReplayWindowInterface() override;
+
+    void setViewExtraFlags(QObject *view, bool isPanelWindow = true, Latte::Types::Visibility mode = Latte::Types::WindowsGoBelow) override;
+    void setViewStruts(QWindow &view, const QRect &rect, Plasma::Types::Location location) override;
+    void setWindowOnActivities(QWindow &view, const QStringList &activities) override;
+
+    void removeViewStruts(QWindow &view) override;
+
+    WindowId activeWindow() override;
+    WindowInfoWrap requestInfo(WindowId wid) override;
+    WindowInfoWrap requestInfoActive() override;
+
+    void skipTaskBar(const QDialog &dialog) override;
+    void slideWindow(QWindow &view, Slide location) override;
+    void enableBlurBehind(QWindow &view) override;
+    void setActiveEdge(QWindow *view, bool active) override;
+
+    void requestActivate(WindowId wid) override;
+    void requestClose(WindowId wid) override;
+    void requestMoveWindow(WindowId wid, QPoint from) override;
+    void requestToggleIsOnAllDesktops(WindowId wid) override;
+    void requestToggleKeepAbove(WindowId wid) override;
+    void requestToggleMinimized(WindowId wid) override;
+    void requestToggleMaximized(WindowId wid) override;
+    void setKeepAbove(WindowId wid, bool active) override;
+    void setKeepBelow(WindowId wid, bool active) override;
+
+    bool windowCanBeDragged(WindowId wid) override;
+    bool windowCanBeMaximized(WindowId wid) override;
+
+    QIcon iconFor(WindowId wid) override;
+    WindowId winIdFor(QString appId, QRect geometry) override;
+    WindowId winIdFor(QString appId, QString title) override;
+    AppData appDataFor(WindowId wid) override;
+
+    void switchToNextVirtualDesktop() override;
+    void switchToPreviousVirtualDesktop() override;
+
+    void setFrameExtents(QWindow *view, const QMargins &margins) override;
+    void setInputMask(QWindow *window, const QRect &rect) override;
+
+    void setCurrentDesktop(const QString &desktop);
+    void setCurrentActivity(const QString &activity);
+
+    //! replayed events, the windows state is updated first and afterwards
+    //! the window system signals are sent
+    void addWindow(const WindowInfoWrap &winfo);
+    void changeWindow(const WindowInfoWrap &winfo);
+    void removeWindow(const WindowId &wid);
+    void activateWindow(const WindowInfoWrap &winfo);
+    //! sends the windows that were changed since the previous call
+    void flushChangedWindows();
+
+    int changedWindowsCount() const;
+
+private:
+    WindowId m_activeWindow;
+
+    QList<WindowId> m_changedWindows;
+    QMap<WindowId, WindowInfoWrap> m_windows;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// local
+#include "benchmarkviewshost.h"
+#include "replaywindowinterface.h"
+#include "wm/eventsrecorder.h"
+#include "wm/perfcounters.h"
+#include "wm/tracker/windowstracker.h"
+
+// Qt
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QHash>
+#include <QMap>
+#include <QTextStream>
+#include <QtMath>
+#include <QVector>
+
+// C++
+#include <algorithm>
+
+#define RECORDINGMAGIC 0x4C545745
+#define RECORDINGVERSION 1
+#define DEFAULTITERATIONS 5
+#define DEFAULTLATENCY 150
+#define SYNTHESIZEDWINDOWS 120
+#define SYNTHESIZEDEVENTS 20000
+
+using Latte::WindowSystem::EventsRecorder;
+using Latte::WindowSystem::ReplayWindowInterface;
+using Latte::WindowSystem::Tracker::BenchmarkViewsHost;
+using Latte::WindowSystem::WindowId;
+using Latte::WindowSystem::WindowInfoWrap;
+
+namespace {
+
+struct Event {
+    EventsRecorder::EventType type{EventsRecorder::WindowChanged};
+    qint64 usecs{0};
+    WindowInfoWrap winfo;
+};
+
+struct Latencies {
+    QString name;
+    QVector<qint64> nsecs;
+};
+
+bool loadRecording(const QString &file, QVector<Event> &events)
+{
+    QFile input(file);
+
+    if (!input.open(QIODevice::ReadOnly)) {
+        qWarning() << "Windows events recording can not be opened at :: " << file;
+        return false;
+    }
+
+    QDataStream stream(&input);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic;
+    quint32 version;
+    qint64 startedAt;
+    quint32 count;
+
+    stream >> magic >> version >> startedAt >> count;
+
+    if (magic != RECORDINGMAGIC || version != RECORDINGVERSION) {
+        qWarning() << "Windows events recording is not supported :: " << file;
+        return false;
+    }
+
+    events.reserve(count);
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint8 type;
+        Event event;
+
+        stream >> type >> event.usecs >> event.winfo;
+
+        if (type > EventsRecorder::ActiveWindowChanged) {
+            qWarning() << "Windows events recording is corrupted :: " << file;
+            return false;
+        }
+
+        event.type = static_cast<EventsRecorder::EventType>(type);
+        events << event;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Windows events recording is truncated :: " << file;
+        return false;
+    }
+
+    return true;
+}
+
+//! deterministic workload of a busy desktop, windows are opened, moved,
+//! resized, maximized, activated and closed on two virtual desktops
+QVector<Event> synthesizeRecording(const QRect &screen)
+{
+    static const QStringList apps{"org.kde.dolphin", "org.kde.konsole", "firefox", "org.kde.kate", "thunderbird", "org.kde.okular"};
+
+    QVector<Event> events;
+    QList<WindowId> windows;
+    QMap<WindowId, WindowInfoWrap> winfos;
+
+    qsrand(2020);
+
+    qint64 usecs = 0;
+    quint64 nextWindow = 0x3a00001;
+
+    while (events.count() < SYNTHESIZEDEVENTS) {
+        usecs += (qrand() % 40) * 1000;
+
+        Event event;
+        event.usecs = usecs;
+
+        int action = qrand() % 100;
+
+        if (windows.count() < SYNTHESIZEDWINDOWS / 4 || (action < 4 && windows.count() < SYNTHESIZEDWINDOWS)) {
+            WindowInfoWrap winfo;
+            winfo.setWid(QVariant::fromValue<WId>(nextWindow));
+            winfo.setIsValid(true);
+            winfo.setIsMovable(true);
+            winfo.setIsResizable(true);
+            winfo.setIsMaximizable(true);
+            winfo.setIsMinimizable(true);
+            winfo.setIsClosable(true);
+            winfo.setAppName(apps[qrand() % apps.count()]);
+            winfo.setDesktops({QString(1 + qrand() % 2)});
+            winfo.setIsOnAllActivities(true);
+            winfo.setGeometry(QRect(qrand() % (screen.width() / 2), qrand() % (screen.height() / 2),
+                                    320 + qrand() % (screen.width() / 2), 240 + qrand() % (screen.height() / 2)));
+
+            nextWindow += 0x200000;
+            windows << winfo.wid();
+            winfos[winfo.wid()] = winfo;
+
+            event.type = EventsRecorder::WindowAdded;
+            event.winfo = winfo;
+        } else if (action < 7) {
+            WindowId wid = windows.takeAt(qrand() % windows.count());
+            winfos.remove(wid);
+
+            event.type = EventsRecorder::WindowRemoved;
+            event.winfo.setWid(wid);
+        } else if (action < 20) {
+            WindowInfoWrap &winfo = winfos[windows[qrand() % windows.count()]];
+            winfo.setIsMinimized(false);
+
+            event.type = EventsRecorder::ActiveWindowChanged;
+            event.winfo = winfo;
+        } else {
+            WindowInfoWrap &winfo = winfos[windows[qrand() % windows.count()]];
+
+            if (action < 30) {
+                bool maximized = !winfo.isMaximized();
+                winfo.setIsMaxVert(maximized);
+                winfo.setIsMaxHoriz(maximized);
+            } else if (action < 35) {
+                winfo.setIsMinimized(!winfo.isMinimized());
+            } else {
+                //! moving or resizing windows create most of the changes
+                winfo.setGeometry(winfo.geometry().translated(qrand() % 21 - 10, qrand() % 21 - 10));
+            }
+
+            event.type = EventsRecorder::WindowChanged;
+            event.winfo = winfo;
+        }
+
+        events << event;
+    }
+
+    return events;
+}
+
+QString mostCommon(const QVector<Event> &events, bool desktops)
+{
+    QHash<QString, int> counts;
+
+    for (const auto &event : events) {
+        for (const auto &value : (desktops ? event.winfo.desktops() : event.winfo.activities())) {
+            counts[value]++;
+        }
+    }
+
+    QString common;
+
+    for (auto i = counts.constBegin(); i != counts.constEnd(); ++i) {
+        if (common.isEmpty() || i.value() > counts[common]) {
+            common = i.key();
+        }
+    }
+
+    return common;
+}
+
+template <typename Function>
+void measure(Latencies &latencies, Function function)
+{
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    latencies.nsecs << timer.nsecsElapsed();
+}
+
+//! windows changes are collected and sent together the same way the window
+//! systems are doing, the batch is sent when latency has passed since its first change
+void replay(ReplayWindowInterface *wm, const QVector<Event> &events, int latency, QVector<Latencies> &latencies)
+{
+    qint64 batchStartedAt{-1};
+
+    for (const auto &event : events) {
+        if (batchStartedAt >= 0 && (event.usecs - batchStartedAt) >= latency * 1000) {
+            measure(latencies[EventsRecorder::WindowChanged], [&]() { wm->flushChangedWindows(); });
+            batchStartedAt = -1;
+        }
+
+        switch (event.type) {
+        case EventsRecorder::WindowAdded:
+            measure(latencies[EventsRecorder::WindowAdded], [&]() { wm->addWindow(event.winfo); });
+            break;
+        case EventsRecorder::WindowChanged:
+            wm->changeWindow(event.winfo);
+
+            if (batchStartedAt < 0) {
+                batchStartedAt = event.usecs;
+            }
+            break;
+        case EventsRecorder::WindowRemoved:
+            measure(latencies[EventsRecorder::WindowRemoved], [&]() { wm->removeWindow(event.winfo.wid()); });
+            break;
+        case EventsRecorder::ActiveWindowChanged:
+            measure(latencies[EventsRecorder::ActiveWindowChanged], [&]() { wm->activateWindow(event.winfo); });
+            break;
+        }
+    }
+
+    if (wm->changedWindowsCount() > 0) {
+        measure(latencies[EventsRecorder::WindowChanged], [&]() { wm->flushChangedWindows(); });
+    }
+}
+
+qint64 percentile(const QVector<qint64> &sorted, double ratio)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+
+    int index = qBound(0, qCeil(ratio * sorted.count()) - 1, sorted.count() - 1);
+    return sorted[index];
+}
+
+void report(QTextStream &out, const Latencies &latencies)
+{
+    QVector<qint64> sorted = latencies.nsecs;
+    std::sort(sorted.begin(), sorted.end());
+
+    qint64 total{0};
+
+    for (const auto nsecs : sorted) {
+        total += nsecs;
+    }
+
+    const double usecs = 1000.0;
+
+    out << latencies.name.leftJustified(22)
+        << " events=" << sorted.count()
+        << " events/sec=" << (total > 0 ? qRound64(sorted.count() * 1e9 / total) : 0)
+        << " min_us=" << QString::number(sorted.isEmpty() ? 0 : sorted.first() / usecs, 'f', 1)
+        << " avg_us=" << QString::number(sorted.isEmpty() ? 0 : total / usecs / sorted.count(), 'f', 1)
+        << " median_us=" << QString::number(percentile(sorted, 0.50) / usecs, 'f', 1)
+        << " p95_us=" << QString::number(percentile(sorted, 0.95) / usecs, 'f', 1)
+        << " p99_us=" << QString::number(percentile(sorted, 0.99) / usecs, 'f', 1)
+        << " max_us=" << QString::number(sorted.isEmpty() ? 0 : sorted.last() / usecs, 'f', 1)
+        << endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    //! no window system is needed, the views and the windows are only replayed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("windowstrackerbenchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays windows events through the windows tracker and measures its latencies"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("recording"), QStringLiteral("Windows events recording, a synthesized workload is used when it is missing"));
+    parser.addOptions({
+                          {{"i", "iterations"}, QStringLiteral("Number of times the events are replayed."), QStringLiteral("iterations"), QString::number(DEFAULTITERATIONS)},
+                          {{"l", "latency"}, QStringLiteral("Maximum time in ms that changed windows are collected before they are sent."), QStringLiteral("latency"), QString::number(DEFAULTLATENCY)},
+                          {"two-screens", QStringLiteral("A second screen is present on the right of the primary one.")},
+                          {"perf-report", QStringLiteral("Print the window system performance counters after the replay.")}
+                      });
+    parser.process(app);
+
+    const int iterations = qMax(1, parser.value(QStringLiteral("iterations")).toInt());
+    const int latency = qMax(0, parser.value(QStringLiteral("latency")).toInt());
+
+    const QRect primaryScreen(0, 0, 1920, 1080);
+    const QRect secondaryScreen(1920, 0, 1920, 1080);
+
+    QVector<Event> events;
+
+    if (parser.positionalArguments().isEmpty()) {
+        events = synthesizeRecording(primaryScreen);
+    } else if (!loadRecording(parser.positionalArguments().first(), events)) {
+        return 1;
+    }
+
+    BenchmarkViewsHost host;
+    host.addScreen(primaryScreen, primaryScreen.adjusted(48, 32, 0, -64));
+
+    if (parser.isSet(QStringLiteral("two-screens"))) {
+        host.addScreen(secondaryScreen, secondaryScreen);
+    }
+
+    //! a bottom dock, a top panel and a left panel on the primary screen
+    host.addView(0, QRect(560, 1016, 800, 64), Plasma::Types::BottomEdge);
+    host.addView(0, QRect(0, 0, 1920, 32), Plasma::Types::TopEdge);
+    host.addView(0, QRect(0, 32, 48, 984), Plasma::Types::LeftEdge);
+
+    const QList<Latte::View *> views = host.views();
+
+    const QString desktop = mostCommon(events, true);
+    const QString activity = mostCommon(events, false);
+
+    QVector<Latencies> latencies(EventsRecorder::ActiveWindowChanged + 1);
+    latencies[EventsRecorder::WindowAdded].name = QStringLiteral("windowAdded");
+    latencies[EventsRecorder::WindowChanged].name = QStringLiteral("windowsChanged");
+    latencies[EventsRecorder::WindowRemoved].name = QStringLiteral("windowRemoved");
+    latencies[EventsRecorder::ActiveWindowChanged].name = QStringLiteral("activeWindowChanged");
+
+    QString perfReport;
+
+    for (int i = 0; i < iterations; ++i) {
+        ReplayWindowInterface *wm = new ReplayWindowInterface();
+        wm->windowsTracker()->setViewsHost(&host);
+        wm->setCurrentDesktop(desktop.isEmpty() ? QString(1) : desktop);
+        wm->setCurrentActivity(activity);
+
+        for (const auto view : views) {
+            wm->windowsTracker()->addView(view);
+            wm->windowsTracker()->setEnabled(view, true);
+        }
+
+        replay(wm, events, latency, latencies);
+
+        perfReport = wm->perfCounters()->report();
+
+        for (const auto view : views) {
+            wm->windowsTracker()->removeView(view);
+        }
+
+        delete wm;
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QTextStream out(stdout);
+    out << "recording=" << (parser.positionalArguments().isEmpty() ? QStringLiteral("synthesized") : parser.positionalArguments().first())
+        << " events=" << events.count()
+        << " iterations=" << iterations
+        << " latency_ms=" << latency
+        << " screens=" << host.screensCount() << endl;
+
+    Latencies all;
+    all.name = QStringLiteral("all");
+
+    for (const auto &eventLatencies : latencies) {
+        report(out, eventLatencies);
+        all.nsecs << eventLatencies.nsecs;
+    }
+
+    report(out, all);
+
+    if (parser.isSet(QStringLiteral("perf-report"))) {
+        out << perfReport;
+    }
+
+    return 0;
+}
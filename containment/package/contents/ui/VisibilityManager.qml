@@ -349,6 +349,20 @@ Item{
         value: plasmoid.configuration.isStickedOnBottomEdge
     }
 
+    Binding{
+        target: latteView && latteView.positioner ? latteView.positioner : null
+        property: "adaptiveThickness"
+        when: latteView && latteView.positioner
+        value: plasmoid.configuration.adaptiveWindowThickness
+    }
+
+    Binding{
+        target: latteView && latteView.positioner ? latteView.positioner : null
+        property: "inThicknessAnimation"
+        when: latteView && latteView.positioner
+        value: animations.hasThicknessAnimation
+    }
+
     //! View::WindowsTracker bindings
     Binding{
         target: latteView && latteView.windowsTracker ? latteView.windowsTracker : null
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "iconcache.h"
+
+// Qt
+#include <QDebug>
+#include <QGuiApplication>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QSGTexture>
+
+// KDE
+#include <KIconThemes/KIconLoader>
+
+//! memory budget of rendered pixmaps in KB
+#define PIXMAPSBUDGET 32768
+#define TEXTURESPURGELIMIT 128
+#define STATISTICSINTERVAL 10000
+
+namespace Latte {
+
+IconCache::IconCache(QObject *parent)
+    : QObject(parent),
+      m_texturesPurgeLimit(TEXTURESPURGELIMIT)
+{
+    m_pixmaps.setMaxCost(PIXMAPSBUDGET);
+
+    //! rendered pixmaps are not valid any more
+    connect(KIconLoader::global(), &KIconLoader::iconLoaderSettingsChanged, this, &IconCache::clear);
+    connect(&m_theme, &Plasma::Theme::themeChanged, this, &IconCache::clear);
+
+    if (qApp->arguments().contains(QStringLiteral("--iconcache"))) {
+        m_statisticsTimer.setInterval(STATISTICSINTERVAL);
+        connect(&m_statisticsTimer, &QTimer::timeout, this, &IconCache::printStatistics);
+        m_statisticsTimer.start();
+    }
+}
+
+IconCache *IconCache::self()
+{
+    static IconCache *cache = new IconCache(qApp);
+    return cache;
+}
+
+QString IconCache::themeName() const
+{
+    return m_theme.themeName();
+}
+
+bool IconCache::findPixmap(const QString &key, QPixmap &pixmap)
+{
+    QPixmap *cached = m_pixmaps.object(key);
+
+    if (!cached) {
+        m_pixmapMisses++;
+        return false;
+    }
+
+    m_pixmapHits++;
+    pixmap = *cached;
+    return true;
+}
+
+void IconCache::insertPixmap(const QString &key, const QPixmap &pixmap)
+{
+    const int cost = qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+    m_pixmaps.insert(key, new QPixmap(pixmap), cost);
+}
+
+QSharedPointer<QSGTexture> IconCache::texture(QQuickWindow *window, const QPixmap &pixmap)
+{
+    const QPair<QQuickWindow *, qint64> key(window, pixmap.cacheKey());
+
+    {
+        QMutexLocker locker(&m_texturesMutex);
+        QSharedPointer<QSGTexture> cached = m_textures.value(key).toStrongRef();
+
+        if (cached) {
+            m_textureHits++;
+            return cached;
+        }
+
+        m_textureMisses++;
+    }
+
+    QSharedPointer<QSGTexture> created(window->createTextureFromImage(pixmap.toImage(), QQuickWindow::TextureCanUseAtlas));
+
+    QMutexLocker locker(&m_texturesMutex);
+
+    //! another item of the same window may have created it in the meantime
+    QSharedPointer<QSGTexture> cached = m_textures.value(key).toStrongRef();
+
+    if (cached) {
+        return cached;
+    }
+
+    if (m_textures.count() >= m_texturesPurgeLimit) {
+        purgeTextures();
+    }
+
+    m_textures[key] = created;
+
+    return created;
+}
+
+void IconCache::purgeTextures()
+{
+    for (auto it = m_textures.begin(); it != m_textures.end();) {
+        if (it.value().isNull()) {
+            it = m_textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_texturesPurgeLimit = qMax(TEXTURESPURGELIMIT, m_textures.count() * 2);
+}
+
+void IconCache::clear()
+{
+    m_pixmaps.clear();
+}
+
+QString IconCache::statistics()
+{
+    const int pixmapLookups = m_pixmapHits + m_pixmapMisses;
+    const int pixmapRate = pixmapLookups > 0 ? (100 * m_pixmapHits / pixmapLookups) : 0;
+
+    QMutexLocker locker(&m_texturesMutex);
+    const int textureLookups = m_textureHits + m_textureMisses;
+    const int textureRate = textureLookups > 0 ? (100 * m_textureHits / textureLookups) : 0;
+
+    return QString("pixmaps: " + QString::number(m_pixmaps.count()) + " (" + QString::number(m_pixmaps.totalCost()) + "KB), "
+                   + "hits: " + QString::number(pixmapRate) + "% of " + QString::number(pixmapLookups) + " || "
+                   + "textures: " + QString::number(m_textures.count()) + ", "
+                   + "hits: " + QString::number(textureRate) + "% of " + QString::number(textureLookups));
+}
+
+void IconCache::printStatistics()
+{
+    qDebug() << "IconCache ::" << statistics();
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ICONCACHE_H
+#define ICONCACHE_H
+
+// Qt
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QPixmap>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QWeakPointer>
+
+// Plasma
+#include <Plasma/Theme>
+
+class QQuickWindow;
+class QSGTexture;
+
+namespace Latte {
+
+//! Process wide cache for the rendered icons of all IconItems. Rendered pixmaps
+//! are kept in a LRU cache with a memory budget and are identified by a key that
+//! describes everything that affects their rendering. Textures are shared between
+//! the items of the same window that paint the same pixmap and they are released
+//! when the last item that paints them is gone.
+class IconCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconCache *self();
+
+    QString themeName() const;
+
+    bool findPixmap(const QString &key, QPixmap &pixmap);
+    void insertPixmap(const QString &key, const QPixmap &pixmap);
+
+    //! it is called from the scene graph render thread
+    QSharedPointer<QSGTexture> texture(QQuickWindow *window, const QPixmap &pixmap);
+
+    QString statistics();
+
+private slots:
+    void clear();
+    void printStatistics();
+
+private:
+    explicit IconCache(QObject *parent = nullptr);
+
+    void purgeTextures();
+
+private:
+    int m_pixmapHits{0};
+    int m_pixmapMisses{0};
+    int m_textureHits{0};
+    int m_textureMisses{0};
+    int m_texturesPurgeLimit;
+
+    QCache<QString, QPixmap> m_pixmaps;
+
+    //! textures are keyed by window and pixmap cacheKey
+    QHash<QPair<QQuickWindow *, qint64>, QWeakPointer<QSGTexture>> m_textures;
+    QMutex m_texturesMutex;
+
+    QTimer m_statisticsTimer;
+
+    Plasma::Theme m_theme;
+};
+
+}
+
+#endif
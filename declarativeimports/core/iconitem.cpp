@@ -24,6 +24,7 @@
 
 // local
 #include "extras.h"
+#include "iconcache.h"
 
 // Qt
 #include <QDebug>
@@ -369,7 +370,7 @@ QSGNode *IconItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *update
             delete oldNode;
 
         textureNode = new ManagedTextureNode;
-        textureNode->setTexture(QSharedPointer<QSGTexture>(window()->createTextureFromImage(m_iconPixmap.toImage(), QQuickWindow::TextureCanUseAtlas)));
+        textureNode->setTexture(IconCache::self()->texture(window(), m_iconPixmap));
         textureNode->setFiltering(smooth() ? QSGTexture::Linear : QSGTexture::Nearest);
 
         m_sizeChanged = true;
@@ -490,7 +491,16 @@ void IconItem::loadPixmap()
         m_iconPixmap = QPixmap();
         update();
         return;
-    } else if (m_svgIcon) {
+    }
+
+    const QString cacheKey = (m_svgIcon || !m_icon.isNull() || !m_imageIcon.isNull()) ? pixmapCacheKey(size) : QString();
+
+    if (!cacheKey.isEmpty() && IconCache::self()->findPixmap(cacheKey, result)) {
+        setIconPixmap(result);
+        return;
+    }
+
+    if (m_svgIcon) {
         m_svgIcon->resize(size, size);
 
         if (m_svgIcon->hasElement(m_svgIconName)) {
@@ -550,7 +560,21 @@ void IconItem::loadPixmap()
         result = KIconLoader::global()->iconEffect()->apply(result, KIconLoader::Desktop, KIconLoader::ActiveState);
     }
 
-    m_iconPixmap = result;
+    if (!cacheKey.isEmpty()) {
+        IconCache::self()->insertPixmap(cacheKey, result);
+    }
+
+    setIconPixmap(result);
+}
+
+void IconItem::setIconPixmap(const QPixmap &pixmap)
+{
+    //! the same pixmap is already painted
+    if (!m_iconPixmap.isNull() && m_iconPixmap.cacheKey() == pixmap.cacheKey()) {
+        return;
+    }
+
+    m_iconPixmap = pixmap;
 
     if (m_providesColors && m_lastLoadedSourceId != m_lastColorsSourceId) {
         m_lastColorsSourceId = m_lastLoadedSourceId;
@@ -562,6 +586,35 @@ void IconItem::loadPixmap()
     update();
 }
 
+QString IconItem::pixmapCacheKey(const qreal size) const
+{
+    //! icons and images that are not identified by a name can not be shared
+    if (m_lastLoadedSourceId.isEmpty()
+            || m_lastLoadedSourceId.startsWith(QLatin1String("_icon_"))
+            || m_lastLoadedSourceId.startsWith(QLatin1String("_image_"))) {
+        return QString();
+    }
+
+    const qreal dpr = window() ? window()->devicePixelRatio() : qApp->devicePixelRatio();
+    const auto *iconTheme = KIconLoader::global()->theme();
+
+    QString state = QStringLiteral("normal");
+
+    if (!isEnabled()) {
+        state = QStringLiteral("disabled");
+    } else if (m_active) {
+        state = QStringLiteral("active");
+    }
+
+    return m_lastLoadedSourceId
+            % QLatin1Char('|') % (iconTheme ? iconTheme->internalName() : QString())
+            % QLatin1Char('|') % (m_usesPlasmaTheme ? IconCache::self()->themeName() : QString())
+            % QLatin1Char('|') % QString::number(static_cast<int>(m_colorGroup))
+            % QLatin1Char('|') % QString::number(size) % QLatin1Char('@') % QString::number(dpr)
+            % QLatin1Char('|') % state
+            % QLatin1Char('|') % m_overlays.join(QLatin1Char(','));
+}
+
 void IconItem::itemChange(ItemChange change, const ItemChangeData &value)
 {
     QQuickItem::itemChange(change, value);
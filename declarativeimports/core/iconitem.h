@@ -174,12 +174,16 @@ private slots:
 
 private:
     void loadPixmap();
+    void setIconPixmap(const QPixmap &pixmap);
     void updateColors();
     void setLastLoadedSourceId(QString id);
     void setLastValidSourceName(QString name);
     void setBackgroundColor(QColor background);
     void setGlowColor(QColor glow);
 
+    //! empty when the current source can not be cached
+    QString pixmapCacheKey(const qreal size) const;
+
 private:
     bool m_active;
     bool m_providesColors{false};
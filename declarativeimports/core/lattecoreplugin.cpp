@@ -23,6 +23,8 @@
 // local
 #include "environment.h"
 #include "iconitem.h"
+#include "parabolicengine.h"
+#include "parabolicitem.h"
 #include "quickwindowsystem.h"
 #include "tools.h"
 
@@ -37,6 +39,8 @@ void LatteCorePlugin::registerTypes(const char *uri)
     Q_ASSERT(uri == QLatin1String("org.kde.latte.core"));
     qmlRegisterUncreatableType<Latte::Types>(uri, 0, 2, "Types", "Latte Types uncreatable");
     qmlRegisterType<Latte::IconItem>(uri, 0, 2, "IconItem");
+    qmlRegisterType<Latte::ParabolicEngine>(uri, 0, 2, "ParabolicEngine");
+    qmlRegisterUncreatableType<Latte::ParabolicItem>(uri, 0, 2, "ParabolicItem", "ParabolicItem is provided from ParabolicEngine");
     qmlRegisterSingletonType<Latte::Environment>(uri, 0, 2, "Environment", &Latte::environment_qobject_singletontype_provider);
     qmlRegisterSingletonType<Latte::Tools>(uri, 0, 2, "Tools", &Latte::tools_qobject_singletontype_provider);
     qmlRegisterSingletonType<Latte::QuickWindowSystem>(uri, 0, 2, "WindowSystem", &Latte::windowsystem_qobject_singletontype_provider);
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "parabolicengine.h"
+
+// Qt
+#include <QQmlEngine>
+
+namespace Latte{
+
+ParabolicEngine::ParabolicEngine(QObject *parent)
+    : QObject(parent)
+{
+}
+
+int ParabolicEngine::count() const
+{
+    return m_count;
+}
+
+void ParabolicEngine::setCount(int count)
+{
+    if (m_count == count) {
+        return;
+    }
+
+    m_count = count;
+    emit countChanged();
+}
+
+qreal ParabolicEngine::zoom() const
+{
+    return m_zoom;
+}
+
+void ParabolicEngine::setZoom(qreal zoom)
+{
+    if (qFuzzyCompare(m_zoom, zoom)) {
+        return;
+    }
+
+    m_zoom = zoom;
+    emit zoomChanged();
+}
+
+bool ParabolicEngine::reversed() const
+{
+    return m_reversed;
+}
+
+void ParabolicEngine::setReversed(bool reversed)
+{
+    if (m_reversed == reversed) {
+        return;
+    }
+
+    m_reversed = reversed;
+    emit reversedChanged();
+}
+
+QObject *ParabolicEngine::item(int index)
+{
+    if (index < 0) {
+        return nullptr;
+    }
+
+    while (m_items.count() <= index) {
+        ParabolicItem *newItem = new ParabolicItem(this);
+        QQmlEngine::setObjectOwnership(newItem, QQmlEngine::CppOwnership);
+        m_items << newItem;
+    }
+
+    return m_items[index];
+}
+
+bool ParabolicEngine::isZoomable(int index) const
+{
+    return index >= m_items.count() || m_items[index]->zoomable();
+}
+
+void ParabolicEngine::restoreItems(int from, int to, int except)
+{
+    //! items that have not been requested yet are not present in any view
+    to = qMin(to, m_items.count());
+
+    for (int i = qMax(0, from); i < to; ++i) {
+        if (i != except) {
+            m_items[i]->requestScale(1, 0);
+        }
+    }
+}
+
+QVariantMap ParabolicEngine::applyParabolicEffect(int index, qreal currentMousePosition, qreal center)
+{
+    qreal rDistance = qAbs(currentMousePosition - center);
+
+    //! check if the mouse goes right or down according to the center
+    bool positiveDirection = ((currentMousePosition - center) >= 0);
+
+    if (m_reversed) {
+        positiveDirection = !positiveDirection;
+    }
+
+    //! finding the zoom center e.g. for zoom:1.7, calculates 0.35
+    qreal zoomCenter = (m_zoom - 1) / 2;
+
+    //! computes the in the scale e.g. 0...0.35 according to the mouse distance
+    //! 0.35 on the edge and 0 in the center
+    qreal firstComputation = center > 0 ? (rDistance / center) * zoomCenter : 0;
+
+    //! calculates the scaling for the neighbour items
+    qreal bigNeighbourZoom = qMin(1 + zoomCenter + firstComputation, m_zoom);
+    qreal smallNeighbourZoom = qMax(1 + zoomCenter - firstComputation, 1.0);
+
+    qreal leftScale = positiveDirection ? smallNeighbourZoom : bigNeighbourZoom;
+    qreal rightScale = positiveDirection ? bigNeighbourZoom : smallNeighbourZoom;
+
+    updateHigherItemScale(index + 1, rightScale, 0);
+    updateLowerItemScale(index - 1, leftScale, 0);
+
+    QVariantMap scales;
+    scales["leftScale"] = leftScale;
+    scales["rightScale"] = rightScale;
+
+    return scales;
+}
+
+void ParabolicEngine::updateLowerItemScale(int delegateIndex, qreal newScale, qreal step)
+{
+    //! the first zoomable item at or lower than delegateIndex accepts the scale,
+    //! non zoomable items such as separators pass it to their lower neighbour
+    int accepted = delegateIndex < m_count ? delegateIndex : -1;
+
+    while (accepted >= 0 && !isZoomable(accepted)) {
+        --accepted;
+    }
+
+    if (accepted >= 0) {
+        if (accepted < m_items.count()) {
+            m_items[accepted]->requestScale(newScale, step);
+        }
+
+        if (newScale == 1) {
+            restoreItems(0, delegateIndex, accepted);
+        } else if (newScale > 1) {
+            restoreItems(0, accepted, -1);
+        }
+
+        if (newScale >= 1) {
+            emit sglUpdateLowerEdgeScale(1, 0);
+        }
+    } else {
+        if (newScale == 1) {
+            restoreItems(0, delegateIndex, -1);
+        }
+
+        if (delegateIndex < m_count) {
+            emit sglUpdateLowerEdgeScale(newScale, step);
+        } else if (newScale == 1) {
+            emit sglUpdateLowerEdgeScale(1, 0);
+        }
+    }
+}
+
+void ParabolicEngine::updateHigherItemScale(int delegateIndex, qreal newScale, qreal step)
+{
+    //! the first zoomable item at or higher than delegateIndex accepts the scale,
+    //! non zoomable items such as separators pass it to their higher neighbour
+    int accepted = delegateIndex >= 0 ? delegateIndex : m_count;
+
+    while (accepted < m_count && !isZoomable(accepted)) {
+        ++accepted;
+    }
+
+    if (accepted < m_count) {
+        if (accepted < m_items.count()) {
+            m_items[accepted]->requestScale(newScale, step);
+        }
+
+        if (newScale == 1) {
+            restoreItems(delegateIndex + 1, m_count, accepted);
+        } else if (newScale > 1) {
+            restoreItems(accepted + 1, m_count, -1);
+        }
+
+        if (newScale >= 1) {
+            emit sglUpdateHigherEdgeScale(1, 0);
+        }
+    } else {
+        if (newScale == 1) {
+            restoreItems(delegateIndex + 1, m_count, -1);
+        }
+
+        if (delegateIndex >= 0) {
+            emit sglUpdateHigherEdgeScale(newScale, step);
+        } else if (newScale == 1) {
+            emit sglUpdateHigherEdgeScale(1, 0);
+        }
+    }
+}
+
+}
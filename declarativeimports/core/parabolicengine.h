@@ -0,0 +1,95 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTECOREPARABOLICENGINE_H
+#define LATTECOREPARABOLICENGINE_H
+
+// local
+#include "parabolicitem.h"
+
+// Qt
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+
+namespace Latte{
+
+//! Calculates the parabolic zoom scales for a list of items in one pass.
+//! Previously each item was receiving every scale update signal and was
+//! passing it to its neighbours, so each mouse move was evaluated from
+//! all items. The engine instead notifies only the items whose scale is
+//! really affected through their ParabolicItem.
+//! When the scale update passes the first or the last item the edge signals
+//! are emitted, in order for the neighbour applets to be updated
+class ParabolicEngine final: public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count WRITE setCount NOTIFY countChanged)
+    Q_PROPERTY(qreal zoom READ zoom WRITE setZoom NOTIFY zoomChanged)
+    //! right to left layout direction for horizontal views
+    Q_PROPERTY(bool reversed READ reversed WRITE setReversed NOTIFY reversedChanged)
+
+public:
+    explicit ParabolicEngine(QObject *parent = nullptr);
+
+    int count() const;
+    void setCount(int count);
+
+    qreal zoom() const;
+    void setZoom(qreal zoom);
+
+    bool reversed() const;
+    void setReversed(bool reversed);
+
+public slots:
+    Q_INVOKABLE QObject *item(int index);
+
+    //! the mouse is hovering the item at index, returns its neighbours scales
+    //! as {leftScale, rightScale}
+    Q_INVOKABLE QVariantMap applyParabolicEffect(int index, qreal currentMousePosition, qreal center);
+
+    Q_INVOKABLE void updateLowerItemScale(int delegateIndex, qreal newScale, qreal step);
+    Q_INVOKABLE void updateHigherItemScale(int delegateIndex, qreal newScale, qreal step);
+
+signals:
+    void countChanged();
+    void reversedChanged();
+    void zoomChanged();
+
+    void sglUpdateLowerEdgeScale(qreal newScale, qreal step);
+    void sglUpdateHigherEdgeScale(qreal newScale, qreal step);
+
+private:
+    bool isZoomable(int index) const;
+    void restoreItems(int from, int to, int except);
+
+private:
+    bool m_reversed{false};
+    int m_count{0};
+    qreal m_zoom{1.0};
+
+    //! items are never released because QML bindings may still reference
+    //! them, they are created on demand
+    QVector<ParabolicItem *> m_items;
+};
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "parabolicitem.h"
+
+namespace Latte{
+
+ParabolicItem::ParabolicItem(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool ParabolicItem::zoomable() const
+{
+    return m_zoomable;
+}
+
+void ParabolicItem::setZoomable(bool zoomable)
+{
+    if (m_zoomable == zoomable) {
+        return;
+    }
+
+    m_zoomable = zoomable;
+    emit zoomableChanged();
+}
+
+qreal ParabolicItem::currentScale() const
+{
+    return m_currentScale;
+}
+
+void ParabolicItem::setCurrentScale(qreal scale)
+{
+    if (qFuzzyCompare(m_currentScale, scale)) {
+        return;
+    }
+
+    m_currentScale = scale;
+    emit currentScaleChanged();
+}
+
+void ParabolicItem::requestScale(qreal newScale, qreal step)
+{
+    //! restoring an item that is already restored is not needed
+    if (newScale == 1 && step == 0 && m_currentScale == 1) {
+        return;
+    }
+
+    emit sglUpdateScale(newScale, step);
+}
+
+}
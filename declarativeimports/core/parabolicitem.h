@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020  Michail Vourlakos <mvourlakos@gmail.com>
+ *
+ * This file is part of Latte-Dock
+ *
+ * Latte-Dock is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Latte-Dock is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATTECOREPARABOLICITEM_H
+#define LATTECOREPARABOLICITEM_H
+
+// Qt
+#include <QObject>
+
+namespace Latte{
+
+//! Parabolic state of a single item that is managed from ParabolicEngine.
+//! Items publish whether they can be zoomed and their current scale and
+//! receive scale update requests only when they are really affected
+class ParabolicItem final: public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool zoomable READ zoomable WRITE setZoomable NOTIFY zoomableChanged)
+    Q_PROPERTY(qreal currentScale READ currentScale WRITE setCurrentScale NOTIFY currentScaleChanged)
+
+public:
+    explicit ParabolicItem(QObject *parent = nullptr);
+
+    bool zoomable() const;
+    void setZoomable(bool zoomable);
+
+    qreal currentScale() const;
+    void setCurrentScale(qreal scale);
+
+    void requestScale(qreal newScale, qreal step);
+
+signals:
+    void currentScaleChanged();
+    void zoomableChanged();
+
+    void sglUpdateScale(qreal newScale, qreal step);
+
+private:
+    bool m_zoomable{true};
+    qreal m_currentScale{1.0};
+};
+
+}
+
+#endif
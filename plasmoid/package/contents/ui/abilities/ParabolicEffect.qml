@@ -22,6 +22,7 @@ import QtQuick 2.7
 import org.kde.plasma.plasmoid 2.0
 import org.kde.plasma.core 2.0 as PlasmaCore
 
+import org.kde.latte.core 0.2 as LatteCore
 import org.kde.latte.abilities.applets 0.1 as AppletAbility
 
 AppletAbility.ParabolicEffect {
@@ -31,14 +32,29 @@ AppletAbility.ParabolicEffect {
 
     readonly property bool horizontal: plasmoid.formFactor === PlasmaCore.Types.Horizontal
 
-    Component.onCompleted: {
-        parabolic.sglUpdateLowerItemScale.connect(sltTrackLowerItemScale);
-        parabolic.sglUpdateHigherItemScale.connect(sltTrackHigherItemScale);
+    //! tasks are informed only when their scale is affected instead of
+    //! passing each scale update through all tasks
+    readonly property LatteCore.ParabolicEngine engine: LatteCore.ParabolicEngine {
+        count: root.tasksCount
+        zoom: parabolic.factor.zoom
+        reversed: Qt.application.layoutDirection === Qt.RightToLeft && parabolic.horizontal
     }
 
-    Component.onDestruction: {
-        parabolic.sglUpdateLowerItemScale.disconnect(sltTrackLowerItemScale);
-        parabolic.sglUpdateHigherItemScale.disconnect(sltTrackHigherItemScale);
+    Connections {
+        target: parabolic.engine
+        onSglUpdateLowerEdgeScale: {
+            //! send update signal to host
+            if (latteBridge) {
+                latteBridge.parabolic.clientRequestUpdateLowerItemScale(newScale, step);
+            }
+        }
+
+        onSglUpdateHigherEdgeScale: {
+            //! send update signal to host
+            if (latteBridge) {
+                latteBridge.parabolic.clientRequestUpdateHigherItemScale(newScale, step);
+            }
+        }
     }
 
     Connections {
@@ -87,37 +103,14 @@ AppletAbility.ParabolicEffect {
 
     function hostRequestUpdateLowerItemScale(newScale, step){
         //! function called from host
-        sglUpdateLowerItemScale(root.tasksCount-1, newScale, step);
+        engine.updateLowerItemScale(root.tasksCount-1, newScale, step);
     }
 
     function hostRequestUpdateHigherItemScale(newScale, step){
         //! function called from host
-        sglUpdateHigherItemScale(0, newScale, step);
-    }
-
-    function sltTrackLowerItemScale(delegateIndex, newScale, step){
-        //! send update signal to host
-        if (latteBridge) {
-            if (delegateIndex === -1) {
-                latteBridge.parabolic.clientRequestUpdateLowerItemScale(newScale, step);
-            } else if (newScale === 1 && delegateIndex>=0) {
-                latteBridge.parabolic.clientRequestUpdateLowerItemScale(1, 0);
-            }
-        }
-    }
-
-    function sltTrackHigherItemScale(delegateIndex, newScale, step) {
-        //! send update signal to host
-        if (latteBridge) {
-            if (delegateIndex >= root.tasksCount) {
-                latteBridge.parabolic.clientRequestUpdateHigherItemScale(newScale, step);
-            } else if (newScale === 1 && delegateIndex<root.tasksCount) {
-                latteBridge.parabolic.clientRequestUpdateHigherItemScale(1, 0);
-            }
-        }
+        engine.updateHigherItemScale(0, newScale, step);
     }
 
-
     function applyParabolicEffect(index, currentMousePosition, center) {
         if (parabolic.local._privates.lastIndex === -1) {
             setDirectRenderingEnabled(false);
@@ -126,45 +119,8 @@ AppletAbility.ParabolicEffect {
         //! last item requested calculations
         parabolic.local._privates.lastIndex = index;
 
-        var rDistance = Math.abs(currentMousePosition  - center);
-
-        //check if the mouse goes right or down according to the center
-        var positiveDirection =  ((currentMousePosition  - center) >= 0 );
-
-        if (Qt.application.layoutDirection === Qt.RightToLeft && horizontal) {
-            positiveDirection = !positiveDirection;
-        }
-
-        //finding the zoom center e.g. for zoom:1.7, calculates 0.35
-        var zoomCenter = (factor.zoom - 1) / 2
-
-        //computes the in the scale e.g. 0...0.35 according to the mouse distance
-        //0.35 on the edge and 0 in the center
-        var firstComputation = (rDistance / center) * zoomCenter;
-
-        //calculates the scaling for the neighbour tasks
-        var bigNeighbourZoom = Math.min(1 + zoomCenter + firstComputation, factor.zoom);
-        var smallNeighbourZoom = Math.max(1 + zoomCenter - firstComputation, 1);
-
-        //bigNeighbourZoom = Number(bigNeighbourZoom.toFixed(4));
-        //smallNeighbourZoom = Number(smallNeighbourZoom.toFixed(4));
-
-        var leftScale;
-        var rightScale;
-
-        if(positiveDirection === true){
-            rightScale = bigNeighbourZoom;
-            leftScale = smallNeighbourZoom;
-        }
-        else {
-            rightScale = smallNeighbourZoom;
-            leftScale = bigNeighbourZoom;
-        }
-
-        sglUpdateHigherItemScale(index+1 , rightScale, 0);
-        sglUpdateLowerItemScale(index-1, leftScale, 0);
-
-        return {leftScale:leftScale, rightScale:rightScale};
+        //! all neighbour scales are calculated and dispatched at once
+        return engine.applyParabolicEffect(index, currentMousePosition, center);
     }
 
     function invkClearZoom() {
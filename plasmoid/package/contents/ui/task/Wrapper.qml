@@ -75,6 +75,9 @@ Item{
     property bool inTempScaling: ((tempScaleWidth !== 1) || (tempScaleHeight !== 1) )
 
     property real mScale: 1
+
+    //! parabolic engine item that informs this task only when its scale is affected
+    readonly property QtObject parabolicItem: taskItem.parabolic.engine.item(index)
     property real tempScaleWidth: 1
     property real tempScaleHeight: 1
 
@@ -190,6 +193,25 @@ Item{
         }
     } //nScale
 
+    Binding {
+        target: wrapper.parabolicItem
+        property: "zoomable"
+        when: wrapper.parabolicItem
+        value: !taskItem.isSeparator && !taskItem.isHidden
+    }
+
+    Binding {
+        target: wrapper.parabolicItem
+        property: "currentScale"
+        when: wrapper.parabolicItem
+        value: wrapper.mScale
+    }
+
+    Connections {
+        target: wrapper.parabolicItem
+        onSglUpdateScale: wrapper.updateScale(index, newScale, step);
+    }
+
     function updateScale(nIndex, nScale, step){
         if (!taskItem.containsMouse && (index === nIndex)
                 && (taskItem.hoverEnabled || inMimicParabolicAnimation)&&(tasksExtendedManager.waitingLaunchersLength()===0)){
@@ -216,41 +238,6 @@ Item{
         }
     }
 
-    function sltUpdateLowerItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === index) {
-            if (!taskItem.isSeparator && !taskItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
-
-                if (newScale > 1) { // clear lower items
-                    taskItem.parabolic.sglUpdateLowerItemScale(delegateIndex-1, 1, 0);
-                }
-            } else {
-                taskItem.parabolic.sglUpdateLowerItemScale(delegateIndex-1, newScale, step);
-            }
-        } else if ((newScale === 1) && (index < delegateIndex)) {
-            updateScale(index, 1, 0);
-        }
-    }
-
-    function sltUpdateHigherItemScale(delegateIndex, newScale, step) {
-        if (delegateIndex === index) {
-            if (!taskItem.isSeparator && !taskItem.isHidden) {
-                //! when accepted
-                updateScale(delegateIndex, newScale, step);
-
-                if (newScale > 1) { // clear lower items
-                    taskItem.parabolic.sglUpdateHigherItemScale(delegateIndex+1, 1, 0); // clear higher items
-                }
-            } else {
-                taskItem.parabolic.sglUpdateHigherItemScale(delegateIndex+1, newScale, step);
-            }
-        } else if ((newScale === 1) && (index > delegateIndex)) {
-            updateScale(index, 1, 0);
-        }
-    }
-
-
     function sendEndOfNeedBothAxisAnimation(){
         if (taskItem.isZoomed) {
             taskItem.isZoomed = false;
@@ -290,12 +277,5 @@ Item{
             opacity = 1;
         }
 
-        taskItem.parabolic.sglUpdateLowerItemScale.connect(sltUpdateLowerItemScale);
-        taskItem.parabolic.sglUpdateHigherItemScale.connect(sltUpdateHigherItemScale);
-    }
-
-    Component.onDestruction: {
-        taskItem.parabolic.sglUpdateLowerItemScale.disconnect(sltUpdateLowerItemScale);
-        taskItem.parabolic.sglUpdateHigherItemScale.disconnect(sltUpdateHigherItemScale);
     }
 }// Main task area // id:wrapper
@@ -929,6 +929,18 @@ PlasmaComponents.Page {
                     }
                 }
 
+                LatteComponents.CheckBox {
+                    Layout.maximumWidth: dialog.optionsWidth
+                    text: i18n("Shrink window when parabolic zoom is not used")
+                    checked: plasmoid.configuration.adaptiveWindowThickness
+                    tooltip: i18n("The view window keeps only the needed thickness for its contents and it is expanded\nfor parabolic zoom only when the mouse or a drag is entering the view. It saves graphics memory")
+                    enabled: !dialog.viewIsPanel
+
+                    onClicked: {
+                        plasmoid.configuration.adaptiveWindowThickness = checked;
+                    }
+                }
+
                 LatteComponents.CheckBox {
                     Layout.maximumWidth: dialog.optionsWidth
                     text: i18n("Raise on desktop change")